@@ -0,0 +1,238 @@
+// Asset memory accounting: loads the game's asset set the way main() queues it (the ship's
+// levels of detail with its outline, the skybox and ship textures and the baked stadium) through
+// the loader, headless, and reports what each file costs in RAM and VRAM against the default
+// budgets. The textures are charged as the cache would charge them once uploaded, at the 16-bit
+// size with full mip chain texconv converts them to. Fails if the set doesn't fit, so a budget
+// regression fails the host build's checks.
+//
+// Also checks the accounting itself: charges add up per category, tag and pool, a charge over a
+// pool or category budget is refused with nothing recorded, a model or track job refused by its
+// budget fails and leaves nothing loaded or charged, and unloading everything credits it all
+// back. Reports the cost of a charge and its release.
+//
+// Usage: bench-asset-memory [model.obj]
+
+#include <raylib.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bench_common.h"
+#include "../src/load/loader.h"
+#include "../src/mem/budget.h"
+#include "../src/mesh/meshbin.h"
+#include "../src/track/circuit.h"
+#include "../tools/objconv.h"
+#include "../tools/simplify.h"
+#include "../tools/trackconv.h"
+
+#define DEFAULT_MODEL "romdisk/rship.obj"
+#define MODEL_PATH "build-host/bench-asset-memory.hsm"
+#define TRACK_PATH "build-host/bench-asset-memory.hsk"
+#define SKYBOX_PATH "romdisk/gradient_skybox.png"
+#define SHIP_TEXTURE_PATH "romdisk/Finish_Line.png"
+#define CHARGE_RUNS 100000
+
+// What main() loads
+typedef struct GameSet {
+    AssetLoader loader;
+    MemArena shipArena;
+    OutlineMesh outline;
+    Track track;
+    int shipJob;
+    int textureJobs[2];
+    int trackJob;
+} GameSet;
+
+static int failures = 0;
+
+static void Check(bool ok, const char *what)
+{
+    if (ok) return;
+    printf("FAIL: %s\n", what);
+    failures++;
+}
+
+// The ship with meshconv's default levels of detail, and the stadium as trackbake bakes it
+static bool WriteAssets(const char *objPath)
+{
+    ObjData levels[3];
+    float errors[3] = { 0.0f };
+    unsigned char *data = NULL;
+    int size = 0;
+    if (!ParseObj(objPath, &levels[0])) return false;
+    SimplifyObj(&levels[0], levels[0].triangleCount * 2 / 5, &levels[1]);
+    SimplifyObj(&levels[0], levels[0].triangleCount * 3 / 20, &levels[2]);
+    for (int l = 1; l < 3; l++) errors[l] = GetSimplifyError(&levels[0], &levels[l]);
+    bool ok = BuildMeshBinLods(levels, errors, 3, &data, &size) && SaveFileData(MODEL_PATH, data, size);
+    free(data);
+    for (int l = 0; l < 3; l++) UnloadObj(&levels[l]);
+
+    Track stadium;
+    ok = ok && GenSplineTrack(&stadium, stadiumCircuit, STADIUM_CIRCUIT_POINTS, stadiumTessellation);
+    ok = ok && BuildTrackBin(&stadium, &data, &size) && SaveFileData(TRACK_PATH, data, size);
+    free(data);
+    UnloadTrack(&stadium);
+    return ok;
+}
+
+static void LoadGameSet(GameSet *set)
+{
+    AssetLoader *loader = &set->loader;
+    InitAssetLoader(loader);
+    loader->headless = true; // No GL context: decode and charge, upload nothing
+
+    set->textureJobs[0] = AddTextureJob(loader, SKYBOX_PATH);
+    set->shipJob = AddModelJob(loader, MODEL_PATH, &set->shipArena, &set->outline);
+    set->textureJobs[1] = AddTextureJob(loader, SHIP_TEXTURE_PATH);
+    set->trackJob = AddTrackJob(loader, TRACK_PATH, &set->track, set->textureJobs[1]);
+    RunAssetLoader(loader);
+
+    // Each texture as the cache charges it when it uploads the .hst texconv makes of it, keyed
+    // by job where the cache uses the texture id
+    for (int t = 0; t < 2; t++)
+    {
+        LoadJob *job = &loader->jobs[set->textureJobs[t]];
+        if (!job->ok) continue;
+
+        int mipmaps = 1;
+        for (int w = job->image.width, h = job->image.height; (w > 1) || (h > 1); w /= 2, h /= 2) mipmaps++;
+        size_t bytes = GetTextureDataSize(job->image.width, job->image.height, mipmaps, PIXELFORMAT_UNCOMPRESSED_R5G6B5);
+        job->ok = ReserveAssetMemory(ASSET_TEXTURE, (uintptr_t)(t + 1), job->fileName, bytes);
+    }
+}
+
+static void UnloadGameSet(GameSet *set)
+{
+    AssetLoader *loader = &set->loader;
+    if (loader->jobs[set->shipJob].ok)
+    {
+        UnloadModelLods(&loader->jobs[set->shipJob].lods, &set->shipArena);
+        if (loader->jobs[set->shipJob].hasOutline) UnloadOutlineMesh(&set->outline);
+    }
+    if (loader->jobs[set->trackJob].ok) UnloadTrack(&set->track);
+    for (int t = 0; t < 2; t++) ReleaseAssetMemory(ASSET_TEXTURE, (uintptr_t)(t + 1));
+    UnloadAssetLoader(loader);
+}
+
+// The accounting on its own, with made-up assets
+static void CheckAccounting(void)
+{
+    ResetAssetMemory();
+
+    Check(ReserveAssetMemory(ASSET_TEXTURE, 1, "a", 1000) && ReserveAssetMemory(ASSET_MODEL, 1, "a", 500) &&
+          ReserveAssetMemory(ASSET_TRACK, 2, "b", 300) && ReserveAssetMemory(ASSET_TEXTURE, 1, "a", 24), "charges within budget refused");
+    Check((GetAssetMemoryUsed(ASSET_MEMORY_VRAM) == 1024) && (GetAssetMemoryUsed(ASSET_MEMORY_RAM) == 800), "pool totals wrong");
+    Check((GetAssetCategoryUsed(ASSET_TEXTURE) == 1024) && (GetAssetCategoryUsed(ASSET_MODEL) == 500) && (GetAssetCategoryUsed(ASSET_TRACK) == 300),
+          "category totals wrong");
+    Check((GetAssetTagUsed("a", ASSET_MEMORY_RAM) == 500) && (GetAssetTagUsed("a", ASSET_MEMORY_VRAM) == 1024) &&
+          (GetAssetTagUsed("b", ASSET_MEMORY_RAM) == 300), "tag totals wrong");
+
+    SetAssetMemoryBudget(ASSET_MEMORY_VRAM, 2000);
+    Check(!ReserveAssetMemory(ASSET_MESH_BUFFER, 3, "c", 1000) && (GetAssetMemoryUsed(ASSET_MEMORY_VRAM) == 1024) &&
+          (GetAssetMemoryFailures() == 1), "charge over the pool budget recorded");
+    Check(ReserveAssetMemory(ASSET_MESH_BUFFER, 3, "c", 976) && (GetAssetMemoryUsed(ASSET_MEMORY_VRAM) == 2000), "charge up to the pool budget refused");
+
+    SetAssetCategoryBudget(ASSET_TRACK, 400);
+    Check(!ReserveAssetMemory(ASSET_TRACK, 4, "d", 101) && (GetAssetCategoryUsed(ASSET_TRACK) == 300) && (GetAssetMemoryFailures() == 2),
+          "charge over the category budget recorded");
+
+    ReleaseAssetMemory(ASSET_TEXTURE, 1);
+    ReleaseAssetMemory(ASSET_TEXTURE, 99);
+    Check((GetAssetMemoryUsed(ASSET_MEMORY_VRAM) == 976) && (GetAssetTagUsed("a", ASSET_MEMORY_VRAM) == 0) &&
+          (GetAssetMemoryPeak(ASSET_MEMORY_VRAM) == 2000), "release wrong");
+
+    ResetAssetMemory();
+    SetAssetMemoryBudget(ASSET_MEMORY_RAM, (size_t)-1);
+    bool filled = true;
+    for (int i = 0; i < ASSET_MEMORY_MAX_ENTRIES; i++) filled &= ReserveAssetMemory(ASSET_MODEL, (uintptr_t)(i + 1), "e", 1);
+    Check(filled && !ReserveAssetMemory(ASSET_MODEL, 1000, "e", 1) && (GetAssetMemoryUsed(ASSET_MEMORY_RAM) == ASSET_MEMORY_MAX_ENTRIES),
+          "full entry table handled wrong");
+
+    ResetAssetMemory();
+}
+
+// ns per charge and release, with 'live' other assets charged
+static double TimeCharges(int live)
+{
+    ResetAssetMemory();
+    for (int i = 0; i < live; i++) ReserveAssetMemory((AssetCategory)(i % ASSET_CATEGORY_COUNT), (uintptr_t)(i + 1), "live", 64);
+
+    uint64_t start = BenchNowNs();
+    for (int r = 0; r < CHARGE_RUNS; r++)
+    {
+        ReserveAssetMemory(ASSET_TEXTURE, 0x8000 + (r & 1), "timed", 4096);
+        ReleaseAssetMemory(ASSET_TEXTURE, 0x8000 + (r & 1));
+    }
+    double ns = (double)(BenchNowNs() - start) / CHARGE_RUNS;
+
+    ResetAssetMemory();
+    return ns;
+}
+
+static void PrintRow(const char *tag)
+{
+    printf("%-34s %10u %10u\n", tag, (unsigned)GetAssetTagUsed(tag, ASSET_MEMORY_RAM), (unsigned)GetAssetTagUsed(tag, ASSET_MEMORY_VRAM));
+}
+
+int main(int argc, char **argv)
+{
+    const char *objPath = (argc > 1)? argv[1] : DEFAULT_MODEL;
+    SetTraceLogLevel(LOG_NONE); // The refusals below are meant to happen
+
+    if (!WriteAssets(objPath))
+    {
+        printf("FAIL: couldn't convert %s or bake the stadium\n", objPath);
+        return 1;
+    }
+
+    CheckAccounting();
+
+    // The game's set against the default budgets
+    GameSet set;
+    LoadGameSet(&set);
+    for (int i = 0; i < set.loader.jobCount; i++) Check(set.loader.jobs[i].ok, "game asset didn't load or fit its budget");
+    Check(GetAssetMemoryFailures() == 0, "game asset set is over budget");
+
+    size_t shipRam = set.shipArena.capacity + set.outline.arena.capacity;
+    size_t trackRam = set.track.arena.capacity;
+    Check(GetAssetTagUsed(MODEL_PATH, ASSET_MEMORY_RAM) == shipRam, "ship charged wrong");
+    Check(GetAssetTagUsed(TRACK_PATH, ASSET_MEMORY_RAM) == trackRam, "track charged wrong");
+
+    printf("%-34s %10s %10s\n", "asset", "RAM", "VRAM");
+    PrintRow(MODEL_PATH);
+    PrintRow(TRACK_PATH);
+    PrintRow(SKYBOX_PATH);
+    PrintRow(SHIP_TEXTURE_PATH);
+    for (int p = 0; p < ASSET_MEMORY_POOL_COUNT; p++)
+    {
+        AssetMemoryPool pool = (AssetMemoryPool)p;
+        printf("%-34s %10u of %u bytes budget, %.1f%%\n", (pool == ASSET_MEMORY_RAM)? "RAM" : "VRAM", (unsigned)GetAssetMemoryUsed(pool),
+               (unsigned)GetAssetMemoryBudget(pool), 100.0 * GetAssetMemoryUsed(pool) / GetAssetMemoryBudget(pool));
+    }
+
+    UnloadGameSet(&set);
+    Check((GetAssetMemoryUsed(ASSET_MEMORY_RAM) == 0) && (GetAssetMemoryUsed(ASSET_MEMORY_VRAM) == 0), "unloading the set left charges");
+
+    // RAM for the ship but not the track: the track job fails and nothing of it stays
+    ResetAssetMemory();
+    SetAssetMemoryBudget(ASSET_MEMORY_RAM, shipRam + trackRam - 1);
+    LoadGameSet(&set);
+    Check(set.loader.jobs[set.shipJob].ok && !set.loader.jobs[set.trackJob].ok && (set.track.arena.memory == NULL), "track over budget still loaded");
+    Check((GetAssetMemoryUsed(ASSET_MEMORY_RAM) == shipRam) && (GetAssetMemoryFailures() == 1), "track refusal charged wrong");
+    UnloadGameSet(&set);
+    Check(GetAssetMemoryUsed(ASSET_MEMORY_RAM) == 0, "unloading after a refusal left charges");
+
+    // A model budget the ship doesn't fit: the ship job fails, its outline goes too
+    ResetAssetMemory();
+    SetAssetCategoryBudget(ASSET_MODEL, shipRam - 1);
+    LoadGameSet(&set);
+    Check(!set.loader.jobs[set.shipJob].ok && (set.shipArena.memory == NULL) && (set.outline.arena.memory == NULL), "ship over budget still loaded");
+    Check((GetAssetCategoryUsed(ASSET_MODEL) == 0) && (GetAssetTagUsed(TRACK_PATH, ASSET_MEMORY_RAM) == trackRam), "ship refusal charged wrong");
+    UnloadGameSet(&set);
+    Check(GetAssetMemoryUsed(ASSET_MEMORY_RAM) == 0, "unloading after a refusal left charges");
+
+    printf("charge and release: %.1f ns with 4 assets charged, %.1f ns with %d\n", TimeCharges(4), TimeCharges(ASSET_MEMORY_MAX_ENTRIES - 2),
+           ASSET_MEMORY_MAX_ENTRIES - 2);
+    printf("check: %s\n", (failures == 0)? "ok" : "FAIL");
+    return (failures == 0)? 0 : 1;
+}
@@ -0,0 +1,215 @@
+// Collision cost as the field and the track grow: the pool update (which now sweeps every ship
+// against the walls) and CollideShips() per ship per tick at 1 to 256 ships on 100 to 10000
+// segment tracks, plus one wall sweep with and without a segment hint.
+//
+// Also checks nothing tunnels: ships driven into the walls at top speed (5 units a tick) and
+// at 50 units a tick, at several angles, must stay over the ribbon, and two ships closing
+// fast enough to pass through each other within a tick must end up still apart.
+
+#include <raylib.h>
+#include <raymath.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "bench_common.h"
+#include "bench_track.h"
+#include "../src/ship/ship.h"
+#include "../src/ship/pool.h"
+#include "../src/collision/collision.h"
+
+#define TICKS 2000
+#define SWEEPS 200000
+#define DT (1.0f / 60.0f)
+
+static const int segmentCounts[] = { 100, 1000, 10000 };
+static const int shipCounts[] = { 1, 16, 64, 256 };
+
+static void RunCostCase(const BenchTrack *track, int count)
+{
+    ModelLods model = { 0 };
+    ShipPool pool;
+    InitShipPool(&pool, count, &model);
+    PlaceShipsOnGrid(&pool, track->waypoints, track->waypointCount, count);
+
+    CollisionWorld world;
+    InitCollisionWorld(&world, count);
+
+    uint64_t updateNs = 0, collideNs = 0;
+    long pairTests = 0, contacts = 0;
+    for (int t = 0; t < TICKS; t++)
+    {
+        uint64_t t0 = BenchNowNs();
+        UpdateShips(&pool, track->waypoints, track->waypointCount, &track->surface, DT);
+        uint64_t t1 = BenchNowNs();
+        contacts += CollideShips(&world, NULL, 0, &pool, &track->surface);
+        uint64_t t2 = BenchNowNs();
+
+        updateNs += t1 - t0;
+        collideNs += t2 - t1;
+        pairTests += world.pairTests;
+    }
+
+    double perShip = (double)TICKS * count;
+    printf("  %5d segments %4d ships: update %6.1f ns/ship, collide %6.1f ns/ship, %7.1f pair tests/tick, %6.2f contacts/tick\n",
+           track->surface.segmentCount, count, updateNs / perShip, collideNs / perShip, (double)pairTests / TICKS,
+           (double)contacts / TICKS);
+
+    UnloadCollisionWorld(&world);
+    UnloadShipPool(&pool);
+}
+
+// One short move across the track from its centreline, timed with and without a hint
+static void RunSweepCase(const BenchTrack *track)
+{
+    int n = track->surface.segmentCount;
+    double ns[2];
+    for (int pass = 0; pass < 2; pass++)
+    {
+        uint64_t t0 = BenchNowNs();
+        for (int k = 0; k < SWEEPS; k++)
+        {
+            const TrackFrame *frame = &track->ribbon.frames[k % n];
+            Vector3 to = Vector3Add(frame->position, Vector3Scale(frame->forward, 5.0f));
+            WallSweep sweep = SweepAgainstWalls(&track->surface, frame->position, to, SHIP_COLLISION_RADIUS, (pass == 0)? k % n : -1);
+            benchSink += sweep.position.x;
+        }
+        ns[pass] = (double)(BenchNowNs() - t0) / SWEEPS;
+    }
+    printf("  %5d segments: wall sweep %5.1f ns with a hint, %6.1f ns from the grid\n", n, ns[0], ns[1]);
+}
+
+// Drive at the outer or inner wall, 'angle' degrees off head on, for 'steps' moves of 'step'
+// units. Returns the moves that ended off the ribbon.
+static int DriveIntoWall(const BenchTrack *track, int segment, float side, float angle, float step, int steps, bool hinted)
+{
+    const TrackFrame *frame = &track->ribbon.frames[segment];
+    Vector3 across = Vector3Scale(frame->side, side);
+    Vector3 direction = Vector3Add(Vector3Scale(across, cosf(angle * DEG2RAD)), Vector3Scale(frame->forward, sinf(angle * DEG2RAD)));
+    direction.y = 0.0f;
+    direction = Vector3Normalize(direction);
+
+    Vector3 position = Vector3Add(frame->position, (Vector3){ 0.0f, SHIP_HOVER_HEIGHT, 0.0f });
+    int hint = segment, misses = 0;
+    for (int k = 0; k < steps; k++)
+    {
+        Vector3 to = Vector3Add(position, Vector3Scale(direction, step));
+        position = SweepAgainstWalls(&track->surface, position, to, SHIP_COLLISION_RADIUS, hinted? hint : -1).position;
+
+        TrackSurfaceHit hit = QueryTrackSurface(&track->surface, position, hint);
+        if (!hit.hit) misses++;
+        else
+        {
+            hint = hit.segment;
+            position.y = hit.height + SHIP_HOVER_HEIGHT;
+        }
+    }
+    return misses;
+}
+
+// The player's ship flat out at a wall through UpdateShip(), as the game drives it
+static int DriveShipIntoWall(const BenchTrack *track, int segment, float side)
+{
+    const TrackFrame *frame = &track->ribbon.frames[segment];
+    Ship ship;
+    InitShip(&ship, (ModelLods){ 0 }, (Texture2D){ 0 });
+    ship.position = Vector3Add(frame->position, (Vector3){ 0.0f, SHIP_HOVER_HEIGHT, 0.0f });
+    ship.yaw = atan2f(frame->side.x * side, frame->side.z * side) * RAD2DEG;
+    ship.speed = 5.0f;
+
+    int misses = 0;
+    ShipInput input = { 0.0f, true, false };
+    for (int t = 0; t < 300; t++)
+    {
+        UpdateShip(&ship, input, &track->surface, DT);
+        if (!QueryTrackSurface(&track->surface, ship.position, ship.segment).hit) misses++;
+    }
+    return misses;
+}
+
+// Two ships closing at 'speed' each per tick that would overlap at the end of it; from 25 up
+// they would have swapped sides
+static bool CheckHeadOn(const BenchTrack *track, float speed)
+{
+    const TrackFrame *frame = &track->ribbon.frames[0];
+    Vector3 forward = Vector3Normalize((Vector3){ frame->forward.x, 0.0f, frame->forward.z });
+    float yaw = atan2f(forward.x, forward.z) * RAD2DEG;
+
+    Ship a, b;
+    InitShip(&a, (ModelLods){ 0 }, (Texture2D){ 0 });
+    InitShip(&b, (ModelLods){ 0 }, (Texture2D){ 0 });
+    float start = 0.6f * speed + 4.0f;
+    a.previous.position = Vector3Subtract(frame->position, Vector3Scale(forward, start));
+    b.previous.position = Vector3Add(frame->position, Vector3Scale(forward, start));
+    a.position = Vector3Add(a.previous.position, Vector3Scale(forward, speed));
+    b.position = Vector3Subtract(b.previous.position, Vector3Scale(forward, speed));
+    a.yaw = yaw;
+    b.yaw = yaw + 180.0f;
+    a.speed = b.speed = speed;
+    a.segment = b.segment = 0;
+
+    ModelLods model = { 0 };
+    ShipPool pool;
+    InitShipPool(&pool, 1, &model);
+    CollisionWorld world;
+    InitCollisionWorld(&world, 2);
+
+    Ship *ships[] = { &a, &b };
+    int contacts = CollideShips(&world, ships, 2, &pool, &track->surface);
+
+    Vector3 gap = Vector3Subtract(b.position, a.position);
+    float separation = Vector3DotProduct(gap, forward);
+    bool ok = (contacts == 1) && (separation >= 2.0f * SHIP_COLLISION_RADIUS - 0.01f) && (a.speed < speed) && (b.speed < speed);
+    printf("  head on at %4.1f/tick: %d contact, %.2f apart after, speeds %.2f %.2f  %s\n", speed, contacts, separation,
+           a.speed, b.speed, ok? "ok" : "FAIL");
+
+    UnloadCollisionWorld(&world);
+    UnloadShipPool(&pool);
+    return ok;
+}
+
+int main(void)
+{
+    bool ok = true;
+    SetTraceLogLevel(LOG_WARNING);
+
+    for (int s = 0; s < (int)(sizeof(segmentCounts) / sizeof(segmentCounts[0])); s++)
+    {
+        BenchTrack track = LoadBenchTrack(segmentCounts[s]);
+
+        printf("cost:\n");
+        for (int c = 0; c < (int)(sizeof(shipCounts) / sizeof(shipCounts[0])); c++) RunCostCase(&track, shipCounts[c]);
+        RunSweepCase(&track);
+
+        // Both walls, head on to a glancing 80 degrees, at top speed and ten times it
+        static const float angles[] = { 0.0f, 30.0f, 60.0f, 80.0f };
+        static const float steps[] = { 5.0f, 50.0f };
+        int misses = 0, runs = 0;
+        for (int segment = 0; segment < track.surface.segmentCount; segment += track.surface.segmentCount / 10)
+        {
+            for (int side = -1; side <= 1; side += 2)
+            {
+                for (int a = 0; a < 4; a++)
+                {
+                    for (int k = 0; k < 2; k++)
+                    {
+                        misses += DriveIntoWall(&track, segment, (float)side, angles[a], steps[k], 40, true);
+                        misses += DriveIntoWall(&track, segment, (float)side, angles[a], steps[k], 40, false);
+                        runs += 2;
+                    }
+                }
+                misses += DriveShipIntoWall(&track, segment, (float)side);
+                runs++;
+            }
+        }
+        printf("tunneling:    %d wall runs, %d moves off the ribbon  %s\n", runs, misses, (misses == 0)? "ok" : "FAIL");
+        ok &= (misses == 0);
+
+        ok &= CheckHeadOn(&track, 5.0f);
+        ok &= CheckHeadOn(&track, 25.0f);
+
+        UnloadBenchTrack(&track);
+    }
+
+    printf("check:        %s\n", ok? "ok" : "FAIL");
+    return ok? 0 : 1;
+}
@@ -0,0 +1,19 @@
+#ifndef BENCH_COMMON_H
+#define BENCH_COMMON_H
+
+// Shared helpers for the host-side benchmarks (native build only)
+
+#include <time.h>
+#include <stdint.h>
+
+static inline uint64_t BenchNowNs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+// Keeps the optimizer from discarding results that are only timed, never used
+static volatile float benchSink;
+
+#endif // BENCH_COMMON_H
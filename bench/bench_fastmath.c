@@ -0,0 +1,288 @@
+// Accuracy and throughput of the fast math kernels (src/math/fastmath.h) against raymath and
+// libm: sine/cosine, quaternion from and to a basis, approximate slerp, the ship's surface
+// rotation and its model transform. Fails if any kernel's worst error is over its bound.
+
+#include <raylib.h>
+#include <raymath.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "bench_common.h"
+#include "../src/math/fastmath.h"
+#include "../src/ship/ship.h"
+
+#define SAMPLES 1000000
+#define BATCH 1024
+#define REPEATS 2000
+
+// Bounds the checks hold the kernels to
+#define SINCOS_MAX_ERROR 1e-6f          // Absolute, for angles within 50 turns
+#define BASIS_MAX_ERROR 1e-5f           // Per quaternion or matrix component
+#define SLERP_MAX_ERROR_DEG 0.05f       // Rotation between the fast and an exact slerp, any pair
+#define STEP_MAX_ERROR_DEG 0.002f       // Same, for the ships' small smoothing steps
+#define SURFACE_MAX_ERROR_DEG 0.001f    // Rotation between the old and new GetSurfaceRotation()
+
+static uint32_t rngState = 12345u;
+
+static float RandomFloat(float min, float max)
+{
+    rngState = rngState * 1664525u + 1013904223u;
+    return min + (max - min) * (float)(rngState >> 8) / 16777216.0f;
+}
+
+static Quaternion RandomRotation(void)
+{
+    Vector3 axis = { RandomFloat(-1.0f, 1.0f), RandomFloat(-1.0f, 1.0f), RandomFloat(-1.0f, 1.0f) };
+    if (Vector3Length(axis) < 0.01f) axis = (Vector3){ 0.0f, 1.0f, 0.0f };
+    return QuaternionFromAxisAngle(axis, RandomFloat(-PI, PI));
+}
+
+// Angle in degrees of the rotation between two unit quaternions. From the chord between them
+// (4 asin(|a - b| / 2)) rather than acos of their dot product, which float rounding swamps
+// for angles this small.
+static float GetRotationError(Quaternion a, Quaternion b)
+{
+    double dot = (double)a.x * b.x + (double)a.y * b.y + (double)a.z * b.z + (double)a.w * b.w;
+    double sign = (dot < 0.0)? -1.0 : 1.0;
+    double dx = a.x - sign * b.x, dy = a.y - sign * b.y, dz = a.z - sign * b.z, dw = a.w - sign * b.w;
+    double chord = sqrt(dx * dx + dy * dy + dz * dz + dw * dw);
+    return (float)(4.0 * asin(fmin(chord * 0.5, 1.0)) * RAD2DEG);
+}
+
+// Slerp in double precision, the reference for both the fast one and raymath's
+static Quaternion ExactSlerp(Quaternion q1, Quaternion q2, float amount)
+{
+    double a[4] = { q1.x, q1.y, q1.z, q1.w }, b[4] = { q2.x, q2.y, q2.z, q2.w };
+    double d = a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3];
+    if (d < 0.0) { for (int k = 0; k < 4; k++) b[k] = -b[k]; d = -d; }
+
+    double wa = 1.0 - amount, wb = amount;
+    if (d < 1.0 - 1e-12)
+    {
+        double theta = acos(d);
+        wa = sin((1.0 - amount) * theta) / sin(theta);
+        wb = sin(amount * theta) / sin(theta);
+    }
+    double r[4];
+    for (int k = 0; k < 4; k++) r[k] = wa * a[k] + wb * b[k];
+    double l = sqrt(r[0] * r[0] + r[1] * r[1] + r[2] * r[2] + r[3] * r[3]);
+    return (Quaternion){ (float)(r[0] / l), (float)(r[1] / l), (float)(r[2] / l), (float)(r[3] / l) };
+}
+
+// GetSurfaceRotation() as it was: two sinf/cosf pairs and a Matrix for QuaternionFromMatrix()
+static Quaternion GetSurfaceRotationRaymath(float yaw, Vector3 surfaceNormal)
+{
+    Vector3 forward = { sinf(yaw * DEG2RAD), 0.0f, cosf(yaw * DEG2RAD) };
+    Vector3 initialForward = Vector3Normalize((Vector3){ sinf(yaw * DEG2RAD), 0.0f, cosf(yaw * DEG2RAD) });
+    Vector3 right = Vector3Normalize(Vector3CrossProduct(surfaceNormal, initialForward));
+    forward = Vector3Normalize(Vector3CrossProduct(right, surfaceNormal));
+
+    Matrix m = MatrixIdentity();
+    m.m0 = right.x; m.m4 = surfaceNormal.x; m.m8 = forward.x;
+    m.m1 = right.y; m.m5 = surfaceNormal.y; m.m9 = forward.y;
+    m.m2 = right.z; m.m6 = surfaceNormal.z; m.m10 = forward.z;
+    return QuaternionFromMatrix(m);
+}
+
+// The transform DrawShipModel() used to build on the rlgl stack: translate, rotate, turn the model
+static Matrix GetShipTransformRaymath(ShipPose pose)
+{
+    Matrix rotation = MatrixMultiply(MatrixRotateY(90.0f * DEG2RAD), QuaternionToMatrix(pose.rotation));
+    return MatrixMultiply(rotation, MatrixTranslate(pose.position.x, pose.position.y, pose.position.z));
+}
+
+static float GetMatrixError(Matrix a, Matrix b)
+{
+    float16 fa = MatrixToFloatV(a), fb = MatrixToFloatV(b);
+    float error = 0.0f;
+    for (int k = 0; k < 16; k++) error = fmaxf(error, fabsf(fa.v[k] - fb.v[k]));
+    return error;
+}
+
+// Worst component difference, allowing for q and -q being the same rotation
+static float GetQuaternionError(Quaternion a, Quaternion b)
+{
+    float same = fmaxf(fmaxf(fabsf(a.x - b.x), fabsf(a.y - b.y)), fmaxf(fabsf(a.z - b.z), fabsf(a.w - b.w)));
+    float flipped = fmaxf(fmaxf(fabsf(a.x + b.x), fabsf(a.y + b.y)), fmaxf(fabsf(a.z + b.z), fabsf(a.w + b.w)));
+    return fminf(same, flipped);
+}
+
+static Vector3 RandomSurfaceNormal(void)
+{
+    return Vector3Normalize((Vector3){ RandomFloat(-0.5f, 0.5f), 1.0f, RandomFloat(-0.5f, 0.5f) });
+}
+
+int main(void)
+{
+    bool ok = true;
+
+    //--------------------------------------------------------------------------------------
+    // Accuracy
+    //--------------------------------------------------------------------------------------
+    printf("accuracy                         worst error      bound\n");
+
+    float sinCosError = 0.0f;
+    for (int k = 0; k < SAMPLES; k++)
+    {
+        float angle = RandomFloat(-100.0f * PI, 100.0f * PI);
+        float s, c;
+        FastSinCos(angle, &s, &c);
+        sinCosError = fmaxf(sinCosError, fmaxf(fabsf(s - sinf(angle)), fabsf(c - cosf(angle))));
+    }
+    ok &= (sinCosError <= SINCOS_MAX_ERROR);
+    printf("FastSinCos vs sinf/cosf          %.2e         %.0e\n", sinCosError, SINCOS_MAX_ERROR);
+
+    float fromBasisError = 0.0f, toBasisError = 0.0f;
+    for (int k = 0; k < SAMPLES / 10; k++)
+    {
+        Quaternion q = RandomRotation();
+        Matrix m = QuaternionToMatrix(q);
+        Vector3 right, up, forward;
+        QuaternionToBasis(q, &right, &up, &forward);
+
+        Quaternion fromBasis = QuaternionFromBasis((Vector3){ m.m0, m.m1, m.m2 }, (Vector3){ m.m4, m.m5, m.m6 }, (Vector3){ m.m8, m.m9, m.m10 });
+        fromBasisError = fmaxf(fromBasisError, GetQuaternionError(fromBasis, QuaternionFromMatrix(m)));
+
+        float basisError = fmaxf(fmaxf(fabsf(right.x - m.m0), fabsf(right.y - m.m1)), fabsf(right.z - m.m2));
+        basisError = fmaxf(basisError, fmaxf(fmaxf(fabsf(up.x - m.m4), fabsf(up.y - m.m5)), fabsf(up.z - m.m6)));
+        basisError = fmaxf(basisError, fmaxf(fmaxf(fabsf(forward.x - m.m8), fabsf(forward.y - m.m9)), fabsf(forward.z - m.m10)));
+        toBasisError = fmaxf(toBasisError, basisError);
+    }
+    ok &= (fromBasisError <= BASIS_MAX_ERROR) && (toBasisError <= BASIS_MAX_ERROR);
+    printf("QuaternionFromBasis vs raymath   %.2e         %.0e\n", fromBasisError, BASIS_MAX_ERROR);
+    printf("QuaternionToBasis vs raymath     %.2e         %.0e\n", toBasisError, BASIS_MAX_ERROR);
+
+    float fastSlerpError = 0.0f, raymathSlerpError = 0.0f, smallSlerpError = 0.0f;
+    for (int k = 0; k < SAMPLES / 10; k++)
+    {
+        Quaternion a = RandomRotation(), b = RandomRotation();
+        float amount = RandomFloat(0.0f, 1.0f);
+        Quaternion exact = ExactSlerp(a, b, amount);
+        fastSlerpError = fmaxf(fastSlerpError, GetRotationError(QuaternionSlerpFast(a, b, amount), exact));
+        raymathSlerpError = fmaxf(raymathSlerpError, GetRotationError(QuaternionNormalize(QuaternionSlerp(a, b, amount)), exact));
+
+        // The smoothing the ships use: a small step towards a nearby target
+        Quaternion near = QuaternionMultiply(a, QuaternionFromAxisAngle((Vector3){ 0.3f, 1.0f, 0.1f }, RandomFloat(-0.3f, 0.3f)));
+        smallSlerpError = fmaxf(smallSlerpError, GetRotationError(QuaternionSlerpFast(a, near, 0.1f), ExactSlerp(a, near, 0.1f)));
+    }
+    ok &= (fastSlerpError <= SLERP_MAX_ERROR_DEG) && (smallSlerpError <= STEP_MAX_ERROR_DEG);
+    printf("QuaternionSlerpFast vs exact     %.2e deg     %.0e deg\n", fastSlerpError, SLERP_MAX_ERROR_DEG);
+    printf("  ship smoothing steps           %.2e deg     %.0e deg\n", smallSlerpError, STEP_MAX_ERROR_DEG);
+    printf("  (raymath QuaternionSlerp       %.2e deg)\n", raymathSlerpError);
+
+    float surfaceError = 0.0f, transformError = 0.0f;
+    for (int k = 0; k < SAMPLES / 10; k++)
+    {
+        float yaw = RandomFloat(-3600.0f, 3600.0f);
+        Vector3 normal = RandomSurfaceNormal();
+        surfaceError = fmaxf(surfaceError, GetRotationError(GetSurfaceRotation(yaw, normal), GetSurfaceRotationRaymath(yaw, normal)));
+
+        ShipPose pose = { { RandomFloat(-1000.0f, 1000.0f), RandomFloat(-50.0f, 50.0f), RandomFloat(-1000.0f, 1000.0f) }, RandomRotation(), yaw };
+        float scale = fmaxf(1.0f, fmaxf(fabsf(pose.position.x), fabsf(pose.position.z)));
+        transformError = fmaxf(transformError, GetMatrixError(GetShipTransform(pose), GetShipTransformRaymath(pose)) / scale);
+    }
+    ok &= (surfaceError <= SURFACE_MAX_ERROR_DEG) && (transformError <= BASIS_MAX_ERROR);
+    printf("GetSurfaceRotation vs raymath    %.2e deg     %.0e deg\n", surfaceError, SURFACE_MAX_ERROR_DEG);
+    printf("GetShipTransform vs raymath      %.2e         %.0e (relative)\n", transformError, BASIS_MAX_ERROR);
+
+    //--------------------------------------------------------------------------------------
+    // Throughput, ns per call over a batch the size of a big field
+    //--------------------------------------------------------------------------------------
+    float *angles = (float *)malloc(BATCH * sizeof(float));
+    float *sines = (float *)malloc(BATCH * sizeof(float));
+    float *cosines = (float *)malloc(BATCH * sizeof(float));
+    Vector3 *normals = (Vector3 *)malloc(BATCH * sizeof(Vector3));
+    Quaternion *rotations = (Quaternion *)malloc(BATCH * sizeof(Quaternion));
+    Quaternion *targets = (Quaternion *)malloc(BATCH * sizeof(Quaternion));
+    for (int i = 0; i < BATCH; i++)
+    {
+        angles[i] = RandomFloat(-720.0f, 720.0f);
+        normals[i] = RandomSurfaceNormal();
+        rotations[i] = RandomRotation();
+        targets[i] = QuaternionMultiply(rotations[i], QuaternionFromAxisAngle((Vector3){ 0.0f, 1.0f, 0.0f }, RandomFloat(-0.5f, 0.5f)));
+    }
+    double calls = (double)BATCH * REPEATS;
+    float sink = 0.0f;
+
+    printf("\nthroughput (ns/call)             raymath/libm    fast    batched\n");
+
+    uint64_t t0 = BenchNowNs();
+    for (int r = 0; r < REPEATS; r++)
+        for (int i = 0; i < BATCH; i++) { sines[i] = sinf(angles[i] * DEG2RAD); cosines[i] = cosf(angles[i] * DEG2RAD); }
+    double libmNs = (BenchNowNs() - t0) / calls;
+    sink += sines[7] + cosines[9];
+
+    t0 = BenchNowNs();
+    for (int r = 0; r < REPEATS; r++)
+        for (int i = 0; i < BATCH; i++) FastSinCos(angles[i] * DEG2RAD, &sines[i], &cosines[i]);
+    double fastNs = (BenchNowNs() - t0) / calls;
+    sink += sines[7] + cosines[9];
+
+    t0 = BenchNowNs();
+    for (int r = 0; r < REPEATS; r++) FastSinCosArray(angles, DEG2RAD, sines, cosines, BATCH);
+    double batchNs = (BenchNowNs() - t0) / calls;
+    sink += sines[7] + cosines[9];
+    printf("sin + cos                        %8.2f     %6.2f     %6.2f\n", libmNs, fastNs, batchNs);
+
+    t0 = BenchNowNs();
+    for (int r = 0; r < REPEATS; r++)
+        for (int i = 0; i < BATCH; i++) targets[i] = QuaternionSlerp(rotations[i], targets[i], 0.1f);
+    libmNs = (BenchNowNs() - t0) / calls;
+    sink += targets[3].x;
+
+    t0 = BenchNowNs();
+    for (int r = 0; r < REPEATS; r++)
+        for (int i = 0; i < BATCH; i++) targets[i] = QuaternionSlerpFast(rotations[i], targets[i], 0.1f);
+    fastNs = (BenchNowNs() - t0) / calls;
+    sink += targets[3].x;
+
+    t0 = BenchNowNs();
+    for (int r = 0; r < REPEATS; r++) QuaternionSlerpFastArray(targets, rotations, 0.1f, BATCH);
+    batchNs = (BenchNowNs() - t0) / calls;
+    sink += targets[3].x;
+    printf("slerp                            %8.2f     %6.2f     %6.2f\n", libmNs, fastNs, batchNs);
+
+    t0 = BenchNowNs();
+    for (int r = 0; r < REPEATS; r++)
+        for (int i = 0; i < BATCH; i++) targets[i] = GetSurfaceRotationRaymath(angles[i], normals[i]);
+    libmNs = (BenchNowNs() - t0) / calls;
+    sink += targets[5].y;
+
+    t0 = BenchNowNs();
+    for (int r = 0; r < REPEATS; r++)
+        for (int i = 0; i < BATCH; i++) targets[i] = GetSurfaceRotation(angles[i], normals[i]);
+    fastNs = (BenchNowNs() - t0) / calls;
+    sink += targets[5].y;
+    printf("surface rotation                 %8.2f     %6.2f\n", libmNs, fastNs);
+
+    Matrix transform = { 0 };
+    t0 = BenchNowNs();
+    for (int r = 0; r < REPEATS; r++)
+        for (int i = 0; i < BATCH; i++)
+        {
+            transform = GetShipTransformRaymath((ShipPose){ normals[i], rotations[i], 0.0f });
+            sink += transform.m12;
+        }
+    libmNs = (BenchNowNs() - t0) / calls;
+
+    t0 = BenchNowNs();
+    for (int r = 0; r < REPEATS; r++)
+        for (int i = 0; i < BATCH; i++)
+        {
+            transform = GetShipTransform((ShipPose){ normals[i], rotations[i], 0.0f });
+            sink += transform.m12;
+        }
+    fastNs = (BenchNowNs() - t0) / calls;
+    printf("ship transform                   %8.2f     %6.2f\n", libmNs, fastNs);
+
+    benchSink = sink;
+    free(angles);
+    free(sines);
+    free(cosines);
+    free(normals);
+    free(rotations);
+    free(targets);
+
+    printf("\ncheck:        %s\n", ok? "ok" : "FAIL");
+    return ok? 0 : 1;
+}
@@ -0,0 +1,161 @@
+// Host simulation of the frame-time governor. Feeds UpdateGovernor() synthetic frame costs that
+// depend on the quality it picks (draw distance, level of detail bias, grid and effects, with
+// main()'s bounds) under a series of loads: light, heavy, stepping up and down, noisy with
+// hitches, more than even the worst level fits, and a GPU-bound case where only the missed
+// vsyncs show. Reports the level each phase settles on, changes and frames over budget.
+//
+// Checks that every phase settles within its first GOVERNOR_SETTLE seconds and then holds: no
+// more than one change for the rest of the phase, a level whose expected cost fits the budget
+// (or the worst level, when none does) and no more than one level below the best that fits.
+//
+// Usage: bench-governor
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "bench_common.h"
+#include "../src/perf/governor.h"
+
+#define TARGET_FPS 60.0f
+#define PHASE_FRAMES (20 * 60)          // 20 seconds per load
+#define SETTLE_FRAMES (8 * 60)          // Time a phase gets to settle
+#define HITCH_INTERVAL 150
+#define HITCH_MS 40.0f
+#define GPU_MISSED_LEVEL 4              // GPU-bound case: better levels than this miss every other vsync
+
+// main()'s bounds
+static const QualitySettings bestQuality = { 1000.0f, 1.0f, 1.0f, true };
+static const QualitySettings worstQuality = { 300.0f, 4.0f, 0.0f, false };
+
+typedef enum {
+    LOAD_STEADY = 0,
+    LOAD_NOISY,             // +-30% per frame and a hitch every HITCH_INTERVAL frames
+    LOAD_GPU_BOUND          // Light CPU work, but the frame misses a vsync above a level
+} LoadKind;
+
+typedef struct Scenario {
+    const char *name;
+    LoadKind kind;
+    int phaseCount;
+    float factors[4];       // Scene load per phase, scales the draw cost
+} Scenario;
+
+static unsigned int seed = 12345u;
+
+static float Random(void)
+{
+    seed = seed * 1664525u + 1013904223u;
+    return (float)(seed >> 8) / 16777216.0f;
+}
+
+// Milliseconds of update and draw a frame takes at these settings
+static void GetFrameCost(QualitySettings quality, float factor, float *update, float *draw)
+{
+    *update = 3.0f;
+    *draw = factor * (4.0f + 8.0f * quality.drawDistance / 1000.0f + 3.0f / quality.lodBias + (quality.drawGrid? 1.5f : 0.0f) +
+                      2.0f * quality.effectDensity);
+}
+
+static float GetExpectedLoad(const FrameGovernor *governor, int level, float factor)
+{
+    float update, draw;
+    GetFrameCost(GetGovernorQuality(governor, level), factor, &update, &draw);
+    return update + draw;
+}
+
+// Best level a steady load of 'factor' fits the budget at
+static int GetBestFittingLevel(const FrameGovernor *governor, float factor)
+{
+    for (int level = 0; level < GOVERNOR_LEVELS; level++)
+    {
+        if (GetExpectedLoad(governor, level, factor) <= governor->budget * GOVERNOR_DROP_LOAD) return level;
+    }
+    return GOVERNOR_LEVELS - 1;
+}
+
+static bool RunScenario(const Scenario *scenario)
+{
+    FrameGovernor governor;
+    InitGovernor(&governor, TARGET_FPS, bestQuality, worstQuality);
+
+    bool ok = true;
+    int frame = 0;
+    uint64_t ns = 0;
+
+    for (int p = 0; p < scenario->phaseCount; p++)
+    {
+        float factor = scenario->factors[p];
+        int settledChanges = 0, settledLevel = -1, overBudget = 0;
+        double settledLoad = 0.0;
+
+        for (int f = 0; f < PHASE_FRAMES; f++, frame++)
+        {
+            float update, draw, frameTime = 0.0f;
+            GetFrameCost(governor.quality, factor, &update, &draw);
+
+            if (scenario->kind == LOAD_NOISY)
+            {
+                draw *= 0.7f + 0.6f * Random();
+                if (frame % HITCH_INTERVAL == HITCH_INTERVAL - 1) update += HITCH_MS;
+            }
+            if (scenario->kind == LOAD_GPU_BOUND) frameTime = (governor.level < GPU_MISSED_LEVEL)? 2000.0f / TARGET_FPS : 1000.0f / TARGET_FPS;
+
+            uint64_t t0 = BenchNowNs();
+            bool changed = UpdateGovernor(&governor, update, draw, frameTime);
+            ns += BenchNowNs() - t0;
+
+            if (f < SETTLE_FRAMES) continue;
+            if (changed) settledChanges++;
+            if (settledLevel < 0) settledLevel = governor.level;
+            settledLoad += (frameTime > update + draw)? frameTime : update + draw;
+            if (fmaxf(update + draw, frameTime) > governor.budget) overBudget++;
+        }
+
+        // Where it should be: the best level that fits, or one below; in the GPU-bound case the
+        // best level that doesn't miss vsyncs
+        int fitting = (scenario->kind == LOAD_GPU_BOUND)? GPU_MISSED_LEVEL : GetBestFittingLevel(&governor, factor);
+        bool fits = (fitting == GOVERNOR_LEVELS - 1) || (GetExpectedLoad(&governor, governor.level, factor) <= governor.budget * GOVERNOR_DROP_LOAD);
+        if (scenario->kind == LOAD_GPU_BOUND) fits = (governor.level >= GPU_MISSED_LEVEL);
+        bool phaseOk = (settledChanges <= 1) && fits && (governor.level <= fitting + 1) && (settledLevel >= 0);
+        ok &= phaseOk;
+
+        int settledFrames = PHASE_FRAMES - SETTLE_FRAMES;
+        printf("%-10s x%-5.2f %5d %7d %9d %8.2f %11.1f%%  %s\n", (p == 0)? scenario->name : "", factor, governor.level, fitting,
+               settledChanges, settledLoad / settledFrames, 100.0 * overBudget / settledFrames, phaseOk? "ok" : "FAIL");
+    }
+
+    if (scenario->kind != LOAD_NOISY)
+    {
+        // The worst level must be exactly the configured bounds
+        QualitySettings worst = GetGovernorQuality(&governor, GOVERNOR_LEVELS - 1);
+        ok &= (worst.drawDistance == worstQuality.drawDistance) && (worst.lodBias == worstQuality.lodBias) &&
+              (worst.effectDensity == worstQuality.effectDensity) && (worst.drawGrid == worstQuality.drawGrid);
+    }
+
+    printf("%-10s %d changes, %.0f ns per frame\n", "", governor.changes, (double)ns / frame);
+    return ok;
+}
+
+int main(int argc, char **argv)
+{
+    static const Scenario scenarios[] = {
+        { "light", LOAD_STEADY, 1, { 0.6f } },
+        { "heavy", LOAD_STEADY, 1, { 1.0f } },
+        { "steps", LOAD_STEADY, 4, { 1.0f, 1.35f, 0.6f, 1.0f } },
+        { "noisy", LOAD_NOISY, 2, { 1.0f, 0.8f } },
+        { "overload", LOAD_STEADY, 1, { 2.2f } },
+        { "gpu", LOAD_GPU_BOUND, 1, { 0.3f } },
+    };
+
+    FrameGovernor governor;
+    InitGovernor(&governor, TARGET_FPS, bestQuality, worstQuality);
+    printf("%.2f ms budget, %d levels, %d frame window; expected load at best %.1f ms, worst %.1f ms (x1)\n", governor.budget, GOVERNOR_LEVELS,
+           GOVERNOR_WINDOW, GetExpectedLoad(&governor, 0, 1.0f), GetExpectedLoad(&governor, GOVERNOR_LEVELS - 1, 1.0f));
+    printf("%-10s %-6s %5s %7s %9s %8s %12s\n", "scenario", "load", "level", "fitting", "changes", "load ms", "over budget");
+
+    bool ok = true;
+    for (int i = 0; i < (int)(sizeof(scenarios) / sizeof(scenarios[0])); i++) ok &= RunScenario(&scenarios[i]);
+
+    printf("check: %s\n", ok? "ok" : "FAIL");
+    return ok? 0 : 1;
+}
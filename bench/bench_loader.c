@@ -0,0 +1,292 @@
+// Loads the game's asset set (the ship model's levels of detail with its outline, two textures and two spline
+// tracks) sequentially and through the loader thread, and checks that every byte the threaded
+// load produces matches the sequential one. Reports time to first frame and total load time
+// for both, with the render thread "drawing" 60 Hz frames while it waits.
+//
+// Usage: bench-loader [model.obj] [runs]
+
+#include <raylib.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "bench_common.h"
+#include "../src/load/loader.h"
+#include "../src/mesh/meshbin.h"
+#include "../src/texture/texbin_format.h"
+#include "../src/track/circuit.h"
+#include "../tools/objconv.h"
+#include "../tools/simplify.h"
+
+#define DEFAULT_MODEL "romdisk/rship.obj"
+#define MODEL_PATH "build-host/bench-loader.hsm"
+#define SMALL_TEXTURE_PATH "build-host/bench-loader-256.hst"
+#define LARGE_TEXTURE_PATH "build-host/bench-loader-1024.hst"
+#define DEFAULT_RUNS 20
+#define FRAME_NS 16666667ull
+
+// Everything one load fills in
+typedef struct LoadedSet {
+    MemArena modelArena;
+    OutlineMesh outline;
+    Track stadium;
+    Track fineStadium;
+    int modelJob;
+    int textureJobs[2];
+} LoadedSet;
+
+// Stadium circuit again, tessellated much finer to stand in for a long track
+static const TrackSplineSettings fineTessellation = { 1.0f, 0.05f, 1.0f, 2.0f, 0.0f };
+
+// A 16-bit .hst with its full mip chain and a deterministic pattern
+static bool WriteTestTexture(const char *fileName, int size)
+{
+    TexBinHeader header = { TEXBIN_MAGIC, TEXBIN_VERSION, (uint16_t)size, (uint16_t)size, PIXELFORMAT_UNCOMPRESSED_R5G6B5, 0, 0 };
+    for (int w = size; ; w /= 2)
+    {
+        header.dataSize += GetPixelDataSize(w, w, header.format);
+        header.mipmaps++;
+        if (w == 1) break;
+    }
+
+    unsigned char *data = (unsigned char *)malloc(sizeof(header) + header.dataSize);
+    memcpy(data, &header, sizeof(header));
+    for (uint32_t i = 0; i < header.dataSize; i++) data[sizeof(header) + i] = (unsigned char)((i * 2654435761u) >> 24);
+
+    bool saved = SaveFileData(fileName, data, sizeof(header) + header.dataSize);
+    free(data);
+    return saved;
+}
+
+static void QueueJobs(AssetLoader *loader, LoadedSet *set)
+{
+    InitAssetLoader(loader);
+    loader->headless = true; // No GL context here: decode only, and keep the images to compare
+
+    set->modelJob = AddModelJob(loader, MODEL_PATH, &set->modelArena, &set->outline);
+    set->textureJobs[0] = AddTextureJob(loader, SMALL_TEXTURE_PATH);
+    set->textureJobs[1] = AddTextureJob(loader, LARGE_TEXTURE_PATH);
+    AddSplineTrackJob(loader, &set->stadium, stadiumCircuit, STADIUM_CIRCUIT_POINTS, stadiumTessellation, set->textureJobs[0]);
+    AddSplineTrackJob(loader, &set->fineStadium, stadiumCircuit, STADIUM_CIRCUIT_POINTS, fineTessellation, set->textureJobs[0]);
+}
+
+static void UnloadSet(AssetLoader *loader, LoadedSet *set)
+{
+    UnloadModelLods(&loader->jobs[set->modelJob].lods, &set->modelArena);
+    if (loader->jobs[set->modelJob].hasOutline) UnloadOutlineMesh(&set->outline);
+    UnloadTrack(&set->stadium);
+    UnloadTrack(&set->fineStadium);
+    UnloadAssetLoader(loader);
+}
+
+static int Differs(const char *what, const void *a, const void *b, size_t bytes)
+{
+    if (((a == NULL) != (b == NULL)) || ((a != NULL) && (memcmp(a, b, bytes) != 0)))
+    {
+        printf("FAIL: %s differs\n", what);
+        return 1;
+    }
+    return 0;
+}
+
+static int CompareModels(const Model *a, const Model *b)
+{
+    if ((a->meshCount != b->meshCount) || (a->materialCount != b->materialCount))
+    {
+        printf("FAIL: model tables differ\n");
+        return 1;
+    }
+
+    int failures = Differs("mesh materials", a->meshMaterial, b->meshMaterial, a->meshCount * sizeof(int));
+    for (int i = 0; i < a->materialCount; i++)
+    {
+        failures += Differs("material colour", &a->materials[i].maps[MATERIAL_MAP_DIFFUSE].color, &b->materials[i].maps[MATERIAL_MAP_DIFFUSE].color, sizeof(Color));
+    }
+    for (int i = 0; i < a->meshCount; i++)
+    {
+        const Mesh *ma = &a->meshes[i], *mb = &b->meshes[i];
+        if ((ma->vertexCount != mb->vertexCount) || (ma->triangleCount != mb->triangleCount))
+        {
+            printf("FAIL: mesh %d counts differ\n", i);
+            failures++;
+            continue;
+        }
+        failures += Differs("mesh positions", ma->vertices, mb->vertices, ma->vertexCount * 3 * sizeof(float));
+        failures += Differs("mesh texcoords", ma->texcoords, mb->texcoords, ma->vertexCount * 2 * sizeof(float));
+        failures += Differs("mesh normals", ma->normals, mb->normals, ma->vertexCount * 3 * sizeof(float));
+        failures += Differs("mesh indices", ma->indices, mb->indices, ma->triangleCount * 3 * sizeof(unsigned short));
+    }
+    return failures;
+}
+
+static int CompareOutlines(const OutlineMesh *a, const OutlineMesh *b)
+{
+    if ((a->positionCount != b->positionCount) || (a->faceCount != b->faceCount) || (a->edgeCount != b->edgeCount))
+    {
+        printf("FAIL: outline counts differ\n");
+        return 1;
+    }
+    return Differs("outline positions", a->positions, b->positions, a->positionCount * sizeof(Vector3)) +
+           Differs("outline planes", a->planes, b->planes, a->faceCount * sizeof(Vector4)) +
+           Differs("outline edges", a->edges, b->edges, a->edgeCount * sizeof(OutlineEdge));
+}
+
+static int CompareImages(const Image *a, const Image *b)
+{
+    if ((a->width != b->width) || (a->height != b->height) || (a->mipmaps != b->mipmaps) || (a->format != b->format))
+    {
+        printf("FAIL: image headers differ\n");
+        return 1;
+    }
+
+    int bytes = 0;
+    for (int i = 0, w = a->width, h = a->height; i < a->mipmaps; i++, w = (w > 1)? w / 2 : 1, h = (h > 1)? h / 2 : 1) bytes += GetPixelDataSize(w, h, a->format);
+    return Differs("image pixels", a->data, b->data, bytes);
+}
+
+static int CompareTracks(const Track *a, const Track *b)
+{
+    if ((a->vertexCount != b->vertexCount) || (a->indexCount != b->indexCount) || (a->chunkCount != b->chunkCount) ||
+        (a->waypointCount != b->waypointCount) || (a->primitive != b->primitive))
+    {
+        printf("FAIL: track counts differ\n");
+        return 1;
+    }
+
+    const TrackSurface *sa = &a->surface, *sb = &b->surface;
+    if ((sa->segmentCount != sb->segmentCount) || (sa->gridWidth != sb->gridWidth) || (sa->gridHeight != sb->gridHeight) ||
+        (sa->cellSize != sb->cellSize) || (sa->gridOrigin.x != sb->gridOrigin.x) || (sa->gridOrigin.y != sb->gridOrigin.y))
+    {
+        printf("FAIL: track surface grids differ\n");
+        return 1;
+    }
+
+    int cells = sa->gridWidth * sa->gridHeight;
+    return Differs("track vertices", a->vertices, b->vertices, a->vertexCount * sizeof(TrackVertex)) +
+           Differs("track indices", a->indices, b->indices, a->indexCount * sizeof(unsigned short)) +
+           Differs("track waypoints", a->waypoints, b->waypoints, a->waypointCount * sizeof(Vector3)) +
+           Differs("track frames", a->frames, b->frames, a->waypointCount * sizeof(TrackFrame)) +
+           Differs("surface segments", sa->segments, sb->segments, sa->segmentCount * sizeof(TrackSurfaceSegment)) +
+           Differs("surface cells", sa->cellStart, sb->cellStart, (cells + 1) * sizeof(int)) +
+           Differs("surface cell segments", sa->cellSegments, sb->cellSegments, sa->cellStart[cells] * sizeof(int));
+}
+
+static int CompareSets(const AssetLoader *la, const LoadedSet *a, const AssetLoader *lb, const LoadedSet *b)
+{
+    int failures = 0;
+
+    for (int i = 0; i < la->jobCount; i++)
+    {
+        if (la->jobs[i].ok != lb->jobs[i].ok)
+        {
+            printf("FAIL: job %d succeeded in one load only\n", i);
+            failures++;
+        }
+    }
+
+    const ModelLods *lodsA = &la->jobs[a->modelJob].lods, *lodsB = &lb->jobs[b->modelJob].lods;
+    failures += Differs("level table", lodsA->errors, lodsB->errors, sizeof(lodsA->errors)) + (lodsA->count != lodsB->count);
+    for (int l = 0; (l < lodsA->count) && (l < lodsB->count); l++) failures += CompareModels(&lodsA->levels[l], &lodsB->levels[l]);
+    if (la->jobs[a->modelJob].hasOutline != lb->jobs[b->modelJob].hasOutline) failures++;
+    else if (la->jobs[a->modelJob].hasOutline) failures += CompareOutlines(&a->outline, &b->outline);
+    for (int t = 0; t < 2; t++) failures += CompareImages(&la->jobs[a->textureJobs[t]].image, &lb->jobs[b->textureJobs[t]].image);
+    failures += CompareTracks(&a->stadium, &b->stadium);
+    failures += CompareTracks(&a->fineStadium, &b->fineStadium);
+
+    return failures;
+}
+
+static void SleepUntil(uint64_t ns)
+{
+    uint64_t now = BenchNowNs();
+    if (now >= ns) return;
+
+    struct timespec wait = { (time_t)((ns - now) / 1000000000ull), (long)((ns - now) % 1000000000ull) };
+    nanosleep(&wait, NULL);
+}
+
+int main(int argc, char **argv)
+{
+    const char *objPath = (argc > 1)? argv[1] : DEFAULT_MODEL;
+    int runs = (argc > 2)? atoi(argv[2]) : DEFAULT_RUNS;
+    if (runs < 1) runs = 1;
+    SetTraceLogLevel(LOG_WARNING);
+
+    // The ship with the levels of detail meshconv gives it by default
+    ObjData levels[3];
+    float errors[3] = { 0.0f };
+    unsigned char *data = NULL;
+    int size = 0;
+    if (!ParseObj(objPath, &levels[0])) return 1;
+    SimplifyObj(&levels[0], levels[0].triangleCount * 2 / 5, &levels[1]);
+    SimplifyObj(&levels[0], levels[0].triangleCount * 3 / 20, &levels[2]);
+    for (int l = 1; l < 3; l++) errors[l] = GetSimplifyError(&levels[0], &levels[l]);
+    if (!BuildMeshBinLods(levels, errors, 3, &data, &size) || !SaveFileData(MODEL_PATH, data, size)) return 1;
+    free(data);
+    for (int l = 0; l < 3; l++) UnloadObj(&levels[l]);
+    if (!WriteTestTexture(SMALL_TEXTURE_PATH, 256) || !WriteTestTexture(LARGE_TEXTURE_PATH, 1024)) return 1;
+
+    // Reference: every job decoded in turn, as main() loaded before the loader thread
+    AssetLoader reference;
+    LoadedSet referenceSet;
+    QueueJobs(&reference, &referenceSet);
+    RunAssetLoader(&reference);
+    for (int i = 0; i < reference.jobCount; i++)
+    {
+        if (!reference.jobs[i].ok)
+        {
+            printf("FAIL: sequential job %d didn't load\n", i);
+            return 1;
+        }
+    }
+
+    int failures = 0;
+    double sequentialMs = 0.0, firstFrameMs = 0.0, threadedMs = 0.0, decodeMs = 0.0;
+    long frames = 0;
+
+    for (int r = 0; r < runs; r++)
+    {
+        // Sequential: nothing is drawn until the load is over
+        AssetLoader sequential;
+        LoadedSet sequentialSet;
+        QueueJobs(&sequential, &sequentialSet);
+        RunAssetLoader(&sequential);
+        sequentialMs += sequential.loadTime;
+        failures += CompareSets(&reference, &referenceSet, &sequential, &sequentialSet);
+        UnloadSet(&sequential, &sequentialSet);
+
+        // Threaded: a frame on every 60 Hz tick, the first one straight away
+        AssetLoader threaded;
+        LoadedSet threadedSet;
+        QueueJobs(&threaded, &threadedSet);
+        uint64_t start = BenchNowNs();
+        StartAssetLoader(&threaded);
+
+        uint64_t frameStart = start;
+        while (!UpdateAssetLoader(&threaded))
+        {
+            benchSink = GetAssetLoaderProgress(&threaded); // The loading screen's read of the progress
+            if (frameStart == start) firstFrameMs += (BenchNowNs() - start) / 1000000.0;
+            frames++;
+            frameStart += FRAME_NS;
+            SleepUntil(frameStart);
+        }
+        if (frameStart == start) firstFrameMs += threaded.loadTime; // Done before the first frame was due
+        threadedMs += threaded.loadTime;
+        decodeMs += threaded.decodeTime;
+
+        failures += CompareSets(&reference, &referenceSet, &threaded, &threadedSet);
+        UnloadSet(&threaded, &threadedSet);
+    }
+
+    printf("%s + 256 and 1024 texel textures + stadium at two tessellations (%d and %d rows), %d runs\n", objPath,
+           referenceSet.stadium.waypointCount, referenceSet.fineStadium.waypointCount, runs);
+    printf("%-12s %16s %14s %14s\n", "load", "first frame ms", "decode ms", "total ms");
+    printf("%-12s %16.2f %14.2f %14.2f\n", "sequential", sequentialMs / runs, sequentialMs / runs, sequentialMs / runs);
+    printf("%-12s %16.2f %14.2f %14.2f   %.1f loading frames per load\n", "threaded", firstFrameMs / runs, decodeMs / runs, threadedMs / runs,
+           (double)frames / runs);
+    printf("check: %s\n", (failures == 0)? "ok" : "FAIL");
+
+    UnloadSet(&reference, &referenceSet);
+    return (failures == 0)? 0 : 1;
+}
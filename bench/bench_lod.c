@@ -0,0 +1,208 @@
+// Levels of detail for the ship model: bakes the levels tools/meshconv writes by default (40 and
+// 15% of the triangles), loads them back and reports each one's triangles and geometric error.
+// Then races 16 ships on the stadium circuit for a minute behind main()'s chase camera and
+// reports the ship triangles queued per frame with SelectLod() against every ship at full
+// detail, and how often ships change level with and without the hysteresis band.
+//
+// Checks that each level has fewer triangles and no less error than the one before, that the
+// errors survive the .hsm round trip, and that every selection is within the band: the level
+// drawn shows no more than LOD_PIXEL_ERROR * (1 + LOD_HYSTERESIS) pixels of error, and the next
+// coarser one would have shown more than LOD_PIXEL_ERROR * (1 - LOD_HYSTERESIS).
+//
+// Usage: bench-lod [model.obj]
+
+#include <raylib.h>
+#include <raymath.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "bench_common.h"
+#include "../src/ship/ship.h"
+#include "../src/ship/pool.h"
+#include "../src/track/track.h"
+#include "../src/track/circuit.h"
+#include "../src/render/lod.h"
+#include "../tools/objconv.h"
+#include "../tools/simplify.h"
+
+#define DEFAULT_MODEL "romdisk/rship.obj"
+#define LEVELS 3
+#define SHIPS 16                // The player and main()'s 15 AI racers
+#define FRAMES (60 * 60)        // A minute at 60 Hz
+#define SCREEN_HEIGHT 480
+#define CAMERA_DISTANCE 30.0f   // Same chase camera as main()
+#define CAMERA_HEIGHT 8.0f
+#define FLICKER_FRAMES 30       // A change back within this many frames counts as a revert
+#define DT (1.0f / 60.0f)
+
+// Level changes of one selection policy over the race
+typedef struct LodStats {
+    int lod[SHIPS];
+    int previous[SHIPS];        // Level before the last change
+    int changedAt[SHIPS];       // Frame of the last change
+    long changes;
+    long reverts;
+    long triangles;
+    int failures;
+} LodStats;
+
+static void InitLodStats(LodStats *stats)
+{
+    *stats = (LodStats){ 0 };
+    for (int i = 0; i < SHIPS; i++) stats->changedAt[i] = -FLICKER_FRAMES;
+}
+
+static int GetModelTriangles(const Model *model)
+{
+    int triangles = 0;
+    for (int m = 0; m < model->meshCount; m++) triangles += model->meshes[m].triangleCount;
+    return triangles;
+}
+
+// The selection must leave the level it picks inside the band
+static bool IsInBand(const ModelLods *lods, LodView view, Vector3 position, int level)
+{
+    float scale = view.pixelsPerUnit / Vector3Distance(view.position, position);
+    bool fineEnough = lods->errors[level] * scale <= view.maxError * (1.0f + view.hysteresis) * 1.0001f;
+    bool coarseEnough = (level == lods->count - 1) || (lods->errors[level + 1] * scale > view.maxError * (1.0f - view.hysteresis) * 0.9999f);
+    return fineEnough && coarseEnough;
+}
+
+static void RecordSelection(LodStats *stats, const ModelLods *lods, LodView view, Vector3 position, int ship, int level, int frame)
+{
+    if (level != stats->lod[ship])
+    {
+        if ((level == stats->previous[ship]) && (frame - stats->changedAt[ship] < FLICKER_FRAMES)) stats->reverts++;
+        stats->previous[ship] = stats->lod[ship];
+        stats->lod[ship] = level;
+        stats->changedAt[ship] = frame;
+        stats->changes++;
+    }
+
+    stats->triangles += GetModelTriangles(&lods->levels[level]);
+    if (!IsInBand(lods, view, position, level)) stats->failures++;
+}
+
+int main(int argc, char **argv)
+{
+    const char *objPath = (argc > 1)? argv[1] : DEFAULT_MODEL;
+    SetTraceLogLevel(LOG_WARNING);
+
+    // Bake and load the levels as meshconv and the loader would
+    static const float ratios[LEVELS] = { 1.0f, 0.4f, 0.15f };
+    ObjData levels[LEVELS];
+    float errors[LEVELS] = { 0.0f };
+    if (!ParseObj(objPath, &levels[0])) return 1;
+
+    uint64_t t0 = BenchNowNs();
+    for (int l = 1; l < LEVELS; l++) SimplifyObj(&levels[0], (int)(levels[0].triangleCount * ratios[l]), &levels[l]);
+    uint64_t simplifyNs = BenchNowNs() - t0;
+    for (int l = 1; l < LEVELS; l++) errors[l] = GetSimplifyError(&levels[0], &levels[l]);
+
+    unsigned char *data = NULL;
+    int size = 0;
+    MemArena arena;
+    ModelLods lods;
+    bool ok = BuildMeshBinLods(levels, errors, LEVELS, &data, &size) && LoadModelLodsData(data, size, &arena, &lods) && (lods.count == LEVELS);
+    free(data);
+    if (!ok)
+    {
+        printf("FAIL: levels didn't load\n");
+        return 1;
+    }
+
+    LodView view = { { 0.0f, 0.0f, 0.0f }, 0.0f, LOD_PIXEL_ERROR, LOD_HYSTERESIS };
+    Camera camera = { 0 };
+    camera.up = (Vector3){ 0.0f, 1.0f, 0.0f };
+    camera.fovy = 45.0f;
+    camera.projection = CAMERA_PERSPECTIVE;
+    view.pixelsPerUnit = GetLodView(camera, SCREEN_HEIGHT).pixelsPerUnit;
+
+    printf("%s: %d levels simplified in %.1f ms, %.1f pixel budget at %d lines\n", objPath, LEVELS, simplifyNs / 1e6, view.maxError, SCREEN_HEIGHT);
+    printf("%-6s %9s %9s %10s %10s\n", "level", "triangles", "obj tris", "error", "used from");
+    for (int l = 0; l < LEVELS; l++)
+    {
+        int triangles = GetModelTriangles(&lods.levels[l]);
+        float from = lods.errors[l] * view.pixelsPerUnit / view.maxError;   // Distance its error drops to the budget at
+        printf("%-6d %9d %9d %10.4f %10.1f\n", l, triangles, levels[l].triangleCount, lods.errors[l], from);
+
+        if (lods.errors[l] != errors[l]) ok = false;
+        if ((l > 0) && ((triangles >= GetModelTriangles(&lods.levels[l - 1])) || (lods.errors[l] < lods.errors[l - 1]))) ok = false;
+    }
+    for (int l = 0; l < LEVELS; l++) UnloadObj(&levels[l]);
+
+    // The race: ship 0 is the player the camera follows
+    Track track;
+    if (!GenSplineTrack(&track, stadiumCircuit, STADIUM_CIRCUIT_POINTS, stadiumTessellation)) return 1;
+
+    ShipPool ships;
+    InitShipPool(&ships, SHIPS, &lods);
+    PlaceShipsOnGrid(&ships, track.waypoints, track.waypointCount, SHIPS);
+
+    RenderQueue queue;
+    InitRenderQueue(&queue, RENDER_QUEUE_CAPACITY);
+
+    LodStats banded, unbanded;
+    InitLodStats(&banded);
+    InitLodStats(&unbanded);
+    int levelFrames[LEVELS] = { 0 };
+    long queuedTriangles = 0;
+    uint64_t queueNs = 0;
+
+    for (int f = 0; f < FRAMES; f++)
+    {
+        UpdateShips(&ships, track.waypoints, track.waypointCount, &track.surface, DT);
+
+        ShipPose player = GetPoolShipPose(&ships, 0, 1.0f);
+        float forwardX = sinf(player.yaw * DEG2RAD), forwardZ = cosf(player.yaw * DEG2RAD);
+        camera.target = player.position;
+        camera.position = (Vector3){ player.position.x - forwardX * CAMERA_DISTANCE, player.position.y + CAMERA_HEIGHT,
+                                     player.position.z - forwardZ * CAMERA_DISTANCE };
+        view.position = camera.position;
+
+        // Queued the way main() queues the field
+        uint64_t t1 = BenchNowNs();
+        BeginRenderQueue(&queue, camera.position);
+        QueueShips(&queue, &ships, 1.0f, GetLodView(camera, SCREEN_HEIGHT));
+        queueNs += BenchNowNs() - t1;
+
+        for (int i = 0; i < queue.count; i++)
+        {
+            if (queue.items[i].type == RENDER_ITEM_MESH) queuedTriangles += queue.items[i].mesh.mesh->triangleCount;
+        }
+
+        // The same choices tracked here, and the ones a selection without the band would make
+        LodView noBand = view;
+        noBand.hysteresis = 0.0f;
+        for (int i = 0; i < SHIPS; i++)
+        {
+            Vector3 position = GetPoolShipPose(&ships, i, 1.0f).position;
+            RecordSelection(&banded, &lods, view, position, i, ships.lod[i], f);
+            RecordSelection(&unbanded, &lods, noBand, position, i, SelectLod(&lods, noBand, position, unbanded.lod[i]), f);
+            levelFrames[ships.lod[i]]++;
+        }
+    }
+
+    long fullTriangles = (long)GetModelTriangles(&lods.levels[0]) * SHIPS * FRAMES;
+    printf("race: %d ships, %d frames behind the chase camera\n", SHIPS, FRAMES);
+    printf("  ship triangles queued: %.0f per frame with levels, %.0f at full detail (%.0f%%)\n", (double)queuedTriangles / FRAMES,
+           (double)fullTriangles / FRAMES, 100.0 * queuedTriangles / fullTriangles);
+    printf("  ship draws by level:");
+    for (int l = 0; l < LEVELS; l++) printf(" %d: %.1f%%", l, 100.0 * levelFrames[l] / ((double)SHIPS * FRAMES));
+    printf("\n  queueing the field: %.2f us per frame\n", queueNs / 1000.0 / FRAMES);
+    printf("  %-18s %8s %8s\n", "", "changes", "reverts");
+    printf("  %-18s %8ld %8ld\n", "with hysteresis", banded.changes, banded.reverts);
+    printf("  %-18s %8ld %8ld\n", "without", unbanded.changes, unbanded.reverts);
+
+    ok &= (banded.triangles == queuedTriangles) && (queuedTriangles <= fullTriangles);
+    ok &= (banded.failures == 0) && (unbanded.failures == 0) && (banded.changes <= unbanded.changes);
+    if ((banded.failures != 0) || (unbanded.failures != 0)) printf("  %d selections out of band\n", banded.failures + unbanded.failures);
+
+    UnloadRenderQueue(&queue);
+    UnloadShipPool(&ships);
+    UnloadTrack(&track);
+    UnloadModelLods(&lods, &arena);
+
+    printf("check: %s\n", ok? "ok" : "FAIL");
+    return ok? 0 : 1;
+}
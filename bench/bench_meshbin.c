@@ -0,0 +1,180 @@
+// Round-trips an OBJ through the .hsm converter and LoadModelBinaryData(), checking every
+// triangle against the parsed OBJ, then compares load times of the two paths. Also checks that
+// damaged files, whose counts would wrap a 32-bit size or point outside the file, or whose
+// finest level is empty, are refused whole with nothing allocated.
+//
+// Usage: bench-meshbin [model.obj]
+
+#include <raylib.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bench_common.h"
+#include "../src/mesh/meshbin.h"
+#include "../tools/objconv.h"
+
+#define DEFAULT_MODEL "romdisk/rship.obj"
+#define BINARY_PATH "build-host/bench-meshbin.hsm"
+#define ITERATIONS 50
+
+static void ObjCornerVertex(const ObjData *obj, const ObjTriangle *tri, int k, float *out)
+{
+    ObjCorner c = tri->corners[k];
+    memcpy(&out[0], &obj->positions[c.position * 3], 3 * sizeof(float));
+    out[3] = (c.texcoord >= 0)? obj->texcoords[c.texcoord * 2 + 0] : 0.0f;
+    out[4] = (c.texcoord >= 0)? 1.0f - obj->texcoords[c.texcoord * 2 + 1] : 0.0f;
+    memcpy(&out[5], &obj->normals[c.normal * 3], 3 * sizeof(float));
+}
+
+static void MeshVertex(const Mesh *mesh, int index, float *out)
+{
+    memcpy(&out[0], &mesh->vertices[index * 3], 3 * sizeof(float));
+    memcpy(&out[3], &mesh->texcoords[index * 2], 2 * sizeof(float));
+    memcpy(&out[5], &mesh->normals[index * 3], 3 * sizeof(float));
+}
+
+// Every OBJ triangle must come back bit-identical, in order, in its material's mesh
+static int CompareTriangles(const ObjData *obj, const Model *model)
+{
+    int checked = 0;
+
+    for (int m = 0; m < model->meshCount; m++)
+    {
+        const Mesh *mesh = &model->meshes[m];
+        int t = 0;
+
+        for (int i = 0; i < obj->triangleCount; i++)
+        {
+            const ObjTriangle *tri = &obj->triangles[i];
+            if (tri->material != model->meshMaterial[m]) continue;
+
+            if (t >= mesh->triangleCount)
+            {
+                printf("FAIL: mesh %d has too few triangles\n", m);
+                return -1;
+            }
+
+            for (int k = 0; k < 3; k++)
+            {
+                float expected[8], actual[8];
+                ObjCornerVertex(obj, tri, k, expected);
+                MeshVertex(mesh, mesh->indices[t * 3 + k], actual);
+                if (memcmp(expected, actual, sizeof(expected)) != 0)
+                {
+                    printf("FAIL: mesh %d triangle %d corner %d differs from the OBJ\n", m, t, k);
+                    return -1;
+                }
+            }
+
+            t++;
+            checked++;
+        }
+
+        if (t != mesh->triangleCount)
+        {
+            printf("FAIL: mesh %d has %d extra triangles\n", m, mesh->triangleCount - t);
+            return -1;
+        }
+    }
+
+    return checked;
+}
+
+// Each damage in turn on a copy of the file: the model must not load and the arena stay empty
+static bool RefusesDamaged(const unsigned char *data, int size)
+{
+    MeshBinHeader header;
+    memcpy(&header, data, sizeof(header));
+    size_t meshTable = sizeof(MeshBinHeader) + header.materialCount * sizeof(MeshBinMaterial);
+    unsigned char *copy = (unsigned char *)malloc(size);
+    bool ok = true;
+
+    for (int test = 0; test < 4; test++)
+    {
+        memcpy(copy, data, size);
+        MeshBinHeader *damaged = (MeshBinHeader *)copy;
+        MeshBinMesh *meshes = (MeshBinMesh *)(copy + meshTable);
+        if (test == 0) meshes[0].vertexCount = 0x08000000u;                       // Vertex bytes wrap to 0
+        else if (test == 1) damaged->materialCount = 0x40000000u;                  // Table size wraps
+        else if (test == 2) meshes[damaged->meshCount - 1].vertexOffset = (uint32_t)size; // Coarsest level's last mesh past the end
+        else if (damaged->lodCount > 0) ((MeshBinLod *)(meshes + damaged->meshCount))[0].meshCount = 0; // Finest level empty
+        else damaged->meshCount = 0;
+
+        MemArena arena = { 0 };
+        ModelLods lods;
+        bool loaded = LoadModelLodsData(copy, size, &arena, &lods);
+        ok &= !loaded && (arena.memory == NULL);
+        if (loaded) UnloadModelLods(&lods, &arena);
+    }
+
+    free(copy);
+    return ok;
+}
+
+int main(int argc, char **argv)
+{
+    const char *objPath = (argc > 1)? argv[1] : DEFAULT_MODEL;
+
+    ObjData obj;
+    if (!ParseObj(objPath, &obj)) return 1;
+
+    unsigned char *data = NULL;
+    int size = 0;
+    if (!BuildMeshBin(&obj, &data, &size)) return 1;
+    SaveFileData(BINARY_PATH, data, size);
+    bool refused = RefusesDamaged(data, size);
+    free(data);
+    if (!refused)
+    {
+        printf("FAIL: a damaged file was loaded\n");
+        return 1;
+    }
+
+    // Round trip through the file the game would load
+    int fileSize = 0;
+    unsigned char *file = LoadFileData(BINARY_PATH, &fileSize);
+    MemArena arena = { 0 };
+    Model model = LoadModelBinaryData(file, fileSize, &arena);
+    UnloadFileData(file);
+
+    int checked = CompareTriangles(&obj, &model);
+    if (checked != obj.triangleCount)
+    {
+        if (checked >= 0) printf("FAIL: %d of %d triangles round-tripped\n", checked, obj.triangleCount);
+        return 1;
+    }
+
+    int vertices = 0;
+    for (int m = 0; m < model.meshCount; m++) vertices += model.meshes[m].vertexCount;
+    printf("round trip: %d triangles identical in %d meshes (%d OBJ corners -> %d vertices), damaged files refused\n",
+           checked, model.meshCount, obj.triangleCount * 3, vertices);
+    UnloadModelBinary(model, &arena);
+
+    // Load time: text parse of the OBJ/MTL against one read plus a copy per attribute
+    uint64_t objNs = 0, binNs = 0;
+    for (int i = 0; i < ITERATIONS; i++)
+    {
+        ObjData parsed;
+        uint64_t t0 = BenchNowNs();
+        ParseObj(objPath, &parsed);
+        objNs += BenchNowNs() - t0;
+        UnloadObj(&parsed);
+
+        t0 = BenchNowNs();
+        file = LoadFileData(BINARY_PATH, &fileSize);
+        Model loaded = LoadModelBinaryData(file, fileSize, &arena);
+        UnloadFileData(file);
+        binNs += BenchNowNs() - t0;
+        UnloadModelBinary(loaded, &arena);
+    }
+
+    int objSize = 0;
+    UnloadFileData(LoadFileData(objPath, &objSize));
+
+    printf("%-8s %10s %12s\n", "format", "bytes", "load (us)");
+    printf("%-8s %10d %12.1f\n", "obj", objSize, objNs / 1e3 / ITERATIONS);
+    printf("%-8s %10d %12.1f\n", "hsm", fileSize, binNs / 1e3 / ITERATIONS);
+
+    UnloadObj(&obj);
+    return 0;
+}
@@ -0,0 +1,230 @@
+// Silhouette extraction cost per frame for the ship model and simplified LODs of it. Converts
+// the OBJ with the outline section tools/meshconv writes, then views it from 2000 directions at
+// the chase camera's distance and times ExtractSilhouette() per ship and for a 16-ship field.
+// The LODs are the ones tools/meshconv bakes, simplified to 40 and 15% of the triangles, and
+// a coarser 5% one.
+//
+// Checks the baked data (edge ends on both faces' planes, unit normals) and every extraction
+// against a double-precision facing test in world space (faces seen almost edge on may go
+// either way), and that each quad sits on its edge and is as wide as OUTLINE_HALF_WIDTH asks.
+//
+// Usage: bench-outline [model.obj]
+
+#include <raylib.h>
+#include <raymath.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "bench_common.h"
+#include "../src/render/outline.h"
+#include "../src/ship/ship.h"
+#include "../tools/objconv.h"
+#include "../tools/simplify.h"
+
+#define DEFAULT_MODEL "romdisk/rship.obj"
+#define VIEWS 2000
+#define REPEATS 20              // Timed extractions per view
+#define FIELD_SHIPS 16
+#define VIEW_DISTANCE 30.0f     // Same chase camera as main()
+#define GRAZING 1e-3            // Faces closer than this to edge on (cosine) aren't checked
+
+static bool LoadOutlineFromObj(const ObjData *obj, OutlineMesh *outline)
+{
+    unsigned char *data = NULL;
+    int size = 0;
+    bool ok = BuildMeshBin(obj, &data, &size) && LoadOutlineMeshData(data, size, outline);
+    free(data);
+    return ok;
+}
+
+// Baked planes must be unit length and hold both ends of every edge they border
+static int CheckBakedData(const OutlineMesh *outline, int *boundary)
+{
+    int failures = 0;
+    *boundary = 0;
+
+    for (int f = 0; f < outline->faceCount; f++)
+    {
+        Vector4 p = outline->planes[f];
+        if (fabsf(p.x * p.x + p.y * p.y + p.z * p.z - 1.0f) > 1e-4f) failures++;
+    }
+
+    for (int i = 0; i < outline->edgeCount; i++)
+    {
+        OutlineEdge edge = outline->edges[i];
+        int faces[2] = { edge.faceA, edge.faceB };
+        if (edge.faceB == MESHBIN_NO_FACE) (*boundary)++;
+
+        for (int k = 0; k < ((edge.faceB == MESHBIN_NO_FACE)? 1 : 2); k++)
+        {
+            Vector4 p = outline->planes[faces[k]];
+            Vector3 a = outline->positions[edge.a], b = outline->positions[edge.b];
+            if ((fabsf(p.x * a.x + p.y * a.y + p.z * a.z - p.w) > 1e-3f) || (fabsf(p.x * b.x + p.y * b.y + p.z * b.z - p.w) > 1e-3f)) failures++;
+        }
+    }
+    return failures;
+}
+
+// Facing of a face in world space, in doubles: +1 towards the eye, -1 away, 0 too close to call
+static int GetReferenceFacing(const OutlineMesh *outline, int face, Vector3 onFace, Matrix transform, Vector3 eye)
+{
+    Vector4 p = outline->planes[face];
+    Vector3 world = Vector3Transform(onFace, transform);
+    double n[3] = { (double)transform.m0 * p.x + (double)transform.m4 * p.y + (double)transform.m8 * p.z,
+                    (double)transform.m1 * p.x + (double)transform.m5 * p.y + (double)transform.m9 * p.z,
+                    (double)transform.m2 * p.x + (double)transform.m6 * p.y + (double)transform.m10 * p.z };
+    double d[3] = { (double)eye.x - world.x, (double)eye.y - world.y, (double)eye.z - world.z };
+    double length = sqrt(d[0] * d[0] + d[1] * d[1] + d[2] * d[2]);
+    double cosine = (n[0] * d[0] + n[1] * d[1] + n[2] * d[2]) / length;
+
+    if (fabs(cosine) < GRAZING) return 0;
+    return (cosine > 0.0)? 1 : -1;
+}
+
+// True if the quad is the one for edge a-b (world space): its ends pulled towards the eye as
+// ExtractSilhouette() pulls them, and as wide as OUTLINE_HALF_WIDTH asks
+static bool IsEdgeQuad(const UnlitVertex *quad, Vector3 a, Vector3 b, Vector3 eye, bool *wide)
+{
+    Vector3 toEye = Vector3Subtract(eye, Vector3Scale(Vector3Add(a, b), 0.5f));
+    float distance = Vector3Length(toEye);
+    Vector3 pull = Vector3Scale(toEye, OUTLINE_DEPTH_PULL);
+    Vector3 endA = Vector3Scale(Vector3Add(quad[0].position, quad[1].position), 0.5f);
+    Vector3 endB = Vector3Scale(Vector3Add(quad[2].position, quad[3].position), 0.5f);
+
+    float tolerance = 1e-4f * distance;
+    if ((Vector3Distance(endA, Vector3Add(a, pull)) > tolerance) || (Vector3Distance(endB, Vector3Add(b, pull)) > tolerance)) return false;
+
+    float wanted = 2.0f * OUTLINE_HALF_WIDTH * distance;
+    float width = Vector3Distance(quad[0].position, quad[1].position);
+    *wide = (fabsf(width - wanted) <= 0.01f * wanted) && (fabsf(Vector3Distance(quad[2].position, quad[3].position) - wanted) <= 0.01f * wanted);
+    return true;
+}
+
+// Walks the edges in the order ExtractSilhouette() emits them, matching each reference
+// silhouette edge to the next quad. Edges too close to call go the way the extraction's own
+// facing bits (left in outline->facing) put them. Returns the mismatches; *expected gets the
+// reference silhouette's size.
+static int CheckExtraction(const OutlineMesh *outline, Matrix transform, Vector3 eye, const UnlitVertex *vertices, int count, int *expected)
+{
+    int failures = 0, q = 0;
+    *expected = 0;
+
+    for (int i = 0; i < outline->edgeCount; i++)
+    {
+        OutlineEdge edge = outline->edges[i];
+        Vector3 a = outline->positions[edge.a];
+        int front = GetReferenceFacing(outline, edge.faceA, a, transform, eye);
+        int other = (edge.faceB == MESHBIN_NO_FACE)? -1 : GetReferenceFacing(outline, edge.faceB, a, transform, eye);
+
+        bool silhouette;
+        if ((front != 0) && (other != 0)) silhouette = (front != other) && ((edge.faceB != MESHBIN_NO_FACE) || (front > 0));
+        else silhouette = (outline->facing[edge.faceA] != ((edge.faceB != MESHBIN_NO_FACE) && outline->facing[edge.faceB]));
+        if (!silhouette) continue;
+        (*expected)++;
+
+        bool wide = false;
+        Vector3 worldA = Vector3Transform(a, transform), worldB = Vector3Transform(outline->positions[edge.b], transform);
+        if ((q < count) && IsEdgeQuad(&vertices[q * 4], worldA, worldB, eye, &wide))
+        {
+            if (!wide) failures++;
+            q++;
+        }
+        else failures++;                    // Missing
+    }
+
+    return failures + (count - q);          // Quads for edges that aren't on the silhouette
+}
+
+static bool RunCase(const char *name, const OutlineMesh *outline, UnlitVertex *vertices, unsigned short *indices)
+{
+    int boundary = 0;
+    int failures = CheckBakedData(outline, &boundary);
+
+    long edgesTotal = 0;
+    int edgesMax = 0;
+    uint64_t ns = 0;
+
+    for (int v = 0; v < VIEWS; v++)
+    {
+        // Views spread over the sphere (golden angle spiral), the ship turned a little each time
+        float y = 1.0f - 2.0f * (v + 0.5f) / VIEWS;
+        float ring = sqrtf(1.0f - y * y), angle = v * 2.39996323f;
+        Vector3 eye = { cosf(angle) * ring * VIEW_DISTANCE, y * VIEW_DISTANCE, sinf(angle) * ring * VIEW_DISTANCE };
+
+        ShipPose pose = { { 10.0f, 5.0f, -20.0f }, QuaternionFromAxisAngle((Vector3){ 0.0f, 1.0f, 0.0f }, v * 0.01f), 0.0f };
+        Matrix transform = GetShipTransform(pose);
+        eye = Vector3Add(eye, pose.position);
+
+        int count = 0;
+        uint64_t t0 = BenchNowNs();
+        for (int r = 0; r < REPEATS; r++) count = ExtractSilhouette(outline, transform, eye, vertices, indices, outline->edgeCount);
+        ns += BenchNowNs() - t0;
+
+        int expected = 0;
+        failures += CheckExtraction(outline, transform, eye, vertices, count, &expected);
+        edgesTotal += count;
+        if (count > edgesMax) edgesMax = count;
+    }
+
+    double perShip = (double)ns / ((double)VIEWS * REPEATS);
+    printf("%-8s %9d %6d %6d %8d %9.1f %5d %10.2f %12.1f  %s\n", name, outline->positionCount, outline->faceCount, outline->edgeCount,
+           boundary, (double)edgesTotal / VIEWS, edgesMax, perShip / 1000.0, perShip * FIELD_SHIPS / 1000.0, (failures == 0)? "ok" : "FAIL");
+    if (failures != 0) printf("  %d failures\n", failures);
+
+    return failures == 0;
+}
+
+int main(int argc, char **argv)
+{
+    const char *objPath = (argc > 1)? argv[1] : DEFAULT_MODEL;
+    SetTraceLogLevel(LOG_WARNING);
+
+    ObjData obj;
+    if (!ParseObj(objPath, &obj)) return 1;
+
+    // Model size
+    Vector3 lo = { 1e30f, 1e30f, 1e30f }, hi = { -1e30f, -1e30f, -1e30f };
+    for (int i = 0; i < obj.positionCount; i++)
+    {
+        Vector3 p = { obj.positions[i * 3], obj.positions[i * 3 + 1], obj.positions[i * 3 + 2] };
+        lo = Vector3Min(lo, p);
+        hi = Vector3Max(hi, p);
+    }
+    float size = Vector3Distance(lo, hi);
+
+    printf("%s: %d triangles, %.1f units across, %d views at %.0f units\n", objPath, obj.triangleCount, size, VIEWS, VIEW_DISTANCE);
+    printf("%-8s %9s %6s %6s %8s %9s %5s %10s %12s\n", "lod", "positions", "faces", "edges", "boundary", "drawn", "max",
+           "us/ship", "us/16 ships");
+
+    static const float ratios[] = { 1.0f, 0.4f, 0.15f, 0.05f };
+    static const char *names[] = { "full", "40%", "15%", "5%" };
+    bool ok = true;
+
+    for (int l = 0; l < (int)(sizeof(ratios) / sizeof(ratios[0])); l++)
+    {
+        ObjData lod = obj;
+        if (ratios[l] < 1.0f) SimplifyObj(&obj, (int)(obj.triangleCount * ratios[l]), &lod);
+
+        OutlineMesh outline;
+        if (!LoadOutlineFromObj(&lod, &outline))
+        {
+            printf("%-8s no outline section  FAIL\n", names[l]);
+            ok = false;
+        }
+        else
+        {
+            UnlitVertex *vertices = (UnlitVertex *)malloc(outline.edgeCount * 4 * sizeof(UnlitVertex));
+            unsigned short *indices = (unsigned short *)malloc(outline.edgeCount * 6 * sizeof(unsigned short));
+            ok &= RunCase(names[l], &outline, vertices, indices);
+            free(vertices);
+            free(indices);
+            UnloadOutlineMesh(&outline);
+        }
+
+        if (ratios[l] < 1.0f) UnloadObj(&lod);
+    }
+
+    UnloadObj(&obj);
+    printf("check: %s\n", ok? "ok" : "FAIL");
+    return ok? 0 : 1;
+}
@@ -0,0 +1,287 @@
+// Particle pools: times UpdateParticles() on full pools of 1k, 10k and 50k particles with
+// lifetimes between LIFE_MIN and LIFE_MAX seconds, refilled after every tick so the pool stays
+// full and a steady share dies each update, against the same update over an array of particle
+// structs. Then drives a ship with attached exhaust and spark emitters around the stadium circuit,
+// swerving into the walls every few seconds, and queues both emitters every frame.
+//
+// Checks that every update keeps exactly the particles that were still alive (the dead are gone
+// and nothing is lost or duplicated by the swap-removes), that both layouts agree, that each
+// emitter queues as one item of two triangles per particle, that the effect density turns
+// emission off, and that nothing touches the heap after init: malloc, calloc and realloc are
+// counted through the linker wrappers below (-Wl,--wrap=...).
+//
+// Usage: bench-particles [ticks]
+
+#include <raylib.h>
+#include <raymath.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "bench_common.h"
+#include "../src/fx/particles.h"
+#include "../src/ship/ship.h"
+#include "../src/track/track.h"
+#include "../src/track/circuit.h"
+
+#define DEFAULT_TICKS 600
+#define LIFE_MIN 0.25f
+#define LIFE_MAX 1.5f
+#define DRAG 1.0f
+#define GRAVITY 30.0f
+#define RACE_TICKS (60 * 60)    // A minute at 60 Hz
+#define DT (1.0f / 60.0f)
+
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t count, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+
+static long heapCalls = 0;
+
+void *__wrap_malloc(size_t size)
+{
+    heapCalls++;
+    return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t count, size_t size)
+{
+    heapCalls++;
+    return __real_calloc(count, size);
+}
+
+void *__wrap_realloc(void *ptr, size_t size)
+{
+    heapCalls++;
+    return __real_realloc(ptr, size);
+}
+
+// The layout the pools replace, for comparison
+typedef struct Particle {
+    Vector3 position;
+    Vector3 velocity;
+    float age;
+    float life;
+    float size;
+} Particle;
+
+static void UpdateParticleArray(Particle *particles, int *count, float dt, float drag, float gravity)
+{
+    float keep = 1.0f - drag * dt;
+    float fall = gravity * dt;
+
+    int i = 0;
+    while (i < *count)
+    {
+        Particle *p = &particles[i];
+        p->velocity.x *= keep;
+        p->velocity.y = (p->velocity.y - fall) * keep;
+        p->velocity.z *= keep;
+        p->position.x += p->velocity.x * dt;
+        p->position.y += p->velocity.y * dt;
+        p->position.z += p->velocity.z * dt;
+        p->age += dt;
+
+        if (p->age >= p->life) particles[i] = particles[--(*count)];
+        else i++;
+    }
+}
+
+static unsigned int seed = 12345u;
+
+static float Random(float min, float max)
+{
+    seed = seed * 1664525u + 1013904223u;
+    return min + (max - min) * (float)(seed >> 8) / 16777216.0f;
+}
+
+// Fill both to capacity with the same new particles. Sizes are unique ids, so the survivors can
+// be told apart.
+static void Refill(ParticlePool *pool, Particle *particles, int *count, double *nextId)
+{
+    while (pool->count < pool->capacity)
+    {
+        Vector3 velocity = { Random(-20.0f, 20.0f), Random(0.0f, 40.0f), Random(-20.0f, 20.0f) };
+        float life = Random(LIFE_MIN, LIFE_MAX);
+        float id = (float)(*nextId += 1.0);
+        SpawnParticle(pool, Vector3Zero(), velocity, life, id);
+        particles[(*count)++] = (Particle){ Vector3Zero(), velocity, 0.0f, life, id };
+    }
+}
+
+// The particles alive after the update are those that were younger than their life by more
+// than dt, each once; both layouts must hold the same ones
+static bool CheckSurvivors(const ParticlePool *pool, const Particle *particles, int count, int expectedCount, double expectedIds)
+{
+    double ids = 0.0, arrayIds = 0.0;
+    bool ok = (pool->count == expectedCount) && (count == expectedCount);
+    for (int i = 0; i < pool->count; i++)
+    {
+        ok &= (pool->age[i] < pool->life[i]);
+        ids += pool->size[i];
+    }
+    for (int i = 0; i < count; i++) arrayIds += particles[i].size;
+    return ok && (ids == expectedIds) && (arrayIds == expectedIds);
+}
+
+static bool RunPool(int capacity, int ticks)
+{
+    ParticlePool pool;
+    InitParticlePool(&pool, capacity);
+    Particle *particles = (Particle *)malloc(capacity * sizeof(Particle));
+    int count = 0;
+    double nextId = 0.0;
+    Refill(&pool, particles, &count, &nextId);
+
+    bool ok = true;
+    long deaths = 0, calls = heapCalls;
+    uint64_t poolNs = 0, arrayNs = 0;
+    void *memory = pool.arena.base;
+
+    for (int t = 0; t < ticks; t++)
+    {
+        // Who should survive, worked out before the update
+        int expectedCount = 0;
+        double expectedIds = 0.0;
+        for (int i = 0; i < pool.count; i++)
+        {
+            if (pool.age[i] + DT < pool.life[i])
+            {
+                expectedCount++;
+                expectedIds += pool.size[i];
+            }
+        }
+        deaths += pool.count - expectedCount;
+
+        uint64_t t0 = BenchNowNs();
+        UpdateParticles(&pool, DT, DRAG, GRAVITY);
+        uint64_t t1 = BenchNowNs();
+        UpdateParticleArray(particles, &count, DT, DRAG, GRAVITY);
+        uint64_t t2 = BenchNowNs();
+        poolNs += t1 - t0;
+        arrayNs += t2 - t1;
+
+        ok &= CheckSurvivors(&pool, particles, count, expectedCount, expectedIds);
+        Refill(&pool, particles, &count, &nextId);
+    }
+
+    // Same motion either way
+    double poolY = 0.0, arrayY = 0.0;
+    for (int i = 0; i < pool.count; i++) poolY += pool.posY[i];
+    for (int i = 0; i < count; i++) arrayY += particles[i].position.y;
+    ok &= (fabs(poolY - arrayY) <= 1e-3 * fabs(arrayY) + 1e-3);
+    ok &= (heapCalls == calls) && (pool.arena.base == memory) && (pool.capacity == capacity);
+
+    double perUpdate = (double)poolNs / ticks;
+    printf("%-8d %10.1f %9.2f %10.1f %9.2f %8.1f %9.2f%%  %s\n", capacity, perUpdate / 1000.0, perUpdate / capacity, (double)arrayNs / ticks / 1000.0,
+           (double)arrayNs / ticks / capacity, (double)deaths / ticks, 100.0 * perUpdate / (1e9 * DT), ok? "ok" : "FAIL");
+
+    free(particles);
+    UnloadParticlePool(&pool);
+    return ok;
+}
+
+// Steers for a few waypoints ahead, but hard right for half a second in every five, into the wall
+static ShipInput WeavingInput(const Ship *ship, const Vector3 *waypoints, int waypointCount, float time)
+{
+    ShipInput input = { 0 };
+    int target = (ship->segment < 0)? 1 : (ship->segment + 4) % waypointCount;
+    Vector3 toTarget = Vector3Subtract(waypoints[target], ship->position);
+    float error = Wrap(atan2f(toTarget.x, toTarget.z) * RAD2DEG - ship->yaw, -180.0f, 180.0f);
+
+    input.steer = (fmodf(time, 5.0f) < 0.5f)? 1.0f : Clamp(error / 10.0f, -1.0f, 1.0f);
+    input.accelerate = true;
+    return input;
+}
+
+static bool RunRace(void)
+{
+    Track track;
+    if (!GenSplineTrack(&track, stadiumCircuit, STADIUM_CIRCUIT_POINTS, stadiumTessellation)) return false;
+
+    Ship ship;
+    InitShip(&ship, (ModelLods){ 0 }, (Texture2D){ 0 });
+    ship.position = Vector3Add(track.waypoints[0], (Vector3){ 0.0f, SHIP_HOVER_HEIGHT, 0.0f });
+    ship.previous.position = ship.position;
+
+    ParticleEmitter exhaust, sparks;
+    InitParticleEmitter(&exhaust, SHIP_EXHAUST_PARTICLES, shipExhaustStyle, ORANGE);
+    InitParticleEmitter(&sparks, SHIP_SPARK_PARTICLES, shipSparkStyle, YELLOW);
+    AttachShipEmitters(&ship, &exhaust, &sparks);
+
+    RenderQueue queue;
+    InitRenderQueue(&queue, RENDER_QUEUE_CAPACITY);
+    Camera camera = { 0 };
+    camera.up = (Vector3){ 0.0f, 1.0f, 0.0f };
+
+    bool ok = true;
+    long calls = heapCalls, exhaustLive = 0, sparkLive = 0;
+    int scrapeTicks = 0, peakExhaust = 0, peakSparks = 0;
+    uint64_t updateNs = 0, queueNs = 0;
+
+    for (int t = 0; t < RACE_TICKS; t++)
+    {
+        // The last quarter at no effect density, as the governor's worst level
+        if (t == RACE_TICKS * 3 / 4) exhaust.density = sparks.density = 0.0f;
+
+        int sparksBefore = sparks.pool.count;
+        ShipInput input = WeavingInput(&ship, track.waypoints, track.waypointCount, t * DT);
+        uint64_t t0 = BenchNowNs();
+        UpdateShip(&ship, input, &track.surface, DT);
+        updateNs += BenchNowNs() - t0;
+        if (sparks.pool.count > sparksBefore) scrapeTicks++;
+
+        float forwardX = sinf(ship.yaw * DEG2RAD), forwardZ = cosf(ship.yaw * DEG2RAD);
+        camera.target = ship.position;
+        camera.position = (Vector3){ ship.position.x - forwardX * 30.0f, ship.position.y + 8.0f, ship.position.z - forwardZ * 30.0f };
+
+        uint64_t t1 = BenchNowNs();
+        BeginRenderQueue(&queue, camera.position);
+        int queued = QueueParticles(&queue, &exhaust, camera) + QueueParticles(&queue, &sparks, camera);
+        queueNs += BenchNowNs() - t1;
+
+        // One item per emitter with particles, two triangles per particle
+        int expectedItems = (exhaust.pool.count > 0) + (sparks.pool.count > 0);
+        ok &= (queue.count == expectedItems) && (queued == exhaust.pool.count + sparks.pool.count);
+        for (int i = 0; i < queue.count; i++) ok &= (queue.items[i].unlit.indexCount == queue.items[i].unlit.vertexCount / 4 * 6);
+
+        exhaustLive += exhaust.pool.count;
+        sparkLive += sparks.pool.count;
+        if (exhaust.pool.count > peakExhaust) peakExhaust = exhaust.pool.count;
+        if (sparks.pool.count > peakSparks) peakSparks = sparks.pool.count;
+    }
+
+    // With nothing emitted for a quarter of the race, everything has burnt out
+    ok &= (exhaust.pool.count == 0) && (sparks.pool.count == 0);
+    ok &= (peakExhaust > 0) && (scrapeTicks > 0) && (heapCalls == calls);
+
+    printf("race: %d ticks, %d scraping the walls, %.1f us per ship update, %.2f us per frame queueing\n", RACE_TICKS, scrapeTicks,
+           updateNs / 1000.0 / RACE_TICKS, queueNs / 1000.0 / RACE_TICKS);
+    printf("  exhaust: %.1f live on average, %d at most of %d\n", (double)exhaustLive / RACE_TICKS, peakExhaust, exhaust.pool.capacity);
+    printf("  sparks:  %.1f live on average, %d at most of %d\n", (double)sparkLive / RACE_TICKS, peakSparks, sparks.pool.capacity);
+    printf("  heap calls after init: %ld\n", heapCalls - calls);
+
+    UnloadRenderQueue(&queue);
+    UnloadParticleEmitter(&exhaust);
+    UnloadParticleEmitter(&sparks);
+    UnloadTrack(&track);
+    return ok;
+}
+
+int main(int argc, char **argv)
+{
+    int ticks = (argc > 1)? atoi(argv[1]) : DEFAULT_TICKS;
+    if (ticks <= 0) ticks = DEFAULT_TICKS;
+    SetTraceLogLevel(LOG_WARNING);
+
+    static const int capacities[] = { 1000, 10000, 50000 };
+
+    printf("%d updates of full pools, lifetimes %.2f to %.2f s\n", ticks, LIFE_MIN, LIFE_MAX);
+    printf("%-8s %10s %9s %10s %9s %8s %10s\n", "count", "pool us", "ns each", "array us", "ns each", "deaths", "of 60 Hz");
+
+    bool ok = true;
+    for (int i = 0; i < (int)(sizeof(capacities) / sizeof(capacities[0])); i++) ok &= RunPool(capacities[i], ticks);
+    ok &= RunRace();
+
+    printf("check: %s\n", ok? "ok" : "FAIL");
+    return ok? 0 : 1;
+}
@@ -0,0 +1,133 @@
+// Cost of the phase timers and a headless run of main()'s update phases through them: the
+// player and 15 AI racers on the oval, with the ring buffer wrapped several times and dumped
+// to CSV. Checks the history length, that timed phases show up and untimed ones don't, and
+// that the CSV has a row per frame. Built with -DHSGP_PROFILE whatever PROFILE is set to.
+//
+// Usage: bench-profile [csv file]
+
+#include <raylib.h>
+#include <raymath.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bench_common.h"
+#include "bench_track.h"
+#include "../src/ship/ship.h"
+#include "../src/ship/pool.h"
+#include "../src/perf/profile.h"
+
+#define TIMER_PAIRS 1000000
+#define FRAMES (PROFILE_HISTORY_FRAMES * 4 + 10)
+#define AI_RACERS 15
+#define SEGMENTS 1000
+#define DT (1.0f / 60.0f)
+#define CSV_PATH "build-host/bench-profile.csv"
+
+// One frame of main()'s update, optionally through the timers
+static void RunFrame(Ship *player, ShipPool *pool, const BenchTrack *track, int frame, bool profiled)
+{
+    ShipInput input = { 0 };
+    input.accelerate = true;
+    input.steer = 0.3f * sinf(frame * 0.05f);
+
+    if (profiled)
+    {
+        PROFILE_SCOPE(PROFILE_SHIP_UPDATE) UpdateShip(player, input, &track->surface, DT);
+        PROFILE_SCOPE(PROFILE_AI_UPDATE) UpdateShips(pool, track->waypoints, track->waypointCount, &track->surface, DT);
+        PROFILE_FRAME();
+    }
+    else
+    {
+        UpdateShip(player, input, &track->surface, DT);
+        UpdateShips(pool, track->waypoints, track->waypointCount, &track->surface, DT);
+    }
+}
+
+static int CountCsvRows(const char *fileName, int *columns)
+{
+    FILE *file = fopen(fileName, "r");
+    if (file == NULL) return -1;
+
+    char line[512];
+    int rows = 0;
+    while (fgets(line, sizeof(line), file) != NULL)
+    {
+        if (rows == 0)
+        {
+            *columns = 1;
+            for (char *c = line; *c != '\0'; c++) if (*c == ',') (*columns)++;
+        }
+        rows++;
+    }
+
+    fclose(file);
+    return rows;
+}
+
+int main(int argc, char **argv)
+{
+    const char *csvFile = (argc > 1)? argv[1] : CSV_PATH;
+    bool ok = true;
+
+    SetTraceLogLevel(LOG_WARNING);
+
+    // Timer overhead, one Begin/End pair
+    uint64_t t0 = BenchNowNs();
+    for (int i = 0; i < TIMER_PAIRS; i++)
+    {
+        PROFILE_BEGIN(PROFILE_CAMERA);
+        PROFILE_END(PROFILE_CAMERA);
+    }
+    double pairNs = (double)(BenchNowNs() - t0) / TIMER_PAIRS;
+    PROFILE_FRAME();
+    printf("timer pair:      %.1f ns\n", pairNs);
+
+    // Same frames with and without the timers
+    BenchTrack track = LoadBenchTrack(SEGMENTS);
+    double frameNs[2] = { 0 };
+
+    for (int profiled = 0; profiled < 2; profiled++)
+    {
+        ModelLods model = { 0 };
+        Ship player;
+        InitShip(&player, model, (Texture2D){ 0 });
+        player.position = Vector3Add(track.waypoints[0], (Vector3){ 0.0f, 2.0f, 0.0f });
+
+        ShipPool pool;
+        InitShipPool(&pool, AI_RACERS, &model);
+        PlaceShipsOnGrid(&pool, track.waypoints, track.waypointCount, AI_RACERS);
+
+        t0 = BenchNowNs();
+        for (int f = 0; f < FRAMES; f++) RunFrame(&player, &pool, &track, f, profiled);
+        frameNs[profiled] = (double)(BenchNowNs() - t0) / FRAMES;
+
+        UnloadShipPool(&pool);
+    }
+
+    printf("frame:           %.2f us unprofiled, %.2f us profiled (%+.1f%%)\n", frameNs[0] / 1e3, frameNs[1] / 1e3,
+           100.0 * (frameNs[1] - frameNs[0]) / frameNs[0]);
+
+    // The ring holds the last PROFILE_HISTORY_FRAMES frames, with only the timed phases in them
+    ok &= (GetProfileFrameCount() == PROFILE_HISTORY_FRAMES);
+    ok &= (GetProfileAverage(PROFILE_SHIP_UPDATE) > 0.0f) && (GetProfileAverage(PROFILE_AI_UPDATE) > 0.0f);
+    ok &= (GetProfileAverage(PROFILE_CAMERA) == 0.0f) && (GetProfileAverage(PROFILE_END_DRAWING) == 0.0f);
+    ok &= (GetProfileFrameAverage() >= GetProfileAverage(PROFILE_SHIP_UPDATE) + GetProfileAverage(PROFILE_AI_UPDATE));
+
+    printf("%-12s %9s %9s\n", "phase", "avg (us)", "max (us)");
+    for (int i = 0; i < PROFILE_PHASE_COUNT; i++)
+    {
+        printf("%-12s %9.2f %9.2f\n", GetProfilePhaseName(i), GetProfileAverage(i) * 1e3f, GetProfileMax(i) * 1e3f);
+    }
+    printf("%-12s %9.2f\n", "frame", GetProfileFrameAverage() * 1e3f);
+
+    // A header plus a row per frame in the history, a column per phase plus the frame number and total
+    int columns = 0;
+    ok &= SaveProfileCSV(csvFile);
+    ok &= (CountCsvRows(csvFile, &columns) == PROFILE_HISTORY_FRAMES + 1) && (columns == PROFILE_PHASE_COUNT + 2);
+    printf("csv:             %s, %d columns\n", csvFile, columns);
+
+    UnloadBenchTrack(&track);
+
+    printf("check:           %s\n", ok? "ok" : "FAIL");
+    return ok? 0 : 1;
+}
@@ -0,0 +1,269 @@
+// A race frame through the render queue, counted by the counting backend: the skybox, the
+// track chunks the chase camera sees, 16 ships and a translucent ghost. Reports draws, state
+// changes and texture switches per frame sorted against drawing in submission order (what
+// main() did before the queue), and the cost of queueing, sorting and flushing.
+//
+// The ship stands in for rship.hsm: six meshes with a material each, the first textured with
+// the track's texture and the rest with raylib's default one.
+//
+// Fails if the backend is asked for a change that changes nothing, draws with the wrong state
+// or texture, an item is drawn twice or not at all, the passes and lists come out of order,
+// the track isn't drawn near to far or the ghost far to near, or a full queue draws past its
+// capacity.
+//
+// Usage: bench-render-queue [frames]
+
+#include <raylib.h>
+#include <raymath.h>
+#include <rlgl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "bench_common.h"
+#include "../src/track/track.h"
+#include "../src/ship/ship.h"
+#include "../src/ship/pool.h"
+#include "../src/render/queue.h"
+
+#define DEFAULT_FRAMES 2000
+#define SEGMENTS 1000
+#define AI_SHIPS 15
+#define SHIP_MESHES 6
+#define SCREEN_HEIGHT 480
+#define SCREEN_ASPECT (640.0f / SCREEN_HEIGHT)
+#define CAMERA_DISTANCE 30.0f   // Same chase camera as main()
+#define CAMERA_HEIGHT 8.0f
+#define DT (1.0f / 60.0f)
+
+// Texture ids as the cache hands them out in main()
+#define DEFAULT_TEXTURE 1
+#define SKYBOX_TEXTURE 2
+#define FINISH_LINE_TEXTURE 3
+
+static Material GetBenchMaterial(unsigned int texture)
+{
+    Material material = { 0 };
+    material.maps = (MaterialMap *)RL_CALLOC(MATERIAL_MAP_DIFFUSE + 1, sizeof(MaterialMap)); // Nothing here reads the others
+    material.maps[MATERIAL_MAP_DIFFUSE].texture.id = texture;
+    material.maps[MATERIAL_MAP_DIFFUSE].color = WHITE;
+    return material;
+}
+
+static Model GetBenchModel(int meshCount, const unsigned int *textures)
+{
+    Model model = { 0 };
+    model.transform = MatrixIdentity();
+    model.meshCount = meshCount;
+    model.materialCount = meshCount;
+    model.meshes = (Mesh *)RL_CALLOC(meshCount, sizeof(Mesh));
+    model.materials = (Material *)RL_CALLOC(meshCount, sizeof(Material));
+    model.meshMaterial = (int *)RL_CALLOC(meshCount, sizeof(int));
+
+    for (int i = 0; i < meshCount; i++)
+    {
+        model.meshes[i].vertexCount = 120;
+        model.materials[i] = GetBenchMaterial(textures[i]);
+        model.meshMaterial[i] = i;
+    }
+    return model;
+}
+
+static void UnloadBenchModel(Model model)
+{
+    for (int i = 0; i < model.materialCount; i++) RL_FREE(model.materials[i].maps);
+    RL_FREE(model.meshes);
+    RL_FREE(model.materials);
+    RL_FREE(model.meshMaterial);
+}
+
+// State and texture switches drawing the queue in submission order would have made, with
+// the same redundant ones left out
+static void CountSubmissionOrder(const RenderQueue *queue, int *stateChanges, int *textureChanges)
+{
+    unsigned int state = RENDER_STATE_DEFAULT, texture = 0;
+    for (int i = 0; i < queue->count; i++)
+    {
+        const RenderItem *item = &queue->items[i];
+        if (item->state != state) (*stateChanges)++;
+        if (item->texture != texture) (*textureChanges)++;
+        state = item->state;
+        texture = item->texture;
+    }
+    if (state != RENDER_STATE_DEFAULT) (*stateChanges)++;
+}
+
+static float GetItemDistance(const RenderItem *item, Vector3 viewPosition)
+{
+    Matrix m = item->mesh.transform;
+    return Vector3Distance((Vector3){ m.m12, m.m13, m.m14 }, viewPosition);
+}
+
+// Checks the flush order of the last frame: 'submitted' is the queue as it was filled
+static int CheckFlushOrder(const RenderQueue *queue, const RenderItem *submitted, int count, int skyItems, int ghostItems, bool *seen)
+{
+    int failures = 0;
+    for (int i = 0; i < count; i++) seen[i] = false;
+
+    int lastTrack = -1;
+    float lastGhost = 1e30f;
+    for (int i = 0; i < count; i++)
+    {
+        int index = queue->order[i];
+        if ((index < 0) || (index >= count) || seen[index]) return failures + 1;
+        seen[index] = true;
+
+        bool isSky = (index < skyItems);
+        bool isGhost = (index >= count - ghostItems);
+        if (isSky != (i < skyItems)) failures++;          // The sky pass first
+        if (isGhost != (i >= count - ghostItems)) failures++;   // Translucent last
+
+        // Track chunks keep their near to far submission order, the ghost's meshes go far to near
+        const RenderItem *item = &submitted[index];
+        if (item->type == RENDER_ITEM_VERTICES)
+        {
+            if (index < lastTrack) failures++;
+            lastTrack = index;
+        }
+        if (isGhost)
+        {
+            float distance = GetItemDistance(item, queue->viewPosition);
+            if (distance > lastGhost + 0.01f) failures++;
+            lastGhost = distance;
+        }
+    }
+    return failures;
+}
+
+// A queue smaller than the frame keeps what fits and draws only that
+static bool CheckOverflow(const Model *model)
+{
+    RenderQueue queue;
+    InitRenderQueue(&queue, 4);
+    BeginRenderQueue(&queue, (Vector3){ 0.0f, 0.0f, 0.0f });
+
+    SetTraceLogLevel(LOG_ERROR); // The warning is expected
+    QueueModel(&queue, RENDER_PASS_WORLD, RENDER_STATE_DEFAULT, model, MatrixIdentity(), WHITE);
+    SetTraceLogLevel(LOG_WARNING);
+
+    RenderCounters counters;
+    ResetRenderCounters(&counters);
+    RenderBackend backend = GetCountingRenderBackend(&counters);
+    FlushRenderQueue(&queue, &backend);
+
+    bool ok = (queue.stats.dropped == model->meshCount - 4) && (counters.draws == 4) && (queue.stats.items == 4);
+    printf("overflow:  %d of %d meshes queued, %d dropped  %s\n", queue.stats.items, model->meshCount, queue.stats.dropped, ok? "ok" : "FAIL");
+
+    UnloadRenderQueue(&queue);
+    return ok;
+}
+
+int main(int argc, char **argv)
+{
+    int frames = (argc > 1)? atoi(argv[1]) : DEFAULT_FRAMES;
+    if (frames <= 0) frames = DEFAULT_FRAMES;
+    SetTraceLogLevel(LOG_WARNING);
+
+    Track track = { 0 };
+    TrackRibbon ribbon = GenTrackRibbon(500.0f, 200.0f, SEGMENTS, 50.0f, 10.0f);
+    BuildTrack(&track, &ribbon, TRACK_DEFAULT_PRIMITIVE);
+    UnloadTrackRibbon(&ribbon);
+    track.material = GetBenchMaterial(FINISH_LINE_TEXTURE);
+
+    static const unsigned int shipTextures[SHIP_MESHES] = { FINISH_LINE_TEXTURE, DEFAULT_TEXTURE, DEFAULT_TEXTURE, DEFAULT_TEXTURE, DEFAULT_TEXTURE, DEFAULT_TEXTURE };
+    static const unsigned int skyboxTextures[1] = { SKYBOX_TEXTURE };
+    Model shipModel = GetBenchModel(SHIP_MESHES, shipTextures);
+    Model skyboxModel = GetBenchModel(1, skyboxTextures);
+
+    // The player is the pool's first ship, the ghost its last one's pose
+    ModelLods shipLods = { .levels = { shipModel }, .count = 1 };
+    ShipPool ships;
+    InitShipPool(&ships, AI_SHIPS + 1, &shipLods);
+    PlaceShipsOnGrid(&ships, track.waypoints, track.waypointCount, AI_SHIPS + 1);
+
+    RenderQueue queue;
+    InitRenderQueue(&queue, RENDER_QUEUE_CAPACITY);
+    RenderItem *submitted = (RenderItem *)RL_MALLOC(RENDER_QUEUE_CAPACITY * sizeof(RenderItem));
+    bool *seen = (bool *)RL_MALLOC(RENDER_QUEUE_CAPACITY * sizeof(bool));
+
+    RenderCounters counters;
+    RenderBackend backend = GetCountingRenderBackend(&counters);
+
+    Camera camera = { 0 };
+    camera.up = (Vector3){ 0.0f, 1.0f, 0.0f };
+    camera.fovy = 45.0f;
+    camera.projection = CAMERA_PERSPECTIVE;
+
+    long items = 0, draws = 0, sortedState = 0, sortedTexture = 0, naiveState = 0, naiveTexture = 0;
+    int maxItems = 0, failures = 0;
+    uint64_t queueNs = 0, flushNs = 0;
+
+    for (int f = 0; f < frames; f++)
+    {
+        UpdateShips(&ships, track.waypoints, track.waypointCount, &track.surface, DT);
+
+        ShipPose player = GetPoolShipPose(&ships, 0, 1.0f);
+        float forwardX = sinf(player.yaw * DEG2RAD), forwardZ = cosf(player.yaw * DEG2RAD);
+        camera.target = player.position;
+        camera.position = (Vector3){ player.position.x - forwardX * CAMERA_DISTANCE, player.position.y + CAMERA_HEIGHT,
+                                     player.position.z - forwardZ * CAMERA_DISTANCE };
+
+        // Queued the way main() queues a frame
+        uint64_t t0 = BenchNowNs();
+        BeginRenderQueue(&queue, camera.position);
+        QueueModel(&queue, RENDER_PASS_SKY, RENDER_BLEND, &skyboxModel, MatrixScale(1000.0f, 1000.0f, 1000.0f), WHITE);
+        Frustum frustum = GetCameraFrustum(camera, SCREEN_ASPECT, RL_CULL_DISTANCE_NEAR, RL_CULL_DISTANCE_FAR);
+        QueueTrack(&queue, &track, &frustum, camera.position);
+        QueueShips(&queue, &ships, 1.0f, GetLodView(camera, SCREEN_HEIGHT));
+        ShipPose ghost = GetPoolShipPose(&ships, AI_SHIPS, 1.0f);
+        QueueShipModel(&queue, &shipModel, ghost, RENDER_TRANSLUCENT | RENDER_CULL_BACK | RENDER_BLEND, Fade(WHITE, 0.5f));
+        uint64_t t1 = BenchNowNs();
+
+        int count = queue.count;
+        int stateChanges = 0, textureChanges = 0;
+        CountSubmissionOrder(&queue, &stateChanges, &textureChanges);
+        for (int i = 0; i < count; i++) submitted[i] = queue.items[i];
+        naiveState += stateChanges;
+        naiveTexture += textureChanges;
+
+        ResetRenderCounters(&counters);
+        uint64_t t2 = BenchNowNs();
+        FlushRenderQueue(&queue, &backend);
+        uint64_t t3 = BenchNowNs();
+
+        queueNs += t1 - t0;
+        flushNs += t3 - t2;
+        items += count;
+        draws += counters.draws;
+        sortedState += counters.stateChanges;
+        sortedTexture += counters.textureChanges;
+        if (count > maxItems) maxItems = count;
+
+        // The counting backend saw exactly what the queue says it asked for
+        if ((counters.redundantChanges != 0) || (counters.mismatchedDraws != 0) || (counters.draws != count)) failures++;
+        if ((counters.stateChanges != queue.stats.stateChanges) || (counters.textureChanges != queue.stats.textureChanges)) failures++;
+        if (counters.state != RENDER_STATE_DEFAULT) failures++;
+        failures += CheckFlushOrder(&queue, submitted, count, skyboxModel.meshCount, shipModel.meshCount, seen);
+    }
+
+    printf("%d frames, %d-segment track, %d ships and a ghost of %d meshes each\n", frames, SEGMENTS, AI_SHIPS + 1, SHIP_MESHES);
+    printf("items:     %.1f per frame (max %d of %d), %.1f draws\n", (double)items / frames, maxItems, RENDER_QUEUE_CAPACITY, (double)draws / frames);
+    printf("%-10s %14s %16s\n", "", "state changes", "texture changes");
+    printf("%-10s %14.1f %16.1f\n", "submitted", (double)naiveState / frames, (double)naiveTexture / frames);
+    printf("%-10s %14.1f %16.1f\n", "sorted", (double)sortedState / frames, (double)sortedTexture / frames);
+    printf("cost:      queue %.2f us, sort and flush %.2f us per frame\n", queueNs / 1000.0 / frames, flushNs / 1000.0 / frames);
+    printf("order:     %d failures  %s\n", failures, (failures == 0)? "ok" : "FAIL");
+
+    bool ok = (failures == 0) && (sortedTexture <= naiveTexture) && (sortedState <= naiveState);
+    ok &= CheckOverflow(&shipModel);
+
+    RL_FREE(seen);
+    RL_FREE(submitted);
+    UnloadRenderQueue(&queue);
+    UnloadShipPool(&ships);
+    UnloadBenchModel(skyboxModel);
+    UnloadBenchModel(shipModel);
+    UnloadTrack(&track);
+
+    printf("check:     %s\n", ok? "ok" : "FAIL");
+    return ok? 0 : 1;
+}
@@ -0,0 +1,199 @@
+// Records a scripted run on the game's stadium circuit, round-trips it through a .hsr file and
+// replays it as a fixed workload: the player driven by the recording plus 15 AI racers it can
+// bump into, the same ticks main() runs. Checks every replayed tick lands on the recorded ship
+// state bit for bit and the final state matches the hash in the file, and that truncated or
+// cut-off streams are refused. Reports the encoded size against raw inputs.
+//
+// Usage: bench-replay [recording.hsr]   (replays the given recording instead of making one)
+
+#include <raylib.h>
+#include <raymath.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "bench_common.h"
+#include "../src/ship/ship.h"
+#include "../src/ship/pool.h"
+#include "../src/track/track.h"
+#include "../src/track/circuit.h"
+#include "../src/replay/replay.h"
+#include "../src/collision/collision.h"
+
+#define RECORD_TICKS (3 * 60 * 60)  // A three minute race at 60 Hz
+#define REPEATS 20
+#define AI_RACERS 15
+#define TICK_RATE 60.0f
+#define VMU_BLOCK_BYTES 512
+#define RECORDING_PATH "build-host/bench-replay.hsr"
+
+// Steer for a waypoint a little way ahead with some weave, lift off and brake now and then
+static ShipInput ScriptedInput(const Ship *ship, const Vector3 *waypoints, int waypointCount, float time)
+{
+    ShipInput input = { 0 };
+
+    int target = (ship->segment < 0)? 1 : (ship->segment + 3) % waypointCount;
+    Vector3 toTarget = Vector3Subtract(waypoints[target], ship->position);
+    float error = Wrap(atan2f(toTarget.x, toTarget.z) * RAD2DEG - ship->yaw, -180.0f, 180.0f);
+
+    input.steer = Clamp(error / 10.0f + 0.3f * sinf(time * 0.78f), -1.0f, 1.0f);
+    if (fabsf(input.steer) < 0.1f) input.steer = 0.0f; // Deadzone, as ReadShipInput() applies
+    input.accelerate = fmodf(time, 10.0f) < 9.5f;
+    input.brake = fmodf(time, 20.0f) > 19.7f;
+    return input;
+}
+
+// Player on pole facing along the track, as main() places it
+static void ResetShip(Ship *ship, const Track *track)
+{
+    Vector3 direction = Vector3Subtract(track->waypoints[1], track->waypoints[0]);
+    InitShip(ship, (ModelLods){ 0 }, (Texture2D){ 0 });
+    ship->position = Vector3Add(track->waypoints[0], (Vector3){ 0.0f, 2.0f, 0.0f });
+    ship->yaw = atan2f(direction.x, direction.z) * RAD2DEG;
+    ship->previous = (ShipPose){ ship->position, ship->rotation, ship->yaw };
+}
+
+static bool Record(const Track *track, uint32_t trackHash, uint32_t *stateHashes)
+{
+    Ship ship;
+    ResetShip(&ship, track);
+
+    // The AI field races alongside, as in main(), so bumps are part of the recording
+    ModelLods model = { 0 };
+    ShipPool pool;
+    InitShipPool(&pool, AI_RACERS, &model);
+    PlaceShipsOnGrid(&pool, track->waypoints, track->waypointCount, AI_RACERS);
+    CollisionWorld world;
+    InitCollisionWorld(&world, AI_RACERS + 1);
+    Ship *racers[] = { &ship };
+    int contacts = 0;
+
+    ReplayRecorder recorder;
+    if (!InitReplayRecorder(&recorder, &ship, trackHash, TICK_RATE)) return false;
+
+    for (int t = 0; t < RECORD_TICKS; t++)
+    {
+        ShipInput input = RecordReplayTick(&recorder, ScriptedInput(&ship, track->waypoints, track->waypointCount, t / TICK_RATE));
+        UpdateShip(&ship, input, &track->surface, 1.0f / TICK_RATE);
+        UpdateShips(&pool, track->waypoints, track->waypointCount, &track->surface, 1.0f / TICK_RATE);
+        contacts += CollideShips(&world, racers, 1, &pool, &track->surface);
+        stateHashes[t] = GetShipStateHash(&ship);
+    }
+    FinishReplayRecording(&recorder, &ship);
+    UnloadCollisionWorld(&world);
+    UnloadShipPool(&pool);
+
+    int size = GetReplaySize(&recorder);
+    int raw = RECORD_TICKS * (int)sizeof(ShipInput);
+    printf("recorded:     %u ticks, %u bits (%.2f bits/tick), %d ship contacts\n", recorder.header.tickCount,
+           recorder.header.bitCount, (float)recorder.header.bitCount / recorder.header.tickCount, contacts);
+    printf("size:         %d bytes, %d VMU blocks (raw inputs %d bytes, %.1fx)\n", size,
+           (size + VMU_BLOCK_BYTES - 1) / VMU_BLOCK_BYTES, raw, (float)raw / size);
+
+    bool ok = !recorder.full && (recorder.header.tickCount == RECORD_TICKS) && SaveReplay(&recorder, RECORDING_PATH);
+    UnloadReplayRecorder(&recorder);
+    return ok;
+}
+
+// One run of the workload. Returns the ticks played, counting those whose state differs from 'stateHashes'.
+static int Replay(ReplayPlayer *player, const Track *track, const uint32_t *stateHashes, int *mismatches, Ship *ship)
+{
+    ModelLods model = { 0 };
+    ShipPool pool;
+    InitShipPool(&pool, AI_RACERS, &model);
+    PlaceShipsOnGrid(&pool, track->waypoints, track->waypointCount, AI_RACERS);
+
+    CollisionWorld world;
+    InitCollisionWorld(&world, AI_RACERS + 1);
+    Ship *racers[] = { ship };
+
+    InitShip(ship, model, (Texture2D){ 0 });
+    RestartReplay(player);
+    PlaceReplayShip(player, ship);
+
+    float dt = 1.0f / player->header.tickRate;
+    int ticks = 0;
+    ShipInput input;
+    while (NextReplayInput(player, &input))
+    {
+        UpdateShip(ship, input, &track->surface, dt);
+        UpdateShips(&pool, track->waypoints, track->waypointCount, &track->surface, dt);
+        CollideShips(&world, racers, 1, &pool, &track->surface);
+        if ((stateHashes != NULL) && (GetShipStateHash(ship) != stateHashes[ticks])) (*mismatches)++;
+        ticks++;
+    }
+
+    UnloadCollisionWorld(&world);
+    UnloadShipPool(&pool);
+    return ticks;
+}
+
+int main(int argc, char **argv)
+{
+    const char *fileName = (argc > 1)? argv[1] : RECORDING_PATH;
+    bool ok = true;
+
+    SetTraceLogLevel(LOG_WARNING);
+
+    Track track = { 0 };
+    TrackRibbon ribbon = GenSplineTrackRibbon(stadiumCircuit, STADIUM_CIRCUIT_POINTS, stadiumTessellation);
+    BuildTrack(&track, &ribbon, TRACK_DEFAULT_PRIMITIVE);
+    UnloadTrackRibbon(&ribbon);
+    uint32_t trackHash = GetTrackSurfaceHash(&track.surface);
+
+    // Without an argument, make the recording first and keep every tick's state to compare against
+    uint32_t *stateHashes = NULL;
+    if (argc <= 1)
+    {
+        stateHashes = (uint32_t *)malloc(RECORD_TICKS * sizeof(uint32_t));
+        ok &= Record(&track, trackHash, stateHashes);
+    }
+
+    ReplayPlayer player;
+    if (!LoadReplay(&player, fileName))
+    {
+        printf("FAIL: could not load %s\n", fileName);
+        return 1;
+    }
+    if (player.header.trackHash != trackHash) printf("warning:      recorded on a different track\n");
+
+    // A truncated file must be refused
+    ReplayPlayer truncated;
+    ok &= !LoadReplayData(&truncated, player.data, player.dataSize - 1) || (player.header.bitCount == 0);
+
+    // So must a run cut off mid-field: one byte, a change of steer whose 8 absolute bits aren't there
+    unsigned char cut[sizeof(ReplayHeader) + 1];
+    ReplayHeader cutHeader = player.header;
+    cutHeader.bitCount = 8;
+    memcpy(cut, &cutHeader, sizeof(cutHeader));
+    cut[sizeof(ReplayHeader)] = 0xff;
+    ReplayPlayer cutPlayer;
+    ShipInput cutInput;
+    ok &= LoadReplayData(&cutPlayer, cut, sizeof(cut)) && !NextReplayInput(&cutPlayer, &cutInput) && (cutPlayer.readBit <= 8);
+    UnloadReplay(&cutPlayer);
+
+    // Timed runs of the workload, every one checked against the recorded final state
+    Ship ship;
+    int mismatches = 0, ticks = 0, finalMismatches = 0;
+    uint64_t t0 = BenchNowNs();
+    for (int r = 0; r < REPEATS; r++)
+    {
+        ticks = Replay(&player, &track, stateHashes, &mismatches, &ship);
+        if (GetShipStateHash(&ship) != player.header.finalHash) finalMismatches++;
+    }
+    uint64_t totalNs = BenchNowNs() - t0;
+
+    ok &= (ticks == (int)player.header.tickCount) && (mismatches == 0) && (finalMismatches == 0);
+
+    printf("replayed:     %d ticks x %d, player + %d AI: %.1f us/tick (%.1f ms per run)\n", ticks, REPEATS, AI_RACERS,
+           totalNs / 1e3 / ((double)ticks * REPEATS), totalNs / 1e6 / REPEATS);
+    printf("final state:  pos (%.3f, %.3f, %.3f) speed %.3f, hash %08x (recorded %08x)\n", ship.position.x, ship.position.y,
+           ship.position.z, ship.speed, GetShipStateHash(&ship), player.header.finalHash);
+    printf("check:        %s (%d tick and %d final state mismatches)\n", ok? "ok" : "FAIL", mismatches, finalMismatches);
+
+    UnloadReplay(&player);
+    free(stateHashes);
+    UnloadTrack(&track);
+
+    return ok? 0 : 1;
+}
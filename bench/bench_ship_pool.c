@@ -0,0 +1,100 @@
+// Cost per ship per tick of the batched ShipPool update at 1, 8, 16 and 64 AI racers,
+// against the same number of individual Ship structs driven through UpdateShip().
+
+#include <raylib.h>
+#include <raymath.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "bench_common.h"
+#include "bench_track.h"
+#include "../src/ship/ship.h"
+#include "../src/ship/pool.h"
+
+#define TICKS 20000
+#define SEGMENTS 1000
+#define DT (1.0f / 60.0f)
+
+// Waypoint-following input for the one-struct-per-ship path, same steering rule as the pool
+static ShipInput FollowInput(const Ship *ship, const Vector3 *waypoints, int waypointCount, int *waypoint)
+{
+    ShipInput input = { 0 };
+    int wp = *waypoint;
+    for (int k = 0; k < waypointCount; k++)
+    {
+        if (Vector3DistanceSqr(waypoints[wp], ship->position) > 40.0f * 40.0f) break;
+        wp = (wp + 1) % waypointCount;
+    }
+    *waypoint = wp;
+
+    float fx = sinf(ship->yaw * DEG2RAD), fz = cosf(ship->yaw * DEG2RAD);
+    Vector3 d = Vector3Subtract(waypoints[wp], ship->position);
+    float side = (fz * d.x - fx * d.z) / (sqrtf(d.x * d.x + d.z * d.z) + 0.0001f);
+    input.steer = Clamp(side * 3.0f, -1.0f, 1.0f);
+    input.accelerate = fabsf(input.steer) < 0.5f;
+    return input;
+}
+
+static void RunCase(const BenchTrack *track, int count)
+{
+    ModelLods model = { 0 };
+    ShipPool pool;
+    InitShipPool(&pool, count, &model);
+    PlaceShipsOnGrid(&pool, track->waypoints, track->waypointCount, count);
+
+    // Individual ships start from the same grid slots
+    Ship *ships = (Ship *)malloc(count * sizeof(Ship));
+    int *shipWaypoints = (int *)malloc(count * sizeof(int));
+    for (int i = 0; i < count; i++)
+    {
+        InitShip(&ships[i], model, (Texture2D){ 0 });
+        ships[i].position = (Vector3){ pool.posX[i], pool.posY[i], pool.posZ[i] };
+        ships[i].yaw = pool.yaw[i];
+        shipWaypoints[i] = pool.waypoint[i];
+    }
+
+    uint64_t t0 = BenchNowNs();
+    for (int t = 0; t < TICKS; t++) UpdateShips(&pool, track->waypoints, track->waypointCount, &track->surface, DT);
+    double poolNs = (double)(BenchNowNs() - t0) / ((double)TICKS * count);
+
+    t0 = BenchNowNs();
+    for (int t = 0; t < TICKS; t++)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            ShipInput input = FollowInput(&ships[i], track->waypoints, track->waypointCount, &shipWaypoints[i]);
+            UpdateShip(&ships[i], input, &track->surface, DT);
+        }
+    }
+    double singleNs = (double)(BenchNowNs() - t0) / ((double)TICKS * count);
+
+    // Sanity: the field should still be racing, not parked off the track
+    int onTrack = 0;
+    float meanSpeed = 0.0f;
+    for (int i = 0; i < count; i++)
+    {
+        Vector3 p = { pool.posX[i], pool.posY[i], pool.posZ[i] };
+        if (QueryTrackSurface(&track->surface, p, pool.segment[i]).hit) onTrack++;
+        meanSpeed += pool.speed[i] / count;
+    }
+
+    printf("%6d %14.1f %16.1f %10d/%-3d %10.2f\n", count, poolNs, singleNs, onTrack, count, meanSpeed);
+
+    free(shipWaypoints);
+    free(ships);
+    UnloadShipPool(&pool);
+}
+
+int main(void)
+{
+    BenchTrack track = LoadBenchTrack(SEGMENTS);
+
+    printf("%d ticks on a %d-segment track\n", TICKS, SEGMENTS);
+    printf("%6s %14s %16s %14s %10s\n", "ships", "pool(ns/ship)", "single(ns/ship)", "on track", "speed");
+
+    int cases[] = { 1, 8, 16, 64 };
+    for (int i = 0; i < (int)(sizeof(cases) / sizeof(cases[0])); i++) RunCase(&track, cases[i]);
+
+    UnloadBenchTrack(&track);
+    return 0;
+}
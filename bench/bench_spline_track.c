@@ -0,0 +1,156 @@
+// Generates spline tracks with curvature-adaptive tessellation and checks the result: every
+// segment within the limits (including the one closing the loop), orthonormal frames, row
+// normals agreeing with the triangles they're on, and surface queries returning them. Reports
+// how many rows the adaptive tessellation used against uniform spacing at the same detail.
+//
+// Usage: bench-spline-track
+
+#include <raylib.h>
+#include <raymath.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <float.h>
+#include "bench_common.h"
+#include "../src/track/track.h"
+
+#define FRAME_EPSILON 0.001f
+#define MAX_POINTS 16
+
+// Two straights joined by half circles, with a crest halfway down the back straight
+static int MakeStadium(TrackControlPoint *points, float straight, float radius, float hill, float bank)
+{
+    int count = 0;
+    points[count++] = (TrackControlPoint){ { 0.0f, 0.0f, -radius }, 200.0f, 0.0f };
+    for (int side = 0; side < 2; side++)
+    {
+        float cx = (side == 0)? straight : -straight;
+        for (int k = 0; k < 5; k++)
+        {
+            float angle = (side * 180.0f - 90.0f + k * 45.0f) * DEG2RAD;
+            float b = ((k == 0) || (k == 4))? 0.0f : bank;
+            points[count++] = (TrackControlPoint){ { cx + radius * cosf(angle), 10.0f, radius * sinf(angle) }, 200.0f, b };
+        }
+        if (side == 0) points[count++] = (TrackControlPoint){ { 0.0f, hill, radius }, 200.0f, 0.0f };
+    }
+    return count;
+}
+
+// A ring of hills, narrowing on the climbs
+static int MakeHillRing(TrackControlPoint *points, int count, float radius, float hill)
+{
+    for (int i = 0; i < count; i++)
+    {
+        float angle = (float)i / count * 2.0f * PI;
+        bool top = (i % 2) == 1;
+        points[i] = (TrackControlPoint){ { radius * cosf(angle), top? hill : 0.0f, radius * sinf(angle) }, top? 140.0f : 200.0f, 8.0f };
+    }
+    return count;
+}
+
+static float AngleBetween(Vector3 a, Vector3 b)
+{
+    return acosf(Clamp(Vector3DotProduct(a, b), -1.0f, 1.0f)) * RAD2DEG;
+}
+
+static bool CheckFrame(const TrackFrame *frame)
+{
+    return (fabsf(Vector3Length(frame->forward) - 1.0f) < FRAME_EPSILON) && (fabsf(Vector3Length(frame->side) - 1.0f) < FRAME_EPSILON) &&
+           (fabsf(Vector3Length(frame->up) - 1.0f) < FRAME_EPSILON) && (fabsf(Vector3DotProduct(frame->forward, frame->side)) < FRAME_EPSILON) &&
+           (fabsf(Vector3DotProduct(frame->forward, frame->up)) < FRAME_EPSILON) && (fabsf(Vector3DotProduct(frame->side, frame->up)) < FRAME_EPSILON);
+}
+
+static bool RunCase(const char *name, const TrackControlPoint *points, int pointCount, TrackSplineSettings settings)
+{
+    uint64_t t0 = BenchNowNs();
+    TrackRibbon ribbon = GenSplineTrackRibbon(points, pointCount, settings);
+    uint64_t genNs = BenchNowNs() - t0;
+
+    MemArena arena = { 0 };
+    TrackSurface surface = { 0 };
+    InitArena(&arena, GetTrackSurfaceSize(&ribbon));
+    BuildTrackSurface(&surface, &ribbon, &arena);
+
+    // Triangles in a quad warped by turning and banking lean off the rows' normals, but not by
+    // more than twice what the rows may differ by
+    float minTriangleDot = cosf(2.0f * (settings.maxTurn + settings.maxRoll) * DEG2RAD);
+    int failures = 0, segment = -1;
+    float maxTurn = 0.0f, minLength = FLT_MAX, maxLength = 0.0f, minDot = 1.0f;
+    const TrackFrame *frames = ribbon.frames;
+
+    for (int i = 0; i < ribbon.rowCount; i++)
+    {
+        const TrackFrame *a = &frames[i];
+        const TrackFrame *b = &frames[(i + 1) % ribbon.rowCount];
+
+        if (!CheckFrame(a)) failures++;
+
+        // Every segment within the limits, the one closing the loop included
+        float turn = AngleBetween(a->forward, b->forward);
+        float length = Vector3Distance(a->position, b->position);
+        if ((turn > settings.maxTurn + 0.01f) || (length > settings.maxLength + 0.01f)) failures++;
+        if (AngleBetween(a->up, b->up) > settings.maxTurn + settings.maxRoll + 0.01f) failures++;
+        maxTurn = fmaxf(maxTurn, turn);
+        minLength = fminf(minLength, length);
+        maxLength = fmaxf(maxLength, length);
+
+        // Row normals on the same side as, and close to, the triangles they border
+        for (int t = 0; t < 2; t++)
+        {
+            Vector4 plane = surface.segments[i].planes[t];
+            Vector3 n = { plane.x, plane.y, plane.z };
+            float dot = fminf(Vector3DotProduct(n, a->up), Vector3DotProduct(n, b->up));
+            minDot = fminf(minDot, dot);
+            if (dot < minTriangleDot) failures++;
+        }
+
+        // Queries halfway along find this segment, a height within its corners and the blended normal
+        const Vector3 *c = surface.segments[i].corners;
+        float low = fminf(fminf(c[0].y, c[1].y), fminf(c[2].y, c[3].y));
+        float high = fmaxf(fmaxf(c[0].y, c[1].y), fmaxf(c[2].y, c[3].y));
+        Vector3 middle = Vector3Lerp(a->position, b->position, 0.5f);
+        TrackSurfaceHit hit = QueryTrackSurface(&surface, Vector3Add(middle, (Vector3){ 0.0f, 2.0f, 0.0f }), segment);
+        if (!hit.hit || (hit.segment != i) || (hit.height < low) || (hit.height > high)) failures++;
+        else if (Vector3DotProduct(hit.normal, Vector3Normalize(Vector3Add(a->up, b->up))) < 0.999f) failures++;
+        if (hit.hit) segment = hit.segment;
+    }
+
+    // Uniform spacing needs the shortest adaptive segment everywhere to keep the same detail in the bends
+    float lapLength = frames[ribbon.rowCount - 1].distance + Vector3Distance(frames[ribbon.rowCount - 1].position, frames[0].position);
+    int uniformRows = (int)ceilf(lapLength / minLength);
+
+    printf("%-12s %7.0f %6d %8d %7.1fx %6.1f %6.1f %6.2f %8.4f %8.1f %6s\n", name, lapLength, ribbon.rowCount, uniformRows,
+           (float)uniformRows / ribbon.rowCount, minLength, maxLength, maxTurn, minDot, genNs / 1e3, (failures == 0)? "ok" : "FAIL");
+
+    UnloadArena(&arena);
+    UnloadTrackRibbon(&ribbon);
+
+    return failures == 0;
+}
+
+int main(void)
+{
+    TrackControlPoint points[MAX_POINTS];
+    TrackSplineSettings settings = { 4.0f, 2.0f, 4.0f, 80.0f, 0.0f };
+    bool ok = true;
+
+    printf("%-12s %7s %6s %8s %8s %6s %6s %6s %8s %8s %6s\n", "track", "length", "rows", "uniform", "saving",
+           "min seg", "max seg", "turn", "min dot", "gen (us)", "check");
+
+    int count = MakeStadium(points, 400.0f, 350.0f, 40.0f, 12.0f);
+    ok &= RunCase("stadium", points, count, settings);
+
+    settings.maxTurn = 2.0f;
+    ok &= RunCase("stadium fine", points, count, settings);
+
+    settings.maxTurn = 4.0f;
+    count = MakeHillRing(points, 8, 600.0f, 60.0f);
+    ok &= RunCase("hill ring", points, count, settings);
+
+    // A full turn of twist closes seamlessly
+    settings.twist = 360.0f;
+    settings.maxRoll = 6.0f;
+    ok &= RunCase("twisted ring", points, count, settings);
+
+    return ok? 0 : 1;
+}
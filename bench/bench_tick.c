@@ -0,0 +1,117 @@
+// Headless simulation tick benchmark: drives scripted inputs through UpdateShip()
+// on a generated track and reports throughput and per-tick latency percentiles.
+//
+// Usage: bench-tick [ticks] [segments] [tick rate]
+
+#include <raylib.h>
+#include <raymath.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "bench_common.h"
+#include "../src/ship/ship.h"
+#include "bench_track.h"
+
+#define DEFAULT_TICKS 2000000
+#define DEFAULT_SEGMENTS 100
+#define DEFAULT_TICK_RATE 60.0f
+
+// Input for one tick of a scripted lap: steer for a waypoint a little way ahead with some weave,
+// lift off and brake for half a second every ten seconds
+static ShipInput ScriptedInput(const Ship *ship, const Vector3 *waypoints, int waypointCount, float time)
+{
+    ShipInput input = { 0 };
+
+    int target = (ship->segment < 0)? 1 : (ship->segment + 4) % waypointCount;
+    Vector3 toTarget = Vector3Subtract(waypoints[target], ship->position);
+    float targetYaw = atan2f(toTarget.x, toTarget.z) * RAD2DEG;
+    float error = Wrap(targetYaw - ship->yaw, -180.0f, 180.0f);
+
+    input.steer = Clamp(error / 10.0f + 0.3f * sinf(time * 0.78f), -1.0f, 1.0f);
+    input.accelerate = fmodf(time, 10.0f) < 9.5f;
+    input.brake = !input.accelerate;
+    return input;
+}
+
+static void ResetShip(Ship *ship, const Vector3 *waypoints)
+{
+    InitShip(ship, (ModelLods){ 0 }, (Texture2D){ 0 });
+    ship->position = waypoints[0];
+    ship->position.y += 2.0f;
+}
+
+static int CompareU32(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+int main(int argc, char **argv)
+{
+    int ticks = (argc > 1)? atoi(argv[1]) : DEFAULT_TICKS;
+    int segments = (argc > 2)? atoi(argv[2]) : DEFAULT_SEGMENTS;
+    if (ticks <= 0) ticks = DEFAULT_TICKS;
+    float tickRate = (argc > 3)? (float)atof(argv[3]) : DEFAULT_TICK_RATE;
+    if (segments <= 0) segments = DEFAULT_SEGMENTS;
+    if (tickRate <= 0.0f) tickRate = DEFAULT_TICK_RATE;
+    float dt = 1.0f / tickRate;
+
+    BenchTrack track = LoadBenchTrack(segments);
+    const Vector3 *waypoints = track.waypoints;
+    const TrackSurface *surface = &track.surface;
+
+    Ship ship;
+
+    // Record the script once so the timed runs only replay plain inputs
+    ShipInput *script = (ShipInput *)malloc(ticks * sizeof(ShipInput));
+    ResetShip(&ship, waypoints);
+    for (int i = 0; i < ticks; i++)
+    {
+        script[i] = ScriptedInput(&ship, waypoints, track.waypointCount, i * dt);
+        UpdateShip(&ship, script[i], surface, dt);
+    }
+
+    // Throughput: no per-tick timing overhead
+    ResetShip(&ship, waypoints);
+    uint64_t t0 = BenchNowNs();
+    for (int i = 0; i < ticks; i++) UpdateShip(&ship, script[i], surface, dt);
+    uint64_t totalNs = BenchNowNs() - t0;
+    Vector3 finalPosition = ship.position;
+
+    // Latency: time every tick individually
+    uint32_t *samples = (uint32_t *)malloc(ticks * sizeof(uint32_t));
+    int offTrack = 0;
+    ResetShip(&ship, waypoints);
+    for (int i = 0; i < ticks; i++)
+    {
+        uint64_t start = BenchNowNs();
+        UpdateShip(&ship, script[i], surface, dt);
+        samples[i] = (uint32_t)(BenchNowNs() - start);
+        if (!QueryTrackSurface(surface, ship.position, ship.segment).hit) offTrack++;
+    }
+
+    // Cost of the timer itself, to read the percentiles against
+    uint64_t overhead = UINT64_MAX;
+    for (int i = 0; i < 1000; i++)
+    {
+        uint64_t a = BenchNowNs();
+        uint64_t b = BenchNowNs();
+        if (b - a < overhead) overhead = b - a;
+    }
+
+    qsort(samples, ticks, sizeof(uint32_t), CompareU32);
+
+    printf("ticks:        %d at %.0f Hz (%d segments)\n", ticks, tickRate, segments);
+    printf("throughput:   %.0f ticks/s (%.1f ns/tick)\n", ticks / (totalNs / 1e9), (double)totalNs / ticks);
+    printf("latency (ns): p50 %u  p90 %u  p99 %u  p99.9 %u  max %u  (timer overhead %llu)\n",
+           samples[ticks / 2], samples[(int)(ticks * 0.9)], samples[(int)(ticks * 0.99)],
+           samples[(int)(ticks * 0.999)], samples[ticks - 1], (unsigned long long)overhead);
+    printf("final state:  pos (%.3f, %.3f, %.3f) speed %.3f, off track %.1f%% of ticks\n",
+           finalPosition.x, finalPosition.y, finalPosition.z, ship.speed, 100.0 * offTrack / ticks);
+
+    free(samples);
+    free(script);
+    UnloadBenchTrack(&track);
+
+    return 0;
+}
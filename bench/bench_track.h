@@ -0,0 +1,38 @@
+#ifndef BENCH_TRACK_H
+#define BENCH_TRACK_H
+
+// The procedural test oval (GenTrackRibbon()), generated and indexed without a GPU. main()
+// races the stadium circuit; this one stays because its length can be varied.
+
+#include <raylib.h>
+#include "../src/track/track.h"
+
+typedef struct BenchTrack {
+    TrackRibbon ribbon;
+    MemArena arena;         // Surface and waypoints
+    Vector3 *waypoints;
+    int waypointCount;
+    TrackSurface surface;
+} BenchTrack;
+
+static inline BenchTrack LoadBenchTrack(int segments)
+{
+    BenchTrack track = { 0 };
+    track.ribbon = GenTrackRibbon(500.0f, 200.0f, segments, 50.0f, 10.0f);
+    InitArena(&track.arena, GetTrackSurfaceSize(&track.ribbon) + GetArenaAllocSize(segments * sizeof(Vector3)));
+
+    track.waypointCount = segments;
+    track.waypoints = (Vector3 *)ArenaAlloc(&track.arena, segments * sizeof(Vector3));
+    for (int i = 0; i < segments; i++) track.waypoints[i] = track.ribbon.frames[i].position;
+
+    BuildTrackSurface(&track.surface, &track.ribbon, &track.arena);
+    return track;
+}
+
+static inline void UnloadBenchTrack(BenchTrack *track)
+{
+    UnloadTrackRibbon(&track->ribbon);
+    UnloadArena(&track->arena);
+}
+
+#endif // BENCH_TRACK_H
@@ -0,0 +1,127 @@
+// Flies the chase camera around generated tracks and counts the chunks CullTrackChunks()
+// draws and culls each frame, checking every culled chunk really is out of view.
+//
+// Usage: bench-track-cull [frames per lap]
+
+#include <raylib.h>
+#include <raymath.h>
+#include <rlgl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "bench_common.h"
+#include "../src/track/track.h"
+
+#define DEFAULT_FRAMES 2000
+#define SCREEN_ASPECT (640.0f / 480.0f)
+#define CAMERA_DISTANCE 30.0f   // Same chase camera as main()
+#define CAMERA_HEIGHT 8.0f
+
+// True if any vertex of the chunk lands inside the clip volume
+static bool IsAnyVertexVisible(const Track *track, const TrackChunk *chunk, Matrix viewProjection)
+{
+    Matrix m = viewProjection;
+    for (int i = 0; i < chunk->vertexCount; i++)
+    {
+        Vector3 p = track->vertices[chunk->firstVertex + i].position;
+        float x = p.x, y = p.y, z = p.z;
+        float cx = m.m0 * x + m.m4 * y + m.m8 * z + m.m12;
+        float cy = m.m1 * x + m.m5 * y + m.m9 * z + m.m13;
+        float cz = m.m2 * x + m.m6 * y + m.m10 * z + m.m14;
+        float cw = m.m3 * x + m.m7 * y + m.m11 * z + m.m15;
+        if ((fabsf(cx) <= cw) && (fabsf(cy) <= cw) && (fabsf(cz) <= cw)) return true;
+    }
+    return false;
+}
+
+static bool RunCase(int segments, int frames)
+{
+    Track track = { 0 };
+    TrackRibbon ribbon = GenTrackRibbon(500.0f, 200.0f, segments, 50.0f, 10.0f);
+    BuildTrack(&track, &ribbon, TRACK_DEFAULT_PRIMITIVE);
+    UnloadTrackRibbon(&ribbon);
+
+    Camera camera = { 0 };
+    camera.up = (Vector3){ 0.0f, 1.0f, 0.0f };
+    camera.fovy = 45.0f;
+    camera.projection = CAMERA_PERSPECTIVE;
+
+    long drawnTotal = 0, verticesTotal = 0, trackVertices = 0;
+    int drawnMin = track.chunkCount, drawnMax = 0, failures = 0, segment = -1;
+    uint64_t cullNs = 0;
+
+    trackVertices = track.vertexCount;
+    bool *isDrawn = (bool *)calloc((unsigned)track.chunkCount, sizeof(bool));
+
+    for (int f = 0; f < frames; f++)
+    {
+        // Ship on the centreline, camera behind and above it looking at it
+        float t = (float)f / frames * track.waypointCount;
+        int wp = (int)t;
+        Vector3 a = track.waypoints[wp % track.waypointCount];
+        Vector3 b = track.waypoints[(wp + 1) % track.waypointCount];
+        Vector3 ship = Vector3Lerp(a, b, t - wp);
+        ship.y += 2.0f;
+
+        Vector3 forward = Vector3Normalize((Vector3){ b.x - a.x, 0.0f, b.z - a.z });
+        camera.target = ship;
+        camera.position = (Vector3){ ship.x - forward.x * CAMERA_DISTANCE, ship.y + CAMERA_HEIGHT, ship.z - forward.z * CAMERA_DISTANCE };
+
+        Frustum frustum = GetCameraFrustum(camera, SCREEN_ASPECT, RL_CULL_DISTANCE_NEAR, RL_CULL_DISTANCE_FAR);
+        uint64_t t0 = BenchNowNs();
+        int drawn = CullTrackChunks(&track, &frustum, camera.position);
+        cullNs += BenchNowNs() - t0;
+
+        drawnTotal += drawn;
+        if (drawn < drawnMin) drawnMin = drawn;
+        if (drawn > drawnMax) drawnMax = drawn;
+
+        // The chunk under the ship must be drawn, and the list must run near to far
+        TrackSurfaceHit hit = QueryTrackSurface(&track.surface, ship, segment);
+        if (hit.hit) segment = hit.segment;
+
+        bool shipChunkDrawn = false;
+        for (int c = 0; c < track.chunkCount; c++) isDrawn[c] = false;
+        for (int i = 0; i < drawn; i++)
+        {
+            int c = track.visibleChunks[i];
+            isDrawn[c] = true;
+            verticesTotal += track.chunks[c].vertexCount;
+            if (c == segment / TRACK_CHUNK_SEGMENTS) shipChunkDrawn = true;
+            if ((i > 0) && (track.chunks[track.visibleChunks[i - 1]].viewDistance > track.chunks[c].viewDistance)) failures++;
+        }
+        if (!shipChunkDrawn) failures++;
+
+        // No culled chunk may have a vertex on screen
+        Matrix viewProjection = MatrixMultiply(MatrixLookAt(camera.position, camera.target, camera.up),
+                                               MatrixPerspective(camera.fovy * DEG2RAD, SCREEN_ASPECT, RL_CULL_DISTANCE_NEAR, RL_CULL_DISTANCE_FAR));
+        for (int c = 0; c < track.chunkCount; c++)
+        {
+            if (!isDrawn[c] && IsAnyVertexVisible(&track, &track.chunks[c], viewProjection)) failures++;
+        }
+    }
+
+    printf("%8d %7d %8.1f %5d %5d %8.1f %11.1f%% %9.1f %7s\n", segments, track.chunkCount, (double)drawnTotal / frames,
+           drawnMin, drawnMax, track.chunkCount - (double)drawnTotal / frames, 100.0 * verticesTotal / ((double)trackVertices * frames),
+           (double)cullNs / frames, (failures == 0)? "ok" : "FAIL");
+
+    free(isDrawn);
+    UnloadTrack(&track);
+    return failures == 0;
+}
+
+int main(int argc, char **argv)
+{
+    int frames = (argc > 1)? atoi(argv[1]) : DEFAULT_FRAMES;
+    if (frames <= 0) frames = DEFAULT_FRAMES;
+
+    printf("%8s %7s %8s %5s %5s %8s %12s %9s %7s\n", "segments", "chunks", "drawn", "min", "max", "culled",
+           "vertices", "cull(ns)", "check");
+
+    // 40000 segments is past what a single mesh with 16-bit indices could hold
+    bool ok = true;
+    int cases[] = { 100, 1000, 10000, 40000 };
+    for (int i = 0; i < 4; i++) ok &= RunCase(cases[i], frames);
+
+    return ok? 0 : 1;
+}
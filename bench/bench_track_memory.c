@@ -0,0 +1,122 @@
+// Heap traffic of loading and unloading a track: generating the ribbon, building the track from
+// it and releasing the ribbon, then UnloadTrack(). Every malloc/calloc/realloc/free goes through
+// the linker wrappers below (-Wl,--wrap=...), which count calls and the bytes the C library
+// actually reserved. Checks the loaded track holds one allocation, its arena was sized exactly,
+// and nothing is left after unloading.
+//
+// Usage: bench-track-memory
+
+#include <raylib.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <malloc.h>
+#include "bench_common.h"
+#include "../src/track/track.h"
+
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t count, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+void __real_free(void *ptr);
+
+static long heapCalls = 0;      // Successful allocations, reallocs included
+static long heapLive = 0;       // Bytes reserved right now
+static long heapPeak = 0;
+static long heapBlocks = 0;     // Blocks alive right now
+
+static void CountAlloc(void *ptr)
+{
+    if (ptr == NULL) return;
+    heapCalls++;
+    heapBlocks++;
+    heapLive += (long)malloc_usable_size(ptr);
+    if (heapLive > heapPeak) heapPeak = heapLive;
+}
+
+static void CountFree(void *ptr)
+{
+    if (ptr == NULL) return;
+    heapBlocks--;
+    heapLive -= (long)malloc_usable_size(ptr);
+}
+
+void *__wrap_malloc(size_t size)
+{
+    void *ptr = __real_malloc(size);
+    CountAlloc(ptr);
+    return ptr;
+}
+
+void *__wrap_calloc(size_t count, size_t size)
+{
+    void *ptr = __real_calloc(count, size);
+    CountAlloc(ptr);
+    return ptr;
+}
+
+void *__wrap_realloc(void *ptr, size_t size)
+{
+    CountFree(ptr);
+    void *moved = __real_realloc(ptr, size);
+    CountAlloc(moved);
+    return moved;
+}
+
+void __wrap_free(void *ptr)
+{
+    CountFree(ptr);
+    __real_free(ptr);
+}
+
+static void ResetHeapCounters(void)
+{
+    heapCalls = 0;
+    heapPeak = heapLive;
+}
+
+static bool RunCase(int segments, TrackPrimitive primitive)
+{
+    long baseLive = heapLive, baseBlocks = heapBlocks;
+    ResetHeapCounters();
+
+    uint64_t t0 = BenchNowNs();
+    Track track = { 0 };
+    TrackRibbon ribbon = GenTrackRibbon(500.0f, 200.0f, segments, 50.0f, 10.0f);
+    bool built = BuildTrack(&track, &ribbon, primitive);
+    UnloadTrackRibbon(&ribbon);
+    uint64_t loadNs = BenchNowNs() - t0;
+
+    long loadCalls = heapCalls, loadPeak = heapPeak - baseLive, resident = heapLive - baseLive, blocks = heapBlocks - baseBlocks;
+    size_t used = track.arena.used, capacity = track.arena.capacity;
+    int arenaAllocations = track.arena.allocations;
+
+    t0 = BenchNowNs();
+    UnloadTrack(&track);
+    uint64_t unloadNs = BenchNowNs() - t0;
+
+    long leaked = heapLive - baseLive;
+    bool ok = built && (blocks == 1) && (used == capacity) && (leaked == 0) && (heapBlocks == baseBlocks);
+
+    printf("%8d %-9s %7ld %10ld %10ld %7d %10zu %9.1f %10.1f %6s\n", segments, (primitive == TRACK_STRIPS)? "strips" : "triangles",
+           loadCalls, loadPeak, resident, arenaAllocations, used, loadNs / 1e3, unloadNs / 1e3, ok? "ok" : "FAIL");
+
+    return ok;
+}
+
+int main(void)
+{
+    bool ok = true;
+
+    SetTraceLogLevel(LOG_WARNING);
+
+    printf("%8s %-9s %7s %10s %10s %7s %10s %9s %10s %6s\n", "segments", "primitive", "allocs", "peak (B)", "resident",
+           "slices", "arena (B)", "load (us)", "unload (us)", "check");
+
+    int cases[] = { 100, 1000, 10000 };
+    for (int i = 0; i < 3; i++)
+    {
+        ok &= RunCase(cases[i], TRACK_TRIANGLES);
+        ok &= RunCase(cases[i], TRACK_STRIPS);
+    }
+
+    return ok? 0 : 1;
+}
@@ -0,0 +1,228 @@
+// Compares track chunks built as indexed triangle lists against triangle strips: checks
+// both produce the ribbon's triangles with the same winding, then reports vertex/index
+// counts and a model of the per-vertex submission cost.
+//
+// Submission is modelled on what GLdc does for every vertex it sends to the PVR:
+// fetch, transform, perspective divide and write a 32-byte PVR vertex. Lists are expanded
+// into three submitted vertices per triangle; strips submit each vertex once.
+//
+// Usage: bench-track-strips [frames]
+
+#include <raylib.h>
+#include <raymath.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "bench_common.h"
+#include "../src/track/track.h"
+
+#define DEFAULT_FRAMES 2000
+
+// Layout of a PVR polygon vertex
+typedef struct PvrVertex {
+    uint32_t flags;         // End-of-strip marks the last vertex of each strip
+    float x, y, z;
+    float u, v;
+    uint32_t argb;
+    uint32_t oargb;
+} PvrVertex;
+
+#define PVR_CMD_VERTEX 0xe0000000u
+#define PVR_CMD_VERTEX_EOL 0xf0000000u
+
+// One draw's worth of track vertices: a strip, or a list when 'indices' is set
+typedef struct VertexRange {
+    const TrackVertex *vertices;
+    int vertexCount;
+    const unsigned short *indices;
+    int indexCount;
+} VertexRange;
+
+static VertexRange GetChunkRange(const Track *track, int c)
+{
+    const TrackChunk *chunk = &track->chunks[c];
+    VertexRange range = { &track->vertices[chunk->firstVertex], chunk->vertexCount, NULL, chunk->indexCount };
+    if (track->primitive == TRACK_TRIANGLES) range.indices = &track->indices[chunk->firstIndex];
+    return range;
+}
+
+static inline void SubmitVertex(PvrVertex *out, const VertexRange *range, int v, Matrix m, bool last)
+{
+    const TrackVertex *vertex = &range->vertices[v];
+    float x = vertex->position.x, y = vertex->position.y, z = vertex->position.z;
+    float cw = m.m3 * x + m.m7 * y + m.m11 * z + m.m15;
+    float invW = 1.0f / cw;
+
+    out->flags = last? PVR_CMD_VERTEX_EOL : PVR_CMD_VERTEX;
+    out->x = (m.m0 * x + m.m4 * y + m.m8 * z + m.m12) * invW;
+    out->y = (m.m1 * x + m.m5 * y + m.m9 * z + m.m13) * invW;
+    out->z = invW;
+    out->u = vertex->texcoord.x;
+    out->v = vertex->texcoord.y;
+    out->argb = 0xff505050u;
+    out->oargb = 0;
+}
+
+// Returns the number of vertices written
+static int SubmitChunk(PvrVertex *out, const VertexRange *range, Matrix m)
+{
+    if (range->indices != NULL)
+    {
+        for (int i = 0; i < range->indexCount; i++) SubmitVertex(&out[i], range, range->indices[i], m, (i % 3) == 2);
+        return range->indexCount;
+    }
+
+    for (int i = 0; i < range->vertexCount; i++) SubmitVertex(&out[i], range, i, m, i == range->vertexCount - 1);
+    return range->vertexCount;
+}
+
+static int GetTriangleCount(const VertexRange *range)
+{
+    return (range->indices != NULL)? range->indexCount / 3 : range->vertexCount - 2;
+}
+
+static bool SameVertex(Vector3 a, Vector3 b)
+{
+    return (a.x == b.x) && (a.y == b.y) && (a.z == b.z);
+}
+
+// Triangle 'k' as drawn from either primitive, in winding order
+static void GetTriangle(const VertexRange *range, int k, Vector3 *out)
+{
+    if (range->indices != NULL)
+    {
+        for (int j = 0; j < 3; j++) out[j] = range->vertices[range->indices[k * 3 + j]].position;
+    }
+    else
+    {
+        out[0] = range->vertices[(k % 2 == 0)? k : k + 1].position;
+        out[1] = range->vertices[(k % 2 == 0)? k + 1 : k].position;
+        out[2] = range->vertices[k + 2].position;
+    }
+}
+
+// Every non-degenerate triangle of the range must be the next triangle of the ribbon runs,
+// (c0, c2, c1) then (c1, c2, c3) per segment, with the same winding
+static bool CheckTriangles(const VertexRange *range, const TrackRibbon *ribbon, const int *runFirst, const int *runSegments, int runCount)
+{
+    const Vector3 *v = (const Vector3 *)ribbon->vertices;
+    int run = 0, segment = 0, half = 0;
+
+    int triangleCount = GetTriangleCount(range);
+    for (int k = 0; k < triangleCount; k++)
+    {
+        Vector3 tri[3];
+        GetTriangle(range, k, tri);
+        if (SameVertex(tri[0], tri[1]) || SameVertex(tri[1], tri[2]) || SameVertex(tri[0], tri[2])) continue;
+
+        if (run >= runCount) return false;
+
+        int row = (runFirst[run] + segment) % ribbon->rowCount;
+        int next = (row + 1) % ribbon->rowCount;
+        Vector3 c0 = v[row * 2], c1 = v[row * 2 + 1], c2 = v[next * 2], c3 = v[next * 2 + 1];
+        Vector3 expected[3] = { c0, c2, c1 };
+        if (half == 1) { expected[0] = c1; expected[1] = c2; expected[2] = c3; }
+
+        bool match = false;
+        for (int r = 0; r < 3; r++)
+        {
+            if (SameVertex(tri[0], expected[r]) && SameVertex(tri[1], expected[(r + 1) % 3]) && SameVertex(tri[2], expected[(r + 2) % 3])) match = true;
+        }
+        if (!match) return false;
+
+        if (++half == 2)
+        {
+            half = 0;
+            if (++segment == runSegments[run]) { segment = 0; run++; }
+        }
+    }
+
+    return run == runCount;
+}
+
+static bool CheckTrack(const Track *track, const TrackRibbon *ribbon)
+{
+    for (int c = 0; c < track->chunkCount; c++)
+    {
+        int first = c * TRACK_CHUNK_SEGMENTS;
+        int count = (ribbon->rowCount - first < TRACK_CHUNK_SEGMENTS)? ribbon->rowCount - first : TRACK_CHUNK_SEGMENTS;
+        VertexRange range = GetChunkRange(track, c);
+        if (!CheckTriangles(&range, ribbon, &first, &count, 1)) return false;
+    }
+    return true;
+}
+
+static double TimeSubmission(const Track *track, PvrVertex *buffer, Matrix mvp, int frames, long *submitted)
+{
+    uint64_t t0 = BenchNowNs();
+    for (int f = 0; f < frames; f++)
+    {
+        long count = 0;
+        for (int c = 0; c < track->chunkCount; c++)
+        {
+            VertexRange range = GetChunkRange(track, c);
+            count += SubmitChunk(buffer, &range, mvp);
+        }
+        *submitted = count;
+        benchSink = buffer[0].x;
+    }
+    return (double)(BenchNowNs() - t0) / frames;
+}
+
+static bool RunCase(int segments, int frames)
+{
+    TrackRibbon ribbon = GenTrackRibbon(500.0f, 200.0f, segments, 50.0f, 10.0f);
+
+    Track list = { 0 }, strips = { 0 };
+    BuildTrack(&list, &ribbon, TRACK_TRIANGLES);
+    BuildTrack(&strips, &ribbon, TRACK_STRIPS);
+
+    bool ok = CheckTrack(&list, &ribbon) && CheckTrack(&strips, &ribbon);
+
+    // Several strips in one draw, one of them across the loop's seam
+    int runFirst[3] = { segments - 5, 3, segments / 2 };
+    int runSegments[3] = { 10, 1, 7 };
+    int joinedCount = GetTrackStripVertexCount(runSegments, 3);
+    TrackVertex *joined = (TrackVertex *)malloc(joinedCount * sizeof(TrackVertex));
+    VertexRange joinedRange = { joined, GenTrackStrips(joined, &ribbon, runFirst, runSegments, 3), NULL, 0 };
+    ok &= (joinedRange.vertexCount == joinedCount);
+    ok &= CheckTriangles(&joinedRange, &ribbon, runFirst, runSegments, 3);
+    free(joined);
+
+    long listVertices = list.vertexCount, listIndices = list.indexCount;
+
+    Camera camera = { { 0.0f, 400.0f, -900.0f }, { 0.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, 45.0f, CAMERA_PERSPECTIVE };
+    Matrix mvp = MatrixMultiply(MatrixLookAt(camera.position, camera.target, camera.up),
+                                MatrixPerspective(camera.fovy * DEG2RAD, 640.0f / 480.0f, 0.01f, 1000.0f));
+
+    PvrVertex *buffer = (PvrVertex *)malloc(TRACK_CHUNK_SEGMENTS * 6 * sizeof(PvrVertex));
+    long listSubmitted = 0, stripSubmitted = 0;
+    double listNs = TimeSubmission(&list, buffer, mvp, frames, &listSubmitted);
+    double stripNs = TimeSubmission(&strips, buffer, mvp, frames, &stripSubmitted);
+
+    printf("%8d %10ld %8ld %10ld %10ld %11.1f %11.1f %7.2fx %6s\n", segments, listVertices, listIndices, listSubmitted,
+           stripSubmitted, listNs / 1e3, stripNs / 1e3, listNs / stripNs, ok? "ok" : "FAIL");
+
+    free(buffer);
+    UnloadTrack(&list);
+    UnloadTrack(&strips);
+    UnloadTrackRibbon(&ribbon);
+
+    return ok;
+}
+
+int main(int argc, char **argv)
+{
+    int frames = (argc > 1)? atoi(argv[1]) : DEFAULT_FRAMES;
+    if (frames <= 0) frames = DEFAULT_FRAMES;
+
+    printf("%8s %10s %8s %10s %10s %11s %11s %8s %6s\n", "segments", "list verts", "indices", "list subm",
+           "strip subm", "list (us)", "strip (us)", "speedup", "check");
+
+    bool ok = true;
+    int cases[] = { 100, 1000, 10000 };
+    for (int i = 0; i < 3; i++) ok &= RunCase(cases[i], (cases[i] > 1000)? frames / 10 : frames);
+
+    return ok? 0 : 1;
+}
@@ -0,0 +1,125 @@
+// Compares QueryTrackSurface() against the brute-force GetTrackSurfaceInfo() raycast
+// on generated tracks of increasing segment count.
+
+#include <raylib.h>
+#include <raymath.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "bench_common.h"
+#include "../src/track/track.h"
+
+#define TRACK_RADIUS 500.0f
+#define TRACK_WIDTH 200.0f
+#define SHIP_STEP 5.0f          // Distance travelled per query, the ship's max speed per frame
+#define FAST_QUERIES 200000
+#define BRUTE_QUERIES 2000
+
+// Points along the centreline, weaving across the ribbon like a ship would
+static Vector3 *MakeQueryPath(const TrackFrame *frames, int frameCount, int count)
+{
+    Vector3 *path = (Vector3 *)malloc(count * sizeof(Vector3));
+    int wp = 0;
+    float along = 0.0f;
+
+    for (int i = 0; i < count; i++)
+    {
+        Vector3 a = frames[wp].position;
+        Vector3 b = frames[(wp + 1) % frameCount].position;
+        Vector3 dir = Vector3Subtract(b, a);
+        float length = Vector3Length(dir);
+
+        while (along > length)
+        {
+            along -= length;
+            wp = (wp + 1) % frameCount;
+            a = frames[wp].position;
+            b = frames[(wp + 1) % frameCount].position;
+            dir = Vector3Subtract(b, a);
+            length = Vector3Length(dir);
+        }
+
+        Vector3 p = Vector3Add(a, Vector3Scale(dir, along / length));
+        Vector3 side = Vector3Normalize((Vector3){ -dir.z, 0.0f, dir.x });
+        float offset = 0.4f * TRACK_WIDTH * sinf(i * 0.01f);
+
+        path[i] = Vector3Add(p, Vector3Scale(side, offset));
+        path[i].y += 2.0f;
+        along += SHIP_STEP;
+    }
+
+    return path;
+}
+
+static void RunCase(int segments)
+{
+    TrackRibbon ribbon = GenTrackRibbon(TRACK_RADIUS, TRACK_WIDTH, segments, 50.0f, 10.0f);
+
+    uint64_t t0 = BenchNowNs();
+    MemArena arena = { 0 };
+    TrackSurface surface = { 0 };
+    InitArena(&arena, GetTrackSurfaceSize(&ribbon));
+    BuildTrackSurface(&surface, &ribbon, &arena);
+    uint64_t buildNs = BenchNowNs() - t0;
+
+    Vector3 *path = MakeQueryPath(ribbon.frames, ribbon.rowCount, FAST_QUERIES);
+
+    // Indexed query, hinted with the previous result like UpdateShip does
+    int segment = -1;
+    int misses = 0;
+    t0 = BenchNowNs();
+    for (int i = 0; i < FAST_QUERIES; i++)
+    {
+        TrackSurfaceHit hit = QueryTrackSurface(&surface, path[i], segment);
+        if (hit.hit) segment = hit.segment;
+        else misses++;
+        benchSink = hit.height;
+    }
+    double fastNs = (double)(BenchNowNs() - t0) / FAST_QUERIES;
+
+    // Unhinted queries always go through the grid
+    t0 = BenchNowNs();
+    for (int i = 0; i < FAST_QUERIES; i++) benchSink = QueryTrackSurface(&surface, path[i], -1).height;
+    double gridNs = (double)(BenchNowNs() - t0) / FAST_QUERIES;
+
+    // Reference path, on a subset of the same points
+    int stride = FAST_QUERIES / BRUTE_QUERIES;
+    t0 = BenchNowNs();
+    for (int i = 0; i < BRUTE_QUERIES; i++)
+    {
+        float height;
+        GetTrackSurfaceInfo(path[i * stride], &ribbon, &height);
+        benchSink = height;
+    }
+    double bruteNs = (double)(BenchNowNs() - t0) / BRUTE_QUERIES;
+
+    // Both paths must agree on the height of every sampled point (normals may differ on shared edges)
+    float maxError = 0.0f;
+    int disagreements = 0;
+    for (int i = 0; i < BRUTE_QUERIES; i++)
+    {
+        float height;
+        GetTrackSurfaceInfo(path[i * stride], &ribbon, &height);
+        TrackSurfaceHit hit = QueryTrackSurface(&surface, path[i * stride], -1);
+        if (!hit.hit) { disagreements++; continue; }
+        maxError = fmaxf(maxError, fabsf(hit.height - height));
+    }
+
+    printf("%8d %10.2f %10.1f %10.1f %12.1f %9.1fx %8d %10.2e %6d\n", segments, buildNs / 1e6, fastNs, gridNs, bruteNs,
+           bruteNs / fastNs, surface.cellStart[surface.gridWidth * surface.gridHeight], maxError, disagreements + misses);
+
+    free(path);
+    UnloadArena(&arena);
+    UnloadTrackRibbon(&ribbon);
+}
+
+int main(void)
+{
+    printf("%8s %10s %10s %10s %12s %10s %8s %10s %6s\n", "segments", "build(ms)", "walk(ns)", "grid(ns)", "raycast(ns)",
+           "speedup", "entries", "maxerr(h)", "miss");
+
+    int cases[] = { 100, 1000, 10000 };
+    for (int i = 0; i < (int)(sizeof(cases) / sizeof(cases[0])); i++) RunCase(cases[i]);
+
+    return 0;
+}
@@ -0,0 +1,208 @@
+// Baked tracks against procedural ones: generates each track as the game would (the stadium
+// spline circuit, and the test oval at a few lengths), bakes it to .hsk as tools/trackbake
+// does, and times loading it both ways, generation and BuildTrack() against LoadTrackBinary()
+// reading the file. Reports the median of RUNS loads each, the file size and the speedup.
+//
+// Checks that the baked track is the generated one: same counts and grid, byte-identical
+// arrays, the same surface hash (so replays recorded on either match) and the same answer from
+// QueryTrackSurface() over a grid of points. Also that loading takes one arena allocation,
+// that baking twice gives the same bytes, and that truncated or foreign files are refused.
+//
+// Usage: bench-trackbin
+
+#include <raylib.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bench_common.h"
+#include "../src/track/track.h"
+#include "../src/track/trackbin.h"
+#include "../src/track/circuit.h"
+#include "../src/replay/replay.h"
+#include "../tools/trackconv.h"
+
+#define RUNS 25
+#define QUERY_GRID 64               // Queries per axis over the track's bounds
+#define BAKED_FILE "bench_trackbin.hsk"
+
+typedef struct TrackCase {
+    const char *name;
+    int segments;                   // Oval rows, 0 for the stadium circuit
+} TrackCase;
+
+static bool GenCase(const TrackCase *test, Track *track)
+{
+    if (test->segments == 0) return GenSplineTrack(track, stadiumCircuit, STADIUM_CIRCUIT_POINTS, stadiumTessellation);
+
+    *track = (Track){ 0 };
+    TrackRibbon ribbon = GenTrackRibbon(500.0f, 200.0f, test->segments, 50.0f, 10.0f);
+    bool built = BuildTrack(track, &ribbon, TRACK_DEFAULT_PRIMITIVE);
+    UnloadTrackRibbon(&ribbon);
+    return built;
+}
+
+static bool WriteFile(const char *fileName, const unsigned char *data, int size)
+{
+    FILE *file = fopen(fileName, "wb");
+    if (file == NULL) return false;
+    bool ok = (fwrite(data, 1, size, file) == (size_t)size);
+    fclose(file);
+    return ok;
+}
+
+static int CompareU64(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+static bool SameBytes(const void *a, const void *b, size_t size)
+{
+    return (size == 0) || (memcmp(a, b, size) == 0);
+}
+
+static bool SameTrack(const Track *a, const Track *b)
+{
+    const TrackSurface *sa = &a->surface, *sb = &b->surface;
+    int cellCount = sa->gridWidth * sa->gridHeight;
+
+    bool ok = (a->primitive == b->primitive) && (a->chunkCount == b->chunkCount) && (a->vertexCount == b->vertexCount) &&
+              (a->indexCount == b->indexCount) && (a->waypointCount == b->waypointCount) && (sa->segmentCount == sb->segmentCount) &&
+              (sa->gridWidth == sb->gridWidth) && (sa->gridHeight == sb->gridHeight) && (sa->cellSize == sb->cellSize) &&
+              (sa->gridOrigin.x == sb->gridOrigin.x) && (sa->gridOrigin.y == sb->gridOrigin.y);
+    if (!ok) return false;
+
+    return SameBytes(a->chunks, b->chunks, a->chunkCount * sizeof(TrackChunk)) &&
+           SameBytes(a->vertices, b->vertices, a->vertexCount * sizeof(TrackVertex)) &&
+           SameBytes(a->indices, b->indices, a->indexCount * sizeof(unsigned short)) &&
+           SameBytes(a->waypoints, b->waypoints, a->waypointCount * sizeof(Vector3)) &&
+           SameBytes(a->frames, b->frames, a->waypointCount * sizeof(TrackFrame)) &&
+           SameBytes(sa->segments, sb->segments, sa->segmentCount * sizeof(TrackSurfaceSegment)) &&
+           SameBytes(sa->cellStart, sb->cellStart, (cellCount + 1) * sizeof(int)) &&
+           SameBytes(sa->cellSegments, sb->cellSegments, sa->cellStart[cellCount] * sizeof(int)) &&
+           (GetTrackSurfaceHash(sa) == GetTrackSurfaceHash(sb));
+}
+
+// Surface queries over the track's bounds, cold (no hint) and walking from the last hit
+static bool SameQueries(const Track *a, const Track *b)
+{
+    const TrackSurface *surface = &a->surface;
+    float width = surface->gridWidth * surface->cellSize, height = surface->gridHeight * surface->cellSize;
+    int hintA = -1, hintB = -1;
+
+    for (int z = 0; z < QUERY_GRID; z++)
+    {
+        for (int x = 0; x < QUERY_GRID; x++)
+        {
+            Vector3 p = { surface->gridOrigin.x + width * (x + 0.5f) / QUERY_GRID, 20.0f, surface->gridOrigin.y + height * (z + 0.5f) / QUERY_GRID };
+            TrackSurfaceHit ha = QueryTrackSurface(&a->surface, p, hintA);
+            TrackSurfaceHit hb = QueryTrackSurface(&b->surface, p, hintB);
+            if ((ha.hit != hb.hit) || (ha.segment != hb.segment) || (ha.height != hb.height)) return false;
+            if (ha.hit)
+            {
+                hintA = ha.segment;
+                hintB = hb.segment;
+            }
+        }
+    }
+    return true;
+}
+
+// A damaged copy of the file must be refused, not mapped
+static bool RefusesDamaged(const unsigned char *data, int size)
+{
+    unsigned char *copy = (unsigned char *)malloc(size);
+    Track track;
+    bool ok = true;
+
+    memcpy(copy, data, size);
+    ok &= WriteFile(BAKED_FILE, copy, size / 2) && !LoadTrackBinary(BAKED_FILE, &track);    // Truncated
+
+    copy[0] ^= 0xff;
+    ok &= WriteFile(BAKED_FILE, copy, size) && !LoadTrackBinary(BAKED_FILE, &track);        // Foreign
+
+    memcpy(copy, data, size);
+    TrackBinHeader *header = (TrackBinHeader *)copy;
+    header->vertices.count += 1000000;
+    ok &= WriteFile(BAKED_FILE, copy, size) && !LoadTrackBinary(BAKED_FILE, &track);        // Array past the end
+
+    free(copy);
+    return ok;
+}
+
+static bool RunCase(const TrackCase *test)
+{
+    Track generated, again;
+    if (!GenCase(test, &generated) || !GenCase(test, &again)) return false;
+
+    unsigned char *data = NULL, *dataAgain = NULL;
+    int size = 0, sizeAgain = 0;
+    bool ok = BuildTrackBin(&generated, &data, &size) && BuildTrackBin(&again, &dataAgain, &sizeAgain);
+    ok = ok && (size == sizeAgain) && (memcmp(data, dataAgain, size) == 0) && WriteFile(BAKED_FILE, data, size);
+    UnloadArena(&again.arena);
+    free(dataAgain);
+    if (!ok)
+    {
+        printf("%-12s bake failed\n", test->name);
+        free(data);
+        UnloadArena(&generated.arena);
+        return false;
+    }
+
+    // Both ways, RUNS times each
+    uint64_t procedural[RUNS], baked[RUNS];
+    Track loaded = { 0 };
+    for (int r = 0; r < RUNS; r++)
+    {
+        Track track;
+        uint64_t t0 = BenchNowNs();
+        ok &= GenCase(test, &track);
+        uint64_t t1 = BenchNowNs();
+        UnloadArena(&track.arena);
+
+        uint64_t t2 = BenchNowNs();
+        ok &= LoadTrackBinary(BAKED_FILE, &track);
+        uint64_t t3 = BenchNowNs();
+
+        procedural[r] = t1 - t0;
+        baked[r] = t3 - t2;
+        if (r < RUNS - 1) UnloadArena(&track.arena);
+        else loaded = track;
+    }
+    qsort(procedural, RUNS, sizeof(uint64_t), CompareU64);
+    qsort(baked, RUNS, sizeof(uint64_t), CompareU64);
+
+    ok &= (loaded.arena.allocations == 1) && SameTrack(&generated, &loaded) && SameQueries(&generated, &loaded);
+    ok &= RefusesDamaged(data, size);
+
+    double proceduralMs = procedural[RUNS / 2] / 1e6, bakedMs = baked[RUNS / 2] / 1e6;
+    printf("%-12s %8d %8d %9d %12.3f %10.3f %8.1fx  %s\n", test->name, generated.waypointCount, generated.vertexCount, size, proceduralMs, bakedMs,
+           proceduralMs / bakedMs, ok? "ok" : "FAIL");
+
+    free(data);
+    UnloadArena(&loaded.arena);
+    UnloadArena(&generated.arena);
+    return ok;
+}
+
+int main(int argc, char **argv)
+{
+    SetTraceLogLevel(LOG_ERROR);
+
+    static const TrackCase cases[] = {
+        { "stadium", 0 },
+        { "oval-128", 128 },
+        { "oval-1024", 1024 },
+        { "oval-8192", 8192 },
+    };
+
+    printf("median of %d loads, the baked ones reading %s\n", RUNS, BAKED_FILE);
+    printf("%-12s %8s %8s %9s %12s %10s %9s\n", "track", "segments", "vertices", "bytes", "generate ms", "baked ms", "speedup");
+
+    bool ok = true;
+    for (int i = 0; i < (int)(sizeof(cases) / sizeof(cases[0])); i++) ok &= RunCase(&cases[i]);
+    remove(BAKED_FILE);
+
+    printf("check: %s\n", ok? "ok" : "FAIL");
+    return ok? 0 : 1;
+}
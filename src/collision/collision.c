@@ -0,0 +1,394 @@
+#include "collision.h"
+#include <raylib.h>
+#include <raymath.h>
+#include <stdlib.h>
+#include <math.h>
+#include "../math/fastmath.h"
+
+#define WALL_SWEEP_ITERATIONS 4     // Walls a single move may slide along
+#define WALL_SKIN 0.01f             // Gap left between a ship and the wall it stopped at
+#define WALL_WALK_LIMIT 64          // Segments walked each way from the hint before using the grid
+
+//----------------------------------------------------------------------------------
+// Ship vs wall
+//----------------------------------------------------------------------------------
+
+// Motion of a circle against the walls, in XZ
+typedef struct WallQuery {
+    Vector2 from;
+    Vector2 to;
+    float radius;
+    float height;       // Ship height, to skip segments on other layers
+    Rectangle bounds;   // Swept circle
+    float bestT;        // Earliest contact so far
+    Vector2 bestNormal;
+} WallQuery;
+
+static inline float Dot2(Vector2 a, Vector2 b)
+{
+    return a.x * b.x + a.y * b.y;
+}
+
+static inline Vector2 XZ(Vector3 v)
+{
+    return (Vector2){ v.x, v.z };
+}
+
+// Largest value of an edge line (see TrackSurfaceSegment) over a rectangle; negative when all of
+// it is on the outside of the edge
+static float GetEdgeMax(Vector3 line, Rectangle bounds)
+{
+    float x = (line.x > 0.0f)? bounds.x + bounds.width : bounds.x;
+    float z = (line.y > 0.0f)? bounds.y + bounds.height : bounds.y;
+    return line.x * x + line.y * z + line.z;
+}
+
+// Earliest time along the query's motion the circle touches wall a-b moving outwards, the
+// outside being away from 'inside'. Walls are one-sided, so a ship that is already beyond one
+// isn't held there.
+static void SweepWall(WallQuery *query, Vector3 a3, Vector3 b3, Vector3 inside3)
+{
+    Vector2 a = XZ(a3), ab = Vector2Subtract(XZ(b3), a);
+    float length2 = Dot2(ab, ab);
+    if (length2 <= 0.0f) return;
+
+    Vector2 normal = Vector2Normalize((Vector2){ ab.y, -ab.x });
+    if (Dot2(Vector2Subtract(XZ(inside3), a), normal) > 0.0f) normal = Vector2Negate(normal);
+
+    float d0 = Dot2(Vector2Subtract(query->from, a), normal);
+    float d1 = Dot2(Vector2Subtract(query->to, a), normal);
+    if ((d1 <= d0) || (d1 < -query->radius) || (d0 > query->radius)) return;
+
+    float t = (d0 >= -query->radius)? 0.0f : (-query->radius - d0) / (d1 - d0);
+    if (t >= query->bestT) return;
+
+    // The contact has to be alongside the wall; the slack covers the joints between walls
+    Vector2 contact = Vector2Lerp(query->from, query->to, t);
+    float s = Dot2(Vector2Subtract(contact, a), ab) / length2;
+    float slack = query->radius / sqrtf(length2);
+    if ((s < -slack) || (s > 1.0f + slack)) return;
+
+    query->bestT = t;
+    query->bestNormal = normal;
+}
+
+static void SweepSegmentWalls(WallQuery *query, const TrackSurfaceSegment *seg)
+{
+    const Vector3 *c = seg->corners;
+    float low = fminf(fminf(c[0].y, c[1].y), fminf(c[2].y, c[3].y));
+    float high = fmaxf(fmaxf(c[0].y, c[1].y), fmaxf(c[2].y, c[3].y));
+    if ((query->height < low - WALL_LAYER_HEIGHT) || (query->height > high + WALL_LAYER_HEIGHT)) return;
+
+    SweepWall(query, c[0], c[2], c[1]);     // Inner edge
+    SweepWall(query, c[1], c[3], c[0]);     // Outer edge
+}
+
+// Walls near the motion. From a hint, walk along the track both ways until the swept bounds
+// are wholly past a segment's start (or end) edge; without one, or on a very dense track, use
+// the surface grid.
+static void FindWallContact(WallQuery *query, const TrackSurface *surface, int segment)
+{
+    int n = surface->segmentCount;
+
+    if ((segment >= 0) && (segment < n))
+    {
+        SweepSegmentWalls(query, &surface->segments[segment]);
+
+        int forward = 1, backward = 1;
+        for (; (forward <= WALL_WALK_LIMIT) && (forward < n); forward++)
+        {
+            const TrackSurfaceSegment *seg = &surface->segments[(segment + forward) % n];
+            if (GetEdgeMax(seg->startEdge, query->bounds) < 0.0f) break;
+            SweepSegmentWalls(query, seg);
+        }
+        for (; (backward <= WALL_WALK_LIMIT) && (backward + forward < n); backward++)
+        {
+            const TrackSurfaceSegment *seg = &surface->segments[(segment - backward + n) % n];
+            if (GetEdgeMax(seg->endEdge, query->bounds) < 0.0f) break;
+            SweepSegmentWalls(query, seg);
+        }
+
+        if ((forward <= WALL_WALK_LIMIT) && (backward <= WALL_WALK_LIMIT)) return;
+    }
+
+    // Grid cells under the swept bounds. A segment spanning several cells is tested once per cell.
+    int cx0 = (int)floorf((query->bounds.x - surface->gridOrigin.x) / surface->cellSize);
+    int cz0 = (int)floorf((query->bounds.y - surface->gridOrigin.y) / surface->cellSize);
+    int cx1 = (int)floorf((query->bounds.x + query->bounds.width - surface->gridOrigin.x) / surface->cellSize);
+    int cz1 = (int)floorf((query->bounds.y + query->bounds.height - surface->gridOrigin.y) / surface->cellSize);
+    if (cx0 < 0) cx0 = 0;
+    if (cz0 < 0) cz0 = 0;
+    if (cx1 >= surface->gridWidth) cx1 = surface->gridWidth - 1;
+    if (cz1 >= surface->gridHeight) cz1 = surface->gridHeight - 1;
+
+    for (int cz = cz0; cz <= cz1; cz++)
+    {
+        for (int cx = cx0; cx <= cx1; cx++)
+        {
+            int cell = cz * surface->gridWidth + cx;
+            for (int k = surface->cellStart[cell]; k < surface->cellStart[cell + 1]; k++)
+            {
+                SweepSegmentWalls(query, &surface->segments[surface->cellSegments[k]]);
+            }
+        }
+    }
+}
+
+// Move a circle of 'radius' from 'from' to 'to' in XZ, stopping at the first wall in the way
+// and sliding the rest of the motion along it. Swept, so the move can be any length.
+// 'segment' is the last surface segment the mover was over, -1 if unknown.
+WallSweep SweepAgainstWalls(const TrackSurface *surface, Vector3 from, Vector3 to, float radius, int segment)
+{
+    WallSweep result = { to, false, { 0.0f, 0.0f, 0.0f }, 0.0f };
+    Vector2 p0 = XZ(from), p1 = XZ(to);
+
+    for (int iteration = 0; iteration < WALL_SWEEP_ITERATIONS; iteration++)
+    {
+        WallQuery query = { 0 };
+        query.from = p0;
+        query.to = p1;
+        query.radius = radius;
+        query.height = from.y;
+        query.bounds = (Rectangle){ fminf(p0.x, p1.x) - radius, fminf(p0.y, p1.y) - radius,
+                                    fabsf(p1.x - p0.x) + 2.0f * radius, fabsf(p1.y - p0.y) + 2.0f * radius };
+        query.bestT = 2.0f;
+
+        FindWallContact(&query, surface, segment);
+        if (query.bestT > 1.0f) break;
+
+        Vector2 motion = Vector2Subtract(p1, p0);
+        float length = Vector2Length(motion);
+        Vector2 n = query.bestNormal;
+        if (length > 0.0f) result.impact = fmaxf(result.impact, Dot2(motion, n) / length);
+        result.hit = true;
+        result.normal = (Vector3){ n.x, 0.0f, n.y };
+
+        // Stop just short of the wall and keep only the motion along it. A slide is only
+        // taken if there is an iteration left to check it, so the last wall just stops it.
+        Vector2 contact = Vector2Add(p0, Vector2Scale(motion, query.bestT));
+        Vector2 remaining = Vector2Subtract(p1, contact);
+        remaining = Vector2Subtract(remaining, Vector2Scale(n, Dot2(remaining, n)));
+        p0 = Vector2Subtract(contact, Vector2Scale(n, WALL_SKIN));
+        p1 = (iteration + 1 < WALL_SWEEP_ITERATIONS)? Vector2Add(p0, remaining) : p0;
+    }
+
+    result.position = (Vector3){ p1.x, to.y, p1.y };
+    return result;
+}
+
+//----------------------------------------------------------------------------------
+// Ship vs ship
+//----------------------------------------------------------------------------------
+
+// Room for 'capacity' ships. Without memory the world holds none and CollideShips() does nothing.
+void InitCollisionWorld(CollisionWorld *world, int capacity)
+{
+    *world = (CollisionWorld){ 0 };
+    size_t vectors = GetArenaAllocSize(capacity * sizeof(Vector3));
+    size_t scalars = GetArenaAllocSize(capacity * sizeof(float));
+    if (!InitArena(&world->arena, 2 * vectors + 4 * scalars + GetArenaAllocSize(capacity * sizeof(int)))) return;
+
+    world->start = (Vector3 *)ArenaAlloc(&world->arena, capacity * sizeof(Vector3));
+    world->position = (Vector3 *)ArenaAlloc(&world->arena, capacity * sizeof(Vector3));
+    world->speed = (float *)ArenaAlloc(&world->arena, capacity * sizeof(float));
+    world->yaw = (float *)ArenaAlloc(&world->arena, capacity * sizeof(float));
+    world->minX = (float *)ArenaAlloc(&world->arena, capacity * sizeof(float));
+    world->maxX = (float *)ArenaAlloc(&world->arena, capacity * sizeof(float));
+    world->order = (int *)ArenaAlloc(&world->arena, capacity * sizeof(int));
+    world->capacity = capacity;
+}
+
+// Earliest time in [0, 1] two circles moving in straight lines come within 'distance', or -1.
+// Catches ships that would pass through each other within a tick.
+static float GetContactTime(Vector2 a0, Vector2 a1, Vector2 b0, Vector2 b1, float distance)
+{
+    Vector2 p = Vector2Subtract(a0, b0);
+    Vector2 v = Vector2Subtract(Vector2Subtract(a1, a0), Vector2Subtract(b1, b0));
+
+    float c = Dot2(p, p) - distance * distance;
+    if (c <= 0.0f) return 0.0f;
+
+    float a = Dot2(v, v);
+    float b = Dot2(p, v);
+    if ((a <= 0.0f) || (b >= 0.0f)) return -1.0f;
+
+    float discriminant = b * b - a * c;
+    if (discriminant < 0.0f) return -1.0f;
+
+    float t = (-b - sqrtf(discriminant)) / a;
+    return (t <= 1.0f)? t : -1.0f;
+}
+
+// Push ships i and j apart from where they touched, keeping the rest of their motion that
+// doesn't close on the other ship, and take off part of each one's closing speed
+static void ResolveShipContact(CollisionWorld *world, int i, int j, float t)
+{
+    float distance = 2.0f * SHIP_COLLISION_RADIUS;
+    Vector2 ci = Vector2Lerp(XZ(world->start[i]), XZ(world->position[i]), t);
+    Vector2 cj = Vector2Lerp(XZ(world->start[j]), XZ(world->position[j]), t);
+
+    Vector2 n = Vector2Subtract(ci, cj);    // From j towards i
+    float length = Vector2Length(n);
+    n = (length > 0.0f)? Vector2Scale(n, 1.0f / length) : (Vector2){ 1.0f, 0.0f };
+
+    Vector2 ri = Vector2Subtract(XZ(world->position[i]), ci);
+    Vector2 rj = Vector2Subtract(XZ(world->position[j]), cj);
+    ri = Vector2Subtract(ri, Vector2Scale(n, fminf(Dot2(ri, n), 0.0f)));
+    rj = Vector2Subtract(rj, Vector2Scale(n, fmaxf(Dot2(rj, n), 0.0f)));
+    Vector2 pi = Vector2Add(ci, ri);
+    Vector2 pj = Vector2Add(cj, rj);
+
+    // Overlapping at the start of the tick too: split the overlap
+    float gap = Vector2Distance(pi, pj);
+    if (gap < distance)
+    {
+        float push = 0.5f * (distance - gap);
+        pi = Vector2Add(pi, Vector2Scale(n, push));
+        pj = Vector2Subtract(pj, Vector2Scale(n, push));
+    }
+
+    world->position[i].x = pi.x; world->position[i].z = pi.y;
+    world->position[j].x = pj.x; world->position[j].z = pj.y;
+
+    Vector2 fi, fj;
+    FastSinCos(world->yaw[i] * DEG2RAD, &fi.x, &fi.y);
+    FastSinCos(world->yaw[j] * DEG2RAD, &fj.x, &fj.y);
+    float closingI = -Dot2(fi, n) * world->speed[i];
+    float closingJ = Dot2(fj, n) * world->speed[j];
+    if (closingI > 0.0f) world->speed[i] = fmaxf(world->speed[i] - SHIP_BUMP_DRAG * closingI, 0.0f);
+    if (closingJ > 0.0f) world->speed[j] = fmaxf(world->speed[j] - SHIP_BUMP_DRAG * closingJ, 0.0f);
+}
+
+// Sort ships by the start of their swept bounds. Ships rarely overtake within a tick, so
+// the order from the last call is almost sorted already.
+static void SortShips(CollisionWorld *world)
+{
+    for (int a = 1; a < world->count; a++)
+    {
+        int ship = world->order[a];
+        float key = world->minX[ship];
+        int b = a - 1;
+        while ((b >= 0) && (world->minX[world->order[b]] > key))
+        {
+            world->order[b + 1] = world->order[b];
+            b--;
+        }
+        world->order[b + 1] = ship;
+    }
+}
+
+static void GatherShip(CollisionWorld *world, int k, Vector3 start, Vector3 position, float speed, float yaw)
+{
+    world->start[k] = start;
+    world->position[k] = position;
+    world->speed[k] = speed;
+    world->yaw[k] = yaw;
+    world->minX[k] = fminf(start.x, position.x) - SHIP_COLLISION_RADIUS;
+    world->maxX[k] = fmaxf(start.x, position.x) + SHIP_COLLISION_RADIUS;
+}
+
+// A ship a contact moved from 'from': keep it inside the walls and back on the surface
+static Vector3 SettleShip(const TrackSurface *surface, Vector3 from, Vector3 to, int *segment)
+{
+    Vector3 position = SweepAgainstWalls(surface, from, to, SHIP_COLLISION_RADIUS, *segment).position;
+    TrackSurfaceHit hit = QueryTrackSurface(surface, position, *segment);
+    if (hit.hit)
+    {
+        position.y = hit.height + SHIP_HOVER_HEIGHT;
+        *segment = hit.segment;
+    }
+    return position;
+}
+
+// Resolve contacts between every ship after the tick's updates: 'ships' (the player's) and
+// every ship in 'pool'. Pairs come from sweep and prune on X over each ship's swept bounds,
+// and are then tested over the whole tick, from the pose it started at. Returns the contacts.
+int CollideShips(CollisionWorld *world, Ship **ships, int shipCount, ShipPool *pool, const TrackSurface *surface)
+{
+    int count = shipCount + pool->count;
+    if (count > world->capacity) count = world->capacity;
+
+    // A different set of ships invalidates the order kept from the last call
+    if (count != world->count)
+    {
+        world->count = count;
+        for (int k = 0; k < count; k++) world->order[k] = k;
+    }
+
+    for (int k = 0; k < count; k++)
+    {
+        if (k < shipCount)
+        {
+            const Ship *ship = ships[k];
+            GatherShip(world, k, ship->previous.position, ship->position, ship->speed, ship->yaw);
+        }
+        else
+        {
+            int i = k - shipCount;
+            GatherShip(world, k, pool->previous[i].position, (Vector3){ pool->posX[i], pool->posY[i], pool->posZ[i] },
+                       pool->speed[i], pool->yaw[i]);
+        }
+    }
+
+    SortShips(world);
+
+    world->pairTests = 0;
+    world->contacts = 0;
+    float reach = 2.0f * SHIP_COLLISION_RADIUS;
+
+    for (int a = 0; a < count; a++)
+    {
+        int i = world->order[a];
+        for (int b = a + 1; (b < count) && (world->minX[world->order[b]] <= world->maxX[i]); b++)
+        {
+            int j = world->order[b];
+            world->pairTests++;
+
+            float iz0 = fminf(world->start[i].z, world->position[i].z), iz1 = fmaxf(world->start[i].z, world->position[i].z);
+            float jz0 = fminf(world->start[j].z, world->position[j].z), jz1 = fmaxf(world->start[j].z, world->position[j].z);
+            if ((iz1 + reach < jz0) || (jz1 + reach < iz0)) continue;
+            if (fabsf(world->position[i].y - world->position[j].y) > SHIP_LAYER_HEIGHT) continue;
+
+            float t = GetContactTime(XZ(world->start[i]), XZ(world->position[i]), XZ(world->start[j]), XZ(world->position[j]), reach);
+            if (t < 0.0f) continue;
+
+            ResolveShipContact(world, i, j, t);
+            world->contacts++;
+        }
+    }
+
+    // Write back, settling every ship a contact moved
+    for (int k = 0; k < count; k++)
+    {
+        if (k < shipCount)
+        {
+            Ship *ship = ships[k];
+            ship->speed = world->speed[k];
+            if ((ship->position.x != world->position[k].x) || (ship->position.z != world->position[k].z))
+            {
+                ship->position = SettleShip(surface, ship->position, world->position[k], &ship->segment);
+            }
+        }
+        else
+        {
+            int i = k - shipCount;
+            Vector3 from = { pool->posX[i], pool->posY[i], pool->posZ[i] };
+            pool->speed[i] = world->speed[k];
+            if ((from.x != world->position[k].x) || (from.z != world->position[k].z))
+            {
+                Vector3 position = SettleShip(surface, from, world->position[k], &pool->segment[i]);
+                pool->posX[i] = position.x;
+                pool->posY[i] = position.y;
+                pool->posZ[i] = position.z;
+            }
+        }
+    }
+
+    return world->contacts;
+}
+
+void UnloadCollisionWorld(CollisionWorld *world)
+{
+    UnloadArena(&world->arena);
+    *world = (CollisionWorld){ 0 };
+}
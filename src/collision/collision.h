@@ -0,0 +1,53 @@
+#ifndef COLLISION_H
+#define COLLISION_H
+
+#include <raylib.h>
+#include "../ship/ship.h"
+#include "../ship/pool.h"
+#include "../track/surface.h"
+#include "../mem/arena.h"
+
+// Ships collide as circles in XZ. Walls run along the ribbon's inner and outer edges; ship
+// pairs are found by sweep and prune. Both tests are swept over the tick, so no speed tunnels.
+
+#define SHIP_COLLISION_RADIUS 3.0f
+#define WALL_LAYER_HEIGHT 20.0f     // Walls further than this above or below the ship belong to another layer
+#define SHIP_LAYER_HEIGHT 6.0f      // Ships further apart vertically than this pass over each other
+#define WALL_SCRAPE_DRAG 0.6f       // Speed lost hitting a wall head on, less at a glancing angle
+#define SHIP_BUMP_DRAG 0.5f         // Share of its closing speed a ship loses in a bump
+
+// Result of moving a circle against the walls
+typedef struct WallSweep {
+    Vector3 position;   // Where the motion ended, slid along any wall it met
+    bool hit;
+    Vector3 normal;     // Outward normal (XZ) of the last wall hit
+    float impact;       // 0 grazing to 1 head on, the worst over the tick
+} WallSweep;
+
+// Per-tick ship state gathered from the player ships and the AI pool into one set of arrays
+typedef struct CollisionWorld {
+    int count;
+    int capacity;
+
+    Vector3 *start;     // Position at the start of the tick
+    Vector3 *position;
+    float *speed;
+    float *yaw;
+    float *minX;        // Swept bounds along the sort axis
+    float *maxX;
+    int *order;         // Ships sorted by minX, kept between ticks so the sort is nearly free
+
+    MemArena arena;     // Every array above
+
+    // Counters for the last CollideShips()
+    int pairTests;      // Pairs that overlapped on the sort axis
+    int contacts;
+} CollisionWorld;
+
+// Function declarations
+WallSweep SweepAgainstWalls(const TrackSurface *surface, Vector3 from, Vector3 to, float radius, int segment);
+void InitCollisionWorld(CollisionWorld *world, int capacity);
+int CollideShips(CollisionWorld *world, Ship **ships, int shipCount, ShipPool *pool, const TrackSurface *surface);
+void UnloadCollisionWorld(CollisionWorld *world);
+
+#endif // COLLISION_H
@@ -0,0 +1,188 @@
+#include "particles.h"
+#include <raylib.h>
+#include <raymath.h>
+
+// Room for 'capacity' particles. Without memory the pool holds none and drops every spawn.
+void InitParticlePool(ParticlePool *pool, int capacity)
+{
+    *pool = (ParticlePool){ 0 };
+    if (!InitArena(&pool->arena, 9 * GetArenaAllocSize(capacity * sizeof(float)))) return;
+
+    float **arrays[9] = { &pool->posX, &pool->posY, &pool->posZ, &pool->velX, &pool->velY, &pool->velZ, &pool->age, &pool->life, &pool->size };
+    for (int i = 0; i < 9; i++) *arrays[i] = (float *)ArenaCalloc(&pool->arena, capacity, sizeof(float));
+    pool->capacity = capacity;
+}
+
+// Returns false, dropping the particle, when the pool is full
+bool SpawnParticle(ParticlePool *pool, Vector3 position, Vector3 velocity, float life, float size)
+{
+    if (pool->count >= pool->capacity) return false;
+
+    int i = pool->count++;
+    pool->posX[i] = position.x;
+    pool->posY[i] = position.y;
+    pool->posZ[i] = position.z;
+    pool->velX[i] = velocity.x;
+    pool->velY[i] = velocity.y;
+    pool->velZ[i] = velocity.z;
+    pool->age[i] = 0.0f;
+    pool->life[i] = life;
+    pool->size[i] = size;
+    return true;
+}
+
+void UpdateParticles(ParticlePool *pool, float dt, float drag, float gravity)
+{
+    int count = pool->count;
+    float keep = 1.0f - drag * dt;
+    if (keep < 0.0f) keep = 0.0f;
+    float fall = gravity * dt;
+
+    float *restrict posX = pool->posX, *restrict posY = pool->posY, *restrict posZ = pool->posZ;
+    float *restrict velX = pool->velX, *restrict velY = pool->velY, *restrict velZ = pool->velZ;
+    float *restrict age = pool->age, *restrict life = pool->life, *restrict size = pool->size;
+
+    // One pass from the back: a dead particle takes the last one's place, already moved on
+    for (int i = count - 1; i >= 0; i--)
+    {
+        float a = age[i] + dt;
+        if (a >= life[i])
+        {
+            int last = --count;
+            posX[i] = posX[last];
+            posY[i] = posY[last];
+            posZ[i] = posZ[last];
+            velX[i] = velX[last];
+            velY[i] = velY[last];
+            velZ[i] = velZ[last];
+            age[i] = age[last];
+            life[i] = life[last];
+            size[i] = size[last];
+            continue;
+        }
+
+        float vx = velX[i] * keep, vy = (velY[i] - fall) * keep, vz = velZ[i] * keep;
+        velX[i] = vx;
+        velY[i] = vy;
+        velZ[i] = vz;
+        posX[i] += vx * dt;
+        posY[i] += vy * dt;
+        posZ[i] += vz * dt;
+        age[i] = a;
+    }
+    pool->count = count;
+}
+
+void UnloadParticlePool(ParticlePool *pool)
+{
+    UnloadArena(&pool->arena);
+    *pool = (ParticlePool){ 0 };
+}
+
+// -1 to 1
+static float RandomSigned(unsigned int *seed)
+{
+    *seed = *seed * 1664525u + 1013904223u;
+    return (float)(*seed >> 8) / 8388608.0f - 1.0f;
+}
+
+// Room for 'capacity' particles, up to PARTICLE_MAX_BATCH. Without memory it emits and draws none.
+void InitParticleEmitter(ParticleEmitter *emitter, int capacity, ParticleStyle style, Color color)
+{
+    if (capacity > PARTICLE_MAX_BATCH) capacity = PARTICLE_MAX_BATCH;
+
+    *emitter = (ParticleEmitter){ 0 };
+    emitter->style = style;
+    emitter->density = 1.0f;
+    emitter->seed = 12345u;
+    emitter->material = LoadMaterialDefault();
+    emitter->material.maps[MATERIAL_MAP_DIFFUSE].color = color;
+
+    InitParticlePool(&emitter->pool, capacity);
+    if (!InitArena(&emitter->arena, GetArenaAllocSize(capacity * 4 * sizeof(UnlitVertex)) + GetArenaAllocSize(capacity * 6 * sizeof(unsigned short))))
+    {
+        UnloadParticlePool(&emitter->pool); // No quads to draw them with
+        return;
+    }
+
+    emitter->vertices = (UnlitVertex *)ArenaAlloc(&emitter->arena, capacity * 4 * sizeof(UnlitVertex));
+    emitter->indices = (unsigned short *)ArenaAlloc(&emitter->arena, capacity * 6 * sizeof(unsigned short));
+
+    // Every quad is the same two triangles over its own four vertices, so the indices never change
+    GenQuadIndices(emitter->indices, capacity);
+}
+
+// Emit for 'dt' seconds at 'strength' (0 to 1) of the style's rate, along 'direction' (unit) on
+// top of 'baseVelocity', the velocity of whatever emits them. Returns the particles spawned.
+int EmitParticles(ParticleEmitter *emitter, Vector3 position, Vector3 direction, Vector3 baseVelocity, float strength, float dt)
+{
+    const ParticleStyle *style = &emitter->style;
+    emitter->owed += style->rate * strength * emitter->density * dt;
+    int count = (int)emitter->owed;
+    emitter->owed -= (float)count;
+
+    int spawned = 0;
+    for (int i = 0; i < count; i++)
+    {
+        Vector3 velocity = Vector3Add(baseVelocity, Vector3Scale(direction, style->speed));
+        velocity.x += RandomSigned(&emitter->seed) * style->spread;
+        velocity.y += RandomSigned(&emitter->seed) * style->spread;
+        velocity.z += RandomSigned(&emitter->seed) * style->spread;
+        float life = style->life * (1.0f + 0.25f * RandomSigned(&emitter->seed));
+
+        // Spread over the interval, so a slow frame doesn't emit in clumps
+        float lead = dt * (float)i / (float)count;
+        Vector3 start = Vector3Add(position, Vector3Scale(velocity, lead));
+
+        if (!SpawnParticle(&emitter->pool, start, velocity, life, style->size)) break;
+        spawned++;
+    }
+
+    return spawned;
+}
+
+void UpdateParticleEmitter(ParticleEmitter *emitter, float dt)
+{
+    UpdateParticles(&emitter->pool, dt, emitter->style.drag, emitter->style.gravity);
+}
+
+// Build a quad facing the camera for every live particle and queue them all as one translucent
+// item. Returns the particles queued.
+int QueueParticles(RenderQueue *queue, ParticleEmitter *emitter, Camera camera)
+{
+    const ParticlePool *pool = &emitter->pool;
+    int count = pool->count;
+    if (count == 0) return 0;
+
+    Vector3 forward = Vector3Normalize(Vector3Subtract(camera.target, camera.position));
+    Vector3 right = Vector3Normalize(Vector3CrossProduct(forward, camera.up));
+    Vector3 up = Vector3CrossProduct(right, forward);
+
+    Vector3 sum = { 0.0f, 0.0f, 0.0f };
+    UnlitVertex *v = emitter->vertices;
+    for (int i = 0; i < count; i++, v += 4)
+    {
+        Vector3 p = { pool->posX[i], pool->posY[i], pool->posZ[i] };
+        float size = pool->size[i] * (1.0f - pool->age[i] / pool->life[i]);
+        Vector3 r = Vector3Scale(right, size), u = Vector3Scale(up, size);
+
+        v[0] = (UnlitVertex){ Vector3Subtract(Vector3Subtract(p, r), u), { 0.0f, 1.0f } };
+        v[1] = (UnlitVertex){ Vector3Subtract(Vector3Add(p, r), u), { 1.0f, 1.0f } };
+        v[2] = (UnlitVertex){ Vector3Add(Vector3Add(p, r), u), { 1.0f, 0.0f } };
+        v[3] = (UnlitVertex){ Vector3Add(Vector3Subtract(p, r), u), { 0.0f, 0.0f } };
+        sum = Vector3Add(sum, p);
+    }
+
+    Vector3 center = Vector3Scale(sum, 1.0f / count);
+    QueueUnlitVertices(queue, RENDER_PASS_WORLD, RENDER_TRANSLUCENT | RENDER_BLEND, emitter->vertices, count * 4, emitter->indices, count * 6,
+                       &emitter->material, center);
+    return count;
+}
+
+void UnloadParticleEmitter(ParticleEmitter *emitter)
+{
+    UnloadParticlePool(&emitter->pool);
+    UnloadArena(&emitter->arena);
+    RL_FREE(emitter->material.maps);
+    *emitter = (ParticleEmitter){ 0 };
+}
@@ -0,0 +1,72 @@
+#ifndef PARTICLES_H
+#define PARTICLES_H
+
+#include <raylib.h>
+#include <stdbool.h>
+#include "../render/vertices.h"
+#include "../render/queue.h"
+#include "../mem/arena.h"
+
+// Particles live in fixed-capacity pools stored as parallel arrays, allocated once: spawning
+// past the capacity drops the particle, nothing is allocated after init. UpdateParticles()
+// makes one pass over the arrays from the back, moving each live particle on and filling a dead
+// one's slot with the last particle, so the live ones always fill the front of the arrays. An
+// emitter owns a pool and draws all of it as one batch of camera-facing quads.
+
+#define PARTICLE_MAX_BATCH (65536 / 4)  // Quads one batch can index with 16-bit indices
+
+// A pool of particles, one entry per particle in each array
+typedef struct ParticlePool {
+    int count;
+    int capacity;
+
+    float *posX;
+    float *posY;
+    float *posZ;
+    float *velX;
+    float *velY;
+    float *velZ;
+    float *age;             // Seconds since spawned
+    float *life;            // Seconds it lives for
+    float *size;            // Half width of its quad when spawned, shrinks to 0 over its life
+
+    MemArena arena;         // Every array above
+} ParticlePool;
+
+// How an emitter's particles are launched and move
+typedef struct ParticleStyle {
+    float rate;             // Particles per second at full strength
+    float life;             // Seconds, varied by up to a quarter either way
+    float size;
+    float speed;            // Launch speed along the emit direction
+    float spread;           // Random launch speed added in any direction
+    float drag;             // Share of the velocity lost per second
+    float gravity;          // Downward acceleration
+} ParticleStyle;
+
+typedef struct ParticleEmitter {
+    ParticlePool pool;
+    ParticleStyle style;
+    float density;          // Share of the rate emitted, the frame governor's effect density
+    float owed;             // Fraction of a particle carried over to the next emit
+    unsigned int seed;
+
+    UnlitVertex *vertices;  // 4 per particle, rebuilt by each QueueParticles()
+    unsigned short *indices;    // 6 per particle, built once
+    Material material;
+    MemArena arena;         // The vertices and indices
+} ParticleEmitter;
+
+// Function declarations
+void InitParticlePool(ParticlePool *pool, int capacity);
+bool SpawnParticle(ParticlePool *pool, Vector3 position, Vector3 velocity, float life, float size);
+void UpdateParticles(ParticlePool *pool, float dt, float drag, float gravity);
+void UnloadParticlePool(ParticlePool *pool);
+
+void InitParticleEmitter(ParticleEmitter *emitter, int capacity, ParticleStyle style, Color color);
+int EmitParticles(ParticleEmitter *emitter, Vector3 position, Vector3 direction, Vector3 baseVelocity, float strength, float dt);
+void UpdateParticleEmitter(ParticleEmitter *emitter, float dt);
+int QueueParticles(RenderQueue *queue, ParticleEmitter *emitter, Camera camera);
+void UnloadParticleEmitter(ParticleEmitter *emitter);
+
+#endif // PARTICLES_H
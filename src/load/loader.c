@@ -0,0 +1,311 @@
+#include "loader.h"
+#include "../mem/budget.h"
+#include "../mesh/meshbin.h"
+#include "../texture/texbin.h"
+#include "../texture/cache.h"
+#include "../track/trackbin.h"
+#include <raylib.h>
+#include <string.h>
+#if defined(_arch_dreamcast)
+#include <arch/timer.h>
+#else
+#include <time.h>
+#endif
+
+static inline uint64_t GetLoaderTime(void)
+{
+#if defined(_arch_dreamcast)
+    return timer_ns_gettime64();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+void InitAssetLoader(AssetLoader *loader)
+{
+    memset(loader, 0, sizeof(*loader));
+    atomic_init(&loader->decoded, 0);
+}
+
+// Next job slot, or NULL once the loader is full or started
+static LoadJob *AddLoadJob(AssetLoader *loader, LoadJobType type, const char *fileName)
+{
+    if (loader->running || (loader->jobCount >= LOADER_MAX_JOBS))
+    {
+        TraceLog(LOG_WARNING, "LOADER: Can't queue [%s]", (fileName != NULL)? fileName : "track");
+        return NULL;
+    }
+
+    LoadJob *job = &loader->jobs[loader->jobCount++];
+    job->type = type;
+    job->fileName = fileName;
+    job->textureJob = -1;
+    return job;
+}
+
+// A .hsm model into 'arena', and its outline section into 'outline' unless that's NULL
+int AddModelJob(AssetLoader *loader, const char *fileName, MemArena *arena, OutlineMesh *outline)
+{
+    LoadJob *job = AddLoadJob(loader, LOAD_JOB_MODEL, fileName);
+    if (job == NULL) return -1;
+
+    job->arena = arena;
+    job->outline = outline;
+    return loader->jobCount - 1;
+}
+
+int AddTextureJob(AssetLoader *loader, const char *fileName)
+{
+    return (AddLoadJob(loader, LOAD_JOB_TEXTURE, fileName) != NULL)? loader->jobCount - 1 : -1;
+}
+
+// A track job textured with the file of 'textureJob', which must be queued before it
+static LoadJob *AddTrackLoadJob(AssetLoader *loader, LoadJobType type, const char *fileName, Track *track, int textureJob)
+{
+    if ((textureJob < 0) || (textureJob >= loader->jobCount) || (loader->jobs[textureJob].type != LOAD_JOB_TEXTURE)) return NULL;
+
+    LoadJob *job = AddLoadJob(loader, type, fileName);
+    if (job == NULL) return NULL;
+
+    job->track = track;
+    job->textureJob = textureJob;
+    return job;
+}
+
+// A spline track generated from its control points
+int AddSplineTrackJob(AssetLoader *loader, Track *track, const TrackControlPoint *points, int pointCount, TrackSplineSettings settings, int textureJob)
+{
+    LoadJob *job = AddTrackLoadJob(loader, LOAD_JOB_SPLINE_TRACK, NULL, track, textureJob);
+    if (job == NULL) return -1;
+
+    job->points = points;
+    job->pointCount = pointCount;
+    job->settings = settings;
+    return loader->jobCount - 1;
+}
+
+// A track baked by tools/trackbake, read as it is
+int AddTrackJob(AssetLoader *loader, const char *fileName, Track *track, int textureJob)
+{
+    return (AddTrackLoadJob(loader, LOAD_JOB_TRACK, fileName, track, textureJob) != NULL)? loader->jobCount - 1 : -1;
+}
+
+// The loader thread's half: everything but the GPU
+static void DecodeJob(LoadJob *job)
+{
+    switch (job->type)
+    {
+        case LOAD_JOB_MODEL:
+        {
+            int dataSize = 0;
+            unsigned char *data = LoadFileData(job->fileName, &dataSize);
+            job->ok = LoadModelLodsData(data, dataSize, job->arena, &job->lods);
+            if (job->ok && (job->outline != NULL)) job->hasOutline = LoadOutlineMeshData(data, dataSize, job->outline); // Nothing frees an outline whose model failed
+            UnloadFileData(data);
+        } break;
+        case LOAD_JOB_TEXTURE:
+        {
+            if (IsFileExtension(job->fileName, ".hst"))
+            {
+                int dataSize = 0;
+                job->data = LoadFileData(job->fileName, &dataSize);
+                job->ok = GetTextureBinaryImage(job->data, dataSize, &job->image);
+            }
+            else
+            {
+                job->image = LoadImage(job->fileName);
+                job->ok = (job->image.data != NULL);
+            }
+        } break;
+        case LOAD_JOB_SPLINE_TRACK: job->ok = GenSplineTrack(job->track, job->points, job->pointCount, job->settings); break;
+        case LOAD_JOB_TRACK: job->ok = LoadTrackBinary(job->fileName, job->track); break;
+        default: break;
+    }
+
+    if (!job->ok) TraceLog(LOG_WARNING, "LOADER: [%s] Failed to load", (job->fileName != NULL)? job->fileName : "track");
+}
+
+// Drop what a texture job decoded. An .hst image points into the file data.
+static void FreeJobImage(LoadJob *job)
+{
+    if (job->data != NULL) UnloadFileData(job->data);
+    else if (job->image.data != NULL) UnloadImage(job->image);
+
+    job->data = NULL;
+    job->image = (Image){ 0 };
+}
+
+// Charge what a model or track job loaded to the asset memory budgets, and drop it if it doesn't
+// fit. Headless loads are charged too, as it's all in RAM; textures are charged by the cache.
+static void ChargeJob(LoadJob *job)
+{
+    const char *tag = (job->fileName != NULL)? job->fileName : "spline track";
+
+    switch (job->type)
+    {
+        case LOAD_JOB_MODEL:
+        {
+            bool charged = (!job->hasOutline || ReserveAssetMemory(ASSET_MODEL, (uintptr_t)job->outline->arena.base, tag, job->outline->arena.capacity)) &&
+                           ReserveModelLodsMemory(&job->lods, job->arena, tag);
+            if (charged) break;
+
+            if (job->hasOutline) UnloadOutlineMesh(job->outline);
+            UnloadModelLods(&job->lods, job->arena);
+            job->hasOutline = false;
+            job->ok = false;
+        } break;
+        case LOAD_JOB_SPLINE_TRACK:
+        case LOAD_JOB_TRACK:
+        {
+            if (ReserveAssetMemory(ASSET_TRACK, (uintptr_t)job->track->arena.base, tag, job->track->arena.capacity)) break;
+
+            UnloadTrack(job->track);
+            job->ok = false;
+        } break;
+        default: break;
+    }
+}
+
+// The render thread's half: uploads and the track's material, then charging it all to the budgets
+static void UploadJob(AssetLoader *loader, LoadJob *job)
+{
+    if (!job->ok) return;
+
+    if (!loader->headless)
+    {
+        switch (job->type)
+        {
+            case LOAD_JOB_MODEL: UploadModelLods(&job->lods); break;
+            case LOAD_JOB_TEXTURE:
+            {
+                job->texture = AcquireTextureFromImage(job->fileName, job->image);
+                job->ok = (job->texture.id != 0);
+                FreeJobImage(job);
+            } break;
+            case LOAD_JOB_SPLINE_TRACK:
+            case LOAD_JOB_TRACK:
+            {
+                // Its texture job came first, so this only adds a cache reference
+                const LoadJob *textureJob = &loader->jobs[job->textureJob];
+                LoadTrackMaterial(job->track, textureJob->ok? AcquireTexture(textureJob->fileName) : (Texture2D){ 0 });
+            } break;
+            default: break;
+        }
+    }
+
+    if (job->ok) ChargeJob(job);
+}
+
+static void DecodeJobs(AssetLoader *loader)
+{
+    for (int i = 0; i < loader->jobCount; i++)
+    {
+        DecodeJob(&loader->jobs[i]);
+        if (i == loader->jobCount - 1) loader->decodeTime = GetAssetLoaderElapsed(loader);
+
+        // Publishes the job's results to the render thread
+        atomic_store_explicit(&loader->decoded, i + 1, memory_order_release);
+    }
+}
+
+static void *LoaderThreadMain(void *param)
+{
+    DecodeJobs((AssetLoader *)param);
+    return NULL;
+}
+
+// Start decoding the queued jobs on the loader thread. If it can't be created they are decoded
+// here and now, and false is returned; UpdateAssetLoader() works the same either way.
+bool StartAssetLoader(AssetLoader *loader)
+{
+    loader->startTime = GetLoaderTime();
+
+#if defined(_arch_dreamcast)
+    loader->thread = thd_create(0, LoaderThreadMain, loader);
+    loader->running = (loader->thread != NULL);
+#else
+    loader->running = (pthread_create(&loader->thread, NULL, LoaderThreadMain, loader) == 0);
+#endif
+
+    if (!loader->running)
+    {
+        TraceLog(LOG_WARNING, "LOADER: No loader thread, loading on the render thread");
+        DecodeJobs(loader);
+    }
+
+    return loader->running;
+}
+
+static void JoinAssetLoader(AssetLoader *loader)
+{
+    if (!loader->running) return;
+
+#if defined(_arch_dreamcast)
+    thd_join(loader->thread, NULL);
+#else
+    pthread_join(loader->thread, NULL);
+#endif
+    loader->running = false;
+}
+
+// Render thread, once a frame: upload everything decoded since the last call. True once every
+// job is done, when the loader thread has been joined.
+bool UpdateAssetLoader(AssetLoader *loader)
+{
+    int decoded = atomic_load_explicit(&loader->decoded, memory_order_acquire);
+    if ((loader->uploaded == loader->jobCount) && !loader->running) return true;
+
+    while (loader->uploaded < decoded) UploadJob(loader, &loader->jobs[loader->uploaded++]);
+    if (loader->uploaded < loader->jobCount) return false;
+
+    JoinAssetLoader(loader);
+    loader->loadTime = GetAssetLoaderElapsed(loader);
+    TraceLog(LOG_INFO, "LOADER: %i jobs decoded in %.1f ms, loaded in %.1f ms", loader->jobCount, loader->decodeTime, loader->loadTime);
+    return true;
+}
+
+// Every job decoded and uploaded in turn on the calling thread, the way loading worked before
+// the loader thread
+void RunAssetLoader(AssetLoader *loader)
+{
+    loader->startTime = GetLoaderTime();
+
+    for (int i = 0; i < loader->jobCount; i++)
+    {
+        DecodeJob(&loader->jobs[i]);
+        atomic_store_explicit(&loader->decoded, i + 1, memory_order_relaxed);
+        UploadJob(loader, &loader->jobs[i]);
+        loader->uploaded = i + 1;
+    }
+
+    loader->decodeTime = loader->loadTime = GetAssetLoaderElapsed(loader);
+}
+
+// Share of the work done, decoding and uploading weighted alike
+float GetAssetLoaderProgress(AssetLoader *loader)
+{
+    if (loader->jobCount == 0) return 1.0f;
+
+    int decoded = atomic_load_explicit(&loader->decoded, memory_order_acquire);
+    return (float)(decoded + loader->uploaded) / (2.0f * loader->jobCount);
+}
+
+// Milliseconds since StartAssetLoader() or RunAssetLoader()
+float GetAssetLoaderElapsed(const AssetLoader *loader)
+{
+    return (float)((GetLoaderTime() - loader->startTime) / 1000000.0);
+}
+
+// Wait for the thread and drop whatever decoded data was never uploaded. What the jobs loaded
+// belongs to their callers and stays.
+void UnloadAssetLoader(AssetLoader *loader)
+{
+    JoinAssetLoader(loader);
+
+    for (int i = 0; i < loader->jobCount; i++)
+    {
+        if (loader->jobs[i].type == LOAD_JOB_TEXTURE) FreeJobImage(&loader->jobs[i]);
+    }
+}
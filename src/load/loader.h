@@ -0,0 +1,86 @@
+#ifndef LOADER_H
+#define LOADER_H
+
+#include <raylib.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include "../mem/arena.h"
+#include "../mesh/meshbin.h"
+#include "../track/track.h"
+#include "../render/outline.h"
+
+#if defined(_arch_dreamcast)
+#include <kos/thread.h>
+typedef kthread_t *LoaderThread;
+#else
+#include <pthread.h>
+typedef pthread_t LoaderThread;
+#endif
+
+// Background asset loading. Jobs are queued up front, then a loader thread (a KOS thread on the
+// Dreamcast, pthreads elsewhere) does the CPU half of each in order: file reads, .hsm and .hst
+// parsing, image decoding and track generation or loading. The render thread calls UpdateAssetLoader()
+// once a frame for the GPU half of whatever is decoded, and draws a loading screen meanwhile.
+// Models and tracks are charged to the asset memory budgets as they're finished (textures by the
+// cache); one that doesn't fit is unloaded again and its job fails.
+
+#define LOADER_MAX_JOBS 16
+
+typedef enum {
+    LOAD_JOB_MODEL = 0,     // .hsm model's levels of detail, and its outline section if asked for
+    LOAD_JOB_TEXTURE,       // Texture through the cache: .hst, or any image raylib decodes
+    LOAD_JOB_SPLINE_TRACK,  // Spline track, textured with an earlier texture job's file
+    LOAD_JOB_TRACK          // Baked .hsk track, textured the same way
+} LoadJobType;
+
+typedef struct LoadJob {
+    LoadJobType type;
+    const char *fileName;           // Model and texture jobs, must outlive the loader
+    bool ok;                        // Set by the loader thread, cleared by a failed upload or a budget refusal
+
+    // Model
+    MemArena *arena;                // Receives the levels, see LoadModelLodsData()
+    OutlineMesh *outline;           // Filled from the same file read, or NULL
+    ModelLods lods;
+    bool hasOutline;
+
+    // Texture
+    unsigned char *data;            // The .hst file the image points into, until the upload
+    Image image;
+    Texture2D texture;              // One cache reference, the caller's
+
+    // Track, spline or baked
+    Track *track;
+    const TrackControlPoint *points;
+    int pointCount;
+    TrackSplineSettings settings;
+    int textureJob;
+} LoadJob;
+
+typedef struct AssetLoader {
+    LoadJob jobs[LOADER_MAX_JOBS];
+    int jobCount;
+    atomic_int decoded;             // Jobs the loader thread has finished, in order
+    int uploaded;                   // Jobs the render thread has finished
+    bool headless;                  // Decode only and upload nothing, for hosts without a GL context
+    bool running;                   // The thread is started and not yet joined
+    LoaderThread thread;
+    uint64_t startTime;             // Nanoseconds, when StartAssetLoader() was called
+    float decodeTime;               // Milliseconds from the start to the last decode
+    float loadTime;                 // Milliseconds from the start to the last upload
+} AssetLoader;
+
+// Function declarations
+void InitAssetLoader(AssetLoader *loader);
+int AddModelJob(AssetLoader *loader, const char *fileName, MemArena *arena, OutlineMesh *outline);
+int AddTextureJob(AssetLoader *loader, const char *fileName);
+int AddSplineTrackJob(AssetLoader *loader, Track *track, const TrackControlPoint *points, int pointCount, TrackSplineSettings settings, int textureJob);
+int AddTrackJob(AssetLoader *loader, const char *fileName, Track *track, int textureJob);
+bool StartAssetLoader(AssetLoader *loader);
+bool UpdateAssetLoader(AssetLoader *loader);
+void RunAssetLoader(AssetLoader *loader);
+float GetAssetLoaderProgress(AssetLoader *loader);
+float GetAssetLoaderElapsed(const AssetLoader *loader);
+void UnloadAssetLoader(AssetLoader *loader);
+
+#endif // LOADER_H
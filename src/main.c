@@ -5,11 +5,43 @@
 #include <stdlib.h>
 #include <float.h>
 #include "ship/ship.h"
+#include "ship/pool.h"
 #include "track/track.h"
+#include "sim/timestep.h"
+#include "mesh/meshbin.h"
+#include "texture/cache.h"
+#include "perf/profile.h"
+#include "perf/governor.h"
+#include "replay/replay.h"
+#include "collision/collision.h"
+#include "render/queue.h"
+#include "render/outline.h"
+#include "render/lod.h"
+#include "fx/particles.h"
+#include "load/loader.h"
+#include "mem/budget.h"
+#include "math/fastmath.h"
 
 #define ATTR_ORBIS_WIDTH 640
 #define ATTR_ORBIS_HEIGHT 480
 
+// Simulation rate, independent of the render rate (e.g. -DSIM_TICK_RATE=120 for stability, 30 to save CPU)
+#ifndef SIM_TICK_RATE
+#define SIM_TICK_RATE 60.0f
+#endif
+#define SIM_MAX_TICKS_PER_FRAME 4   // Catch-up limit after a slow frame
+
+#define AI_RACER_COUNT 15           // CPU ships lined up behind the player
+
+// Edge of the skybox cube, which follows the camera. Under 2 * far / sqrt(3), so its corners stay
+// inside the far plane.
+#define SKYBOX_SIZE 1000.0f
+
+// What the frame-time governor trades away, from full quality down to its floor: draw distance,
+// ship detail (a 4x pixel error budget), AI outlines and particles, and the grid
+static const QualitySettings bestQuality = { RL_CULL_DISTANCE_FAR, 1.0f, 1.0f, true };
+static const QualitySettings worstQuality = { 300.0f, 4.0f, 0.0f, false };
+
 static bool done = false;
 
 static void updateController(void) {
@@ -22,9 +54,24 @@ static void updateController(void) {
 
     if(startPressed)
         done = true;
+
+#if defined(HSGP_PROFILE)
+    if(IsGamepadButtonPressed(0, GAMEPAD_BUTTON_RIGHT_FACE_UP))
+        PROFILE_SAVE_CSV(PROFILE_CSV_PATH);
+#endif
 }
 
+// Progress bar for the frames drawn while the loader thread works
+static void drawLoadingScreen(float progress, int screenWidth, int screenHeight) {
+    const int barWidth = screenWidth / 2;
+    const int barHeight = 12;
+    int x = (screenWidth - barWidth) / 2;
+    int y = screenHeight / 2;
 
+    DrawText("LOADING", x, y - 30, 20, RAYWHITE);
+    DrawRectangleLines(x - 2, y - 2, barWidth + 4, barHeight + 4, GRAY);
+    DrawRectangle(x, y, (int)(barWidth * progress), barHeight, SKYBLUE);
+}
 
 
 
@@ -43,33 +90,134 @@ int main(int argc, char** argv) {
     camera.fovy = 45.0f;                                // Camera field-of-view Y
     camera.projection = CAMERA_PERSPECTIVE;             // Camera mode type
 
-    // Shader outline = LoadShader(NULL, "/rd/outline.fs");
-    // RenderTexture2D target = LoadRenderTexture(screenWidth, screenHeight);
-
     Ship playerShip;
 
-    SetTargetFPS(60);               // Set our game to run at 60 frames-per-second
+    SetTargetFPS(60);               // Cap rendering at 60 frames-per-second, the simulation runs on its own clock
+
+    FixedTimestep timestep;
+    InitFixedTimestep(&timestep, SIM_TICK_RATE, SIM_MAX_TICKS_PER_FRAME);
+
+    FrameGovernor governor;
+    InitGovernor(&governor, 60.0f, bestQuality, worstQuality);
 
-    // Create a cube model for the skybox
+    // Create a cube model for the skybox. GenMeshCube() uploads, so it stays on this thread.
     Mesh skyboxMesh = GenMeshCube(1.0f, 1.0f, 1.0f);
     Model skyboxModel = LoadModelFromMesh(skyboxMesh);
-    Texture2D skyboxTexture = LoadTexture("/rd/gradient_skybox.png");
-    skyboxModel.materials[0].maps[MATERIAL_MAP_DIFFUSE].texture = skyboxTexture;
 
     Track gameTrack;
+    OutlineMesh shipOutline;
+
+    // Files are read and decoded on the loader thread, while this one
+    // draws the loading screen and uploads each asset as it comes in
+    AssetLoader loader;
+    InitAssetLoader(&loader);
+    int skyboxJob = AddTextureJob(&loader, "/rd/gradient_skybox.hst");
+    int shipJob = AddModelJob(&loader, "/rd/rship.hsm", &playerShip.arena, &shipOutline); // Converted from romdisk/rship.obj at build time, levels of detail and outline included
+    int shipTextureJob = AddTextureJob(&loader, "/rd/Finish_Line.hst"); // Mipmaps are generated by tools/texconv
+    int trackJob = AddTrackJob(&loader, "/rd/stadium.hsk", &gameTrack, shipTextureJob); // Baked from the stadium circuit by tools/trackbake at build time; shares the ship's upload and sampling state
+    StartAssetLoader(&loader);
+
+    bool firstFrame = true;
+    while (!UpdateAssetLoader(&loader))
+    {
+        BeginDrawing();
+            ClearBackground(BLACK);
+            drawLoadingScreen(GetAssetLoaderProgress(&loader), screenWidth, screenHeight);
+        EndDrawing();
+
+        if (firstFrame) TraceLog(LOG_INFO, "LOADER: First frame %.1f ms after loading started", GetAssetLoaderElapsed(&loader));
+        firstFrame = false;
+    }
+
+    // Without the ship or the track there's nothing to race: a missing file, or one over its
+    // memory budget, whose report is in the log
+    if (!loader.jobs[shipJob].ok || !loader.jobs[trackJob].ok)
+    {
+        TraceLog(LOG_ERROR, "LOADER: The ship or the track failed to load");
+        UnloadAssetLoader(&loader);
+        CloseWindow();
+        return 1;
+    }
 
-    Model shipModel = LoadModel("/rd/rship.obj");
-    Texture2D shipTexture = LoadTexture("/rd/Finish_Line.png");
-    GenTextureMipmaps(&shipTexture);
+    Texture2D skyboxTexture = loader.jobs[skyboxJob].texture;
+    skyboxModel.materials[0].maps[MATERIAL_MAP_DIFFUSE].texture = skyboxTexture;
+
+    ModelLods shipLods = loader.jobs[shipJob].lods;
+    Texture2D shipTexture = loader.jobs[shipTextureJob].texture;
     SetTextureFilter(shipTexture, TEXTURE_FILTER_BILINEAR);
     SetTextureWrap(shipTexture, TEXTURE_WRAP_CLAMP);
-    shipModel.materials[0].maps[MATERIAL_MAP_DIFFUSE].texture = shipTexture;
-    shipModel.materials[0].maps[MATERIAL_MAP_DIFFUSE].color = (Color){ 150, 150, 255, 255 }; // Light blue tint
-
-    Texture2D trackTexture = LoadTexture("/rd/Finish_Line.png");
-    InitTrack(&gameTrack, 500.0f, 200.0f, 100, 50.0f, 10.0f, trackTexture);
+    shipLods.levels[0].materials[0].maps[MATERIAL_MAP_DIFFUSE].texture = shipTexture; // Every level shares these materials
+    shipLods.levels[0].materials[0].maps[MATERIAL_MAP_DIFFUSE].color = (Color){ 150, 150, 255, 255 }; // Light blue tint
+
+    InitShip(&playerShip, shipLods, shipTexture);
+
+    // The player's engine trail and wall sparks, each drawn as one batch
+    ParticleEmitter exhaust, sparks;
+    InitParticleEmitter(&exhaust, SHIP_EXHAUST_PARTICLES, shipExhaustStyle, (Color){ 255, 150, 60, 140 });
+    InitParticleEmitter(&sparks, SHIP_SPARK_PARTICLES, shipSparkStyle, (Color){ 255, 240, 160, 255 });
+    AttachShipEmitters(&playerShip, &exhaust, &sparks);
+
+    // Ship outlines from the edge adjacency meshconv baked into the .hsm, in place of outline.fs
+    bool hasOutline = loader.jobs[shipJob].hasOutline;
+    OutlineBatch outlineBatch;
+    InitOutlineBatch(&outlineBatch, OUTLINE_BATCH_CAPACITY, BLACK);
+
+    UnloadAssetLoader(&loader);
+
+    LogAssetMemory(); // RAM and VRAM per category and per file, against ASSET_RAM_BUDGET and ASSET_VRAM_BUDGET
+
+    // Player on pole, facing along the track
+    Vector3 startDirection = Vector3Subtract(gameTrack.waypoints[1], gameTrack.waypoints[0]);
+    playerShip.position = Vector3Add(gameTrack.waypoints[0], (Vector3){ 0.0f, 2.0f, 0.0f });
+    playerShip.yaw = atan2f(startDirection.x, startDirection.z) * RAD2DEG;
+    playerShip.previous = (ShipPose){ playerShip.position, playerShip.rotation, playerShip.yaw };
+
+    // AI racers share the player's model
+    ShipPool aiShips;
+    InitShipPool(&aiShips, AI_RACER_COUNT, &playerShip.lods);
+    PlaceShipsOnGrid(&aiShips, gameTrack.waypoints, gameTrack.waypointCount, AI_RACER_COUNT);
+
+    // Contacts between the player and the AI. The ghost races through everyone.
+    CollisionWorld collisionWorld;
+    InitCollisionWorld(&collisionWorld, AI_RACER_COUNT + 1);
+    Ship *racers[] = { &playerShip };
+
+    // Everything in the 3D view is queued, then sorted and drawn in one go
+    RenderQueue renderQueue;
+    InitRenderQueue(&renderQueue, RENDER_QUEUE_CAPACITY);
+    RenderBackend renderBackend = GetRaylibRenderBackend();
+
+    // Last run's recording races as a ghost. Without a gamepad it drives the player's ship instead.
+    uint32_t trackHash = GetTrackSurfaceHash(&gameTrack.surface);
+    ReplayPlayer ghost;
+    bool hasGhost = LoadReplay(&ghost, REPLAY_PATH);
+    if (hasGhost && ((ghost.header.trackHash != trackHash) || (ghost.header.tickRate != (uint16_t)SIM_TICK_RATE)))
+    {
+        TraceLog(LOG_INFO, "REPLAY: Ghost was recorded on another track or tick rate, ignored");
+        UnloadReplay(&ghost);
+        hasGhost = false;
+    }
+    bool demo = hasGhost && !IsGamepadAvailable(0);
+
+    Ship ghostShip;
+    InitShip(&ghostShip, shipLods, shipTexture); // Shares the player's model, never unloaded
+    if (hasGhost) PlaceReplayShip(&ghost, demo? &playerShip : &ghostShip);
+
+    // The ghost's own AI field and contacts, started from the grid like the recorded run's, so
+    // every bump that shaped its line happens again. Never drawn; nothing here touches the race.
+    ShipPool ghostField = { 0 };
+    CollisionWorld ghostWorld = { 0 };
+    Ship *ghostRacers[] = { &ghostShip };
+    if (hasGhost && !demo)
+    {
+        InitShipPool(&ghostField, AI_RACER_COUNT, &playerShip.lods);
+        PlaceShipsOnGrid(&ghostField, gameTrack.waypoints, gameTrack.waypointCount, AI_RACER_COUNT);
+        InitCollisionWorld(&ghostWorld, AI_RACER_COUNT + 1);
+    }
 
-    InitShip(&playerShip, shipModel, shipTexture);
+    // Record this run from the start line for the next one
+    ReplayRecorder recorder;
+    bool recording = !demo && InitReplayRecorder(&recorder, &playerShip, trackHash, SIM_TICK_RATE);
     
     camera.position = (Vector3){ 0.0f, 10.0f, -25.0f }; // Fixed camera position, moved up and back
     camera.target = (Vector3){ 0.0f, 2.0f, 0.0f };      // Fixed camera target (at ship's height)
@@ -82,28 +230,67 @@ int main(int argc, char** argv) {
     // Main game loop
     while (!done)    // Detect window close button or ESC key
     {
+        BeginGovernorFrame(&governor);
+        QualitySettings quality = governor.quality;
+        exhaust.density = quality.effectDensity;
+        sparks.density = quality.effectDensity;
+
+        PROFILE_BEGIN(PROFILE_INPUT);
         updateController();
 
         // Update
         //----------------------------------------------------------------------------------
-        UpdateShip(&playerShip, gameTrack.model.meshes[0]);
+        // Input is sampled once per frame and held for every tick the frame covers
+        ShipInput input = ReadShipInput(0);
+        PROFILE_END(PROFILE_INPUT);
+
+        int ticks = AdvanceFixedTimestep(&timestep, GetFrameTime());
+        for (int i = 0; i < ticks; i++)
+        {
+            // The recorded input is what the ship is driven with, so playback reproduces the run
+            ShipInput tickInput = input;
+            if (demo) NextReplayInput(&ghost, &tickInput);
+            else if (recording) tickInput = RecordReplayTick(&recorder, input);
+
+            PROFILE_SCOPE(PROFILE_SHIP_UPDATE) UpdateShip(&playerShip, tickInput, &gameTrack.surface, timestep.tickTime);
+            if (hasGhost && !demo)
+            {
+                ShipInput ghostInput;
+                if (NextReplayInput(&ghost, &ghostInput))
+                {
+                    UpdateShip(&ghostShip, ghostInput, &gameTrack.surface, timestep.tickTime);
+                    UpdateShips(&ghostField, gameTrack.waypoints, gameTrack.waypointCount, &gameTrack.surface, timestep.tickTime);
+                    CollideShips(&ghostWorld, ghostRacers, 1, &ghostField, &gameTrack.surface);
+                }
+            }
+            PROFILE_SCOPE(PROFILE_AI_UPDATE) UpdateShips(&aiShips, gameTrack.waypoints, gameTrack.waypointCount, &gameTrack.surface, timestep.tickTime);
+            PROFILE_SCOPE(PROFILE_COLLISION) CollideShips(&collisionWorld, racers, 1, &aiShips, &gameTrack.surface);
+        }
+
+        // Render between the last two ticks
+        float alpha = GetFixedTimestepAlpha(&timestep);
+        ShipPose shipPose = GetShipPose(&playerShip, alpha);
 
         // Update camera position and target relative to the ship
+        PROFILE_BEGIN(PROFILE_CAMERA);
         float cameraDistance = 30.0f; // Distance behind the ship
         float cameraHeight = 8.0f;    // Height above the ship
 
         // Calculate new forward vector components based on current yaw
-        float forwardX = sinf(playerShip.yaw * DEG2RAD);
-        float forwardZ = cosf(playerShip.yaw * DEG2RAD);
+        float forwardX, forwardZ;
+        FastSinCos(shipPose.yaw * DEG2RAD, &forwardX, &forwardZ);
 
         // Calculate camera position based on ship's position and yaw
-        camera.position.x = playerShip.position.x - forwardX * cameraDistance;
-        camera.position.z = playerShip.position.z - forwardZ * cameraDistance;
-        camera.position.y = playerShip.position.y + cameraHeight;
+        camera.position.x = shipPose.position.x - forwardX * cameraDistance;
+        camera.position.z = shipPose.position.z - forwardZ * cameraDistance;
+        camera.position.y = shipPose.position.y + cameraHeight;
 
-        camera.target = playerShip.position; // Camera always looks at the ship
+        camera.target = shipPose.position; // Camera always looks at the ship
+        PROFILE_END(PROFILE_CAMERA);
         //----------------------------------------------------------------------------------
 
+        EndGovernorUpdate(&governor);
+
         // Draw
         //----------------------------------------------------------------------------------
         BeginDrawing();
@@ -112,33 +299,88 @@ int main(int argc, char** argv) {
 
             BeginMode3D(camera);
 
-                // Draw skybox
-                rlDisableDepthMask(); // Disable depth writes
-                rlDisableBackfaceCulling(); // Disable backface culling
-                DrawModel(skyboxModel, (Vector3){ 0.0f, 0.0f, 0.0f }, 1000.0f, WHITE); // Draw a large skybox at fixed position
-                rlEnableBackfaceCulling(); // Re-enable backface culling
-                rlEnableDepthMask(); // Re-enable depth writes
-
-                // Draw track
-                DrawTrack(&gameTrack);
-
-                DrawShip(&playerShip);
-
-                DrawGrid(10, 1.0f);
+                BeginRenderQueue(&renderQueue, camera.position);
+
+                // Skybox: a large cube around the camera, behind everything and seen from inside. Not a
+                // quality knob: its 12 triangles cost the same at any size.
+                Matrix skyboxTransform = MatrixMultiply(MatrixScale(SKYBOX_SIZE, SKYBOX_SIZE, SKYBOX_SIZE), MatrixTranslate(camera.position.x, camera.position.y, camera.position.z));
+                PROFILE_SCOPE(PROFILE_SKYBOX) QueueModel(&renderQueue, RENDER_PASS_SKY, RENDER_BLEND, &skyboxModel, skyboxTransform, WHITE);
+
+                // Track, only the chunks the camera can see
+                PROFILE_BEGIN(PROFILE_TRACK_DRAW);
+                Frustum frustum = GetCameraFrustum(camera, (float)screenWidth / screenHeight, RL_CULL_DISTANCE_NEAR, quality.drawDistance);
+                QueueTrack(&renderQueue, &gameTrack, &frustum, camera.position);
+                PROFILE_END(PROFILE_TRACK_DRAW);
+
+                // Ships at the level of detail their size on screen needs. The ghost is see-through
+                // and doesn't hide what's behind it.
+                PROFILE_BEGIN(PROFILE_SHIP_DRAW);
+                LodView lodView = GetLodView(camera, screenHeight);
+                lodView.maxError *= quality.lodBias;
+                QueueShip(&renderQueue, &playerShip, alpha, lodView);
+                QueueShips(&renderQueue, &aiShips, alpha, lodView);
+                if (hasOutline)
+                {
+                    // Player first, so a full batch drops the AI's outlines rather than its own
+                    BeginOutlineBatch(&outlineBatch);
+                    QueueOutline(&renderQueue, &outlineBatch, &shipOutline, GetShipTransform(shipPose));
+                    int aiOutlines = (int)(aiShips.count * quality.effectDensity + 0.5f);
+                    for (int i = 0; i < aiOutlines; i++) QueueOutline(&renderQueue, &outlineBatch, &shipOutline, GetShipTransform(GetPoolShipPose(&aiShips, i, alpha)));
+                }
+                if (hasGhost && !demo)
+                {
+                    ShipPose ghostPose = GetShipPose(&ghostShip, alpha);
+                    ghostShip.lod = SelectLod(&ghostShip.lods, lodView, ghostPose.position, ghostShip.lod);
+                    QueueShipModel(&renderQueue, &ghostShip.lods.levels[ghostShip.lod], ghostPose, RENDER_TRANSLUCENT | RENDER_CULL_BACK | RENDER_BLEND, Fade(WHITE, 0.5f));
+                }
+                QueueParticles(&renderQueue, &exhaust, camera);
+                QueueParticles(&renderQueue, &sparks, camera);
+                PROFILE_END(PROFILE_SHIP_DRAW);
+
+                PROFILE_SCOPE(PROFILE_RENDER_FLUSH) FlushRenderQueue(&renderQueue, &renderBackend);
+
+                if (quality.drawGrid) DrawGrid(10, 1.0f);
 
             EndMode3D();
 
             DrawFPS(10, 10);
+            PROFILE_DRAW_OVERLAY(10, 30); // Phase costs over the last PROFILE_HISTORY_FRAMES frames, Y dumps them
+
+        // Before EndDrawing(), whose wait for the 60 fps cap isn't work. Missed vsyncs show in the frame time.
+        if (EndGovernorFrame(&governor, GetFrameTime())) TraceLog(LOG_INFO, "GOVERNOR: Quality level %i after a %.1f ms load", governor.level, governor.load);
 
+        PROFILE_BEGIN(PROFILE_END_DRAWING);
         EndDrawing();
+        PROFILE_END(PROFILE_END_DRAWING);
+        PROFILE_FRAME();
         //----------------------------------------------------------------------------------
     }
 
     // De-Initialization
     //--------------------------------------------------------------------------------------
-    UnloadTexture(skyboxTexture);
+    ReleaseTexture(skyboxTexture);
     UnloadModel(skyboxModel);
     UnloadTrack(&gameTrack);
+    UnloadShipPool(&aiShips);
+    UnloadCollisionWorld(&collisionWorld);
+    if (hasGhost && !demo)
+    {
+        UnloadShipPool(&ghostField);
+        UnloadCollisionWorld(&ghostWorld);
+    }
+    UnloadRenderQueue(&renderQueue);
+    UnloadOutlineBatch(&outlineBatch);
+    UnloadParticleEmitter(&exhaust);
+    UnloadParticleEmitter(&sparks);
+    if (hasOutline) UnloadOutlineMesh(&shipOutline);
+    if (recording)
+    {
+        FinishReplayRecording(&recorder, &playerShip);
+        if (recorder.full) TraceLog(LOG_WARNING, "REPLAY: Recording was cut short, not saved");
+        else SaveReplay(&recorder, REPLAY_PATH);
+        UnloadReplayRecorder(&recorder);
+    }
+    if (hasGhost) UnloadReplay(&ghost);
     UnloadShip(&playerShip);
  
     CloseWindow();     // Close window and OpenGL context
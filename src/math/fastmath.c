@@ -0,0 +1,16 @@
+#include "fastmath.h"
+
+// Batched forms of the kernels: plain loops over contiguous arrays with no aliasing, for the
+// AI pool's phases
+
+// Angles in any unit, 'toRadians' converting them (DEG2RAD for yaws)
+void FastSinCosArray(const float *restrict angles, float toRadians, float *restrict sines, float *restrict cosines, int count)
+{
+    for (int i = 0; i < count; i++) FastSinCos(angles[i] * toRadians, &sines[i], &cosines[i]);
+}
+
+// Move every rotation 'amount' of the way towards its target
+void QuaternionSlerpFastArray(Quaternion *restrict rotations, const Quaternion *restrict targets, float amount, int count)
+{
+    for (int i = 0; i < count; i++) rotations[i] = QuaternionSlerpFast(rotations[i], targets[i], amount);
+}
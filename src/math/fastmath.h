@@ -0,0 +1,125 @@
+#ifndef FASTMATH_H
+#define FASTMATH_H
+
+#include <raylib.h>
+#include <math.h>
+
+#if defined(_arch_dreamcast)
+#include <dc/fmath.h>
+#endif
+
+// Math kernels for the per-ship hot path, inline so the update loops keep no call overhead.
+// On the Dreamcast sine/cosine is the SH4's FSCA and the inverse square root its FSRRA; the
+// host build uses a polynomial with the same call shape. bench-fastmath checks every kernel
+// against raymath and reports the worst error:
+//
+//   FastSinCos()           ~6e-8 on the host, FSCA's ~1e-5 on the Dreamcast
+//   QuaternionSlerpFast()  within 0.05 degrees of an exact slerp for any pair (raymath's own
+//                          slerp, which takes an nlerp for close pairs, is off by 0.06), and
+//                          0.001 for the small smoothing steps the ships take
+//   QuaternionFromBasis()  same result as QuaternionFromMatrix() on the equivalent matrix
+
+// Sine and cosine of one angle in radians
+static inline void FastSinCos(float radians, float *sine, float *cosine)
+{
+#if defined(_arch_dreamcast)
+    fsincosr(radians, *sine, *cosine);
+#else
+    // Reduce to [-pi/4, pi/4] around the nearest quadrant, subtracting pi/2 in three parts
+    // so the reduction stays exact for angles well past one turn (yaw accumulates)
+    float j = rintf(radians * 0.63661977f);
+    int quadrant = (int)j;
+    float x = ((radians - j * 1.5703125f) - j * 4.8375130e-4f) - j * 7.5497900e-8f;
+    float z = x * x;
+
+    float s = ((-1.9515296e-4f * z + 8.3321609e-3f) * z - 1.6666655e-1f) * z * x + x;
+    float c = ((2.4433157e-5f * z - 1.3887316e-3f) * z + 4.1666646e-2f) * z * z - 0.5f * z + 1.0f;
+
+    switch (quadrant & 3)
+    {
+        case 0: *sine = s; *cosine = c; break;
+        case 1: *sine = c; *cosine = -s; break;
+        case 2: *sine = -s; *cosine = -c; break;
+        default: *sine = -c; *cosine = s; break;
+    }
+#endif
+}
+
+static inline float FastInvSqrt(float x)
+{
+#if defined(_arch_dreamcast)
+    return frsqrt(x);
+#else
+    return 1.0f / sqrtf(x);
+#endif
+}
+
+// Rotation whose matrix has columns right, up and forward (orthonormal), without building the
+// Matrix QuaternionFromMatrix() takes. Same branches and signs as raymath.
+static inline Quaternion QuaternionFromBasis(Vector3 right, Vector3 up, Vector3 forward)
+{
+    Quaternion q;
+    float trace = right.x + up.y + forward.z;
+
+    if ((trace >= right.x - up.y - forward.z) && (trace >= up.y - right.x - forward.z) && (trace >= forward.z - right.x - up.y))
+    {
+        float w = sqrtf(trace + 1.0f) * 0.5f, mult = 0.25f / w;
+        q = (Quaternion){ (up.z - forward.y) * mult, (forward.x - right.z) * mult, (right.y - up.x) * mult, w };
+    }
+    else if ((right.x >= up.y) && (right.x >= forward.z))
+    {
+        float x = sqrtf(right.x - up.y - forward.z + 1.0f) * 0.5f, mult = 0.25f / x;
+        q = (Quaternion){ x, (right.y + up.x) * mult, (forward.x + right.z) * mult, (up.z - forward.y) * mult };
+    }
+    else if (up.y >= forward.z)
+    {
+        float y = sqrtf(up.y - right.x - forward.z + 1.0f) * 0.5f, mult = 0.25f / y;
+        q = (Quaternion){ (right.y + up.x) * mult, y, (up.z + forward.y) * mult, (forward.x - right.z) * mult };
+    }
+    else
+    {
+        float z = sqrtf(forward.z - right.x - up.y + 1.0f) * 0.5f, mult = 0.25f / z;
+        q = (Quaternion){ (forward.x + right.z) * mult, (up.z + forward.y) * mult, z, (right.y - up.x) * mult };
+    }
+
+    return q;
+}
+
+// The columns QuaternionToMatrix() would produce, for building a transform directly
+static inline void QuaternionToBasis(Quaternion q, Vector3 *right, Vector3 *up, Vector3 *forward)
+{
+    float xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+    float xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
+    float wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
+
+    *right = (Vector3){ 1.0f - 2.0f * (yy + zz), 2.0f * (xy + wz), 2.0f * (xz - wy) };
+    *up = (Vector3){ 2.0f * (xy - wz), 1.0f - 2.0f * (xx + zz), 2.0f * (yz + wx) };
+    *forward = (Vector3){ 2.0f * (xz + wy), 2.0f * (yz - wx), 1.0f - 2.0f * (xx + yy) };
+}
+
+// Slerp approximated by a normalized lerp with the amount corrected for the angle between the
+// two (a cubic in the amount, its coefficients fitted against the cosine). Takes the shorter
+// way round like QuaternionSlerp(), with no acosf/sinf and one inverse square root.
+static inline Quaternion QuaternionSlerpFast(Quaternion q1, Quaternion q2, float amount)
+{
+    float cosine = q1.x * q2.x + q1.y * q2.y + q1.z * q2.z + q1.w * q2.w;
+    float d = fabsf(cosine);
+
+    float a = 1.0904f + d * (-3.2452f + d * (3.55645f - d * 1.43519f));
+    float b = 0.848013f + d * (-1.06021f + d * 0.215638f);
+    float k = a * (amount - 0.5f) * (amount - 0.5f) + b;
+    float t = amount + amount * (amount - 0.5f) * (amount - 1.0f) * k;
+
+    float t1 = 1.0f - t;
+    float t2 = (cosine < 0.0f)? -t : t;
+    Quaternion q = { t1 * q1.x + t2 * q2.x, t1 * q1.y + t2 * q2.y, t1 * q1.z + t2 * q2.z, t1 * q1.w + t2 * q2.w };
+
+    float inverse = FastInvSqrt(q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w);
+    return (Quaternion){ q.x * inverse, q.y * inverse, q.z * inverse, q.w * inverse };
+}
+
+// Function declarations (batched, over arrays of ships)
+void FastSinCosArray(const float *angles, float toRadians, float *sines, float *cosines, int count);
+void QuaternionSlerpFastArray(Quaternion *rotations, const Quaternion *targets, float amount, int count);
+
+#endif // FASTMATH_H
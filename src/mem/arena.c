@@ -0,0 +1,73 @@
+#include "arena.h"
+#include <raylib.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+// Reserve 'capacity' bytes with one allocation. Zero capacity reserves nothing.
+bool InitArena(MemArena *arena, size_t capacity)
+{
+    *arena = (MemArena){ 0 };
+    if (capacity == 0) return true;
+
+    arena->memory = RL_MALLOC(capacity + ARENA_ALIGNMENT - 1);
+    if (arena->memory == NULL)
+    {
+        TraceLog(LOG_WARNING, "ARENA: Failed to reserve %u bytes", (unsigned)capacity);
+        return false;
+    }
+
+    uintptr_t aligned = ((uintptr_t)arena->memory + ARENA_ALIGNMENT - 1) & ~(uintptr_t)(ARENA_ALIGNMENT - 1);
+    arena->base = (unsigned char *)aligned;
+    arena->capacity = capacity;
+    return true;
+}
+
+// Next 'size' bytes, uninitialized. Running out is a sizing bug in the owner, so it is logged
+// and NULL returned rather than falling back to the heap.
+void *ArenaAlloc(MemArena *arena, size_t size)
+{
+    size_t bytes = GetArenaAllocSize(size);
+    if (arena->used + bytes > arena->capacity)
+    {
+        TraceLog(LOG_WARNING, "ARENA: Out of space (%u of %u bytes used, %u requested)", (unsigned)arena->used,
+                 (unsigned)arena->capacity, (unsigned)size);
+        return NULL;
+    }
+
+    void *memory = arena->base + arena->used;
+    arena->used += bytes;
+    arena->allocations++;
+    if (arena->used > arena->peak) arena->peak = arena->used;
+    return memory;
+}
+
+void *ArenaCalloc(MemArena *arena, size_t count, size_t size)
+{
+    void *memory = ArenaAlloc(arena, count * size);
+    if (memory != NULL) memset(memory, 0, count * size);
+    return memory;
+}
+
+// Position to rewind to, releasing everything allocated after it (load-time scratch)
+size_t GetArenaMark(const MemArena *arena)
+{
+    return arena->used;
+}
+
+void RewindArena(MemArena *arena, size_t mark)
+{
+    if (mark < arena->used) arena->used = mark;
+}
+
+// Release every allocation, keeping the block for the next level
+void ResetArena(MemArena *arena)
+{
+    arena->used = 0;
+}
+
+void UnloadArena(MemArena *arena)
+{
+    RL_FREE(arena->memory);
+    *arena = (MemArena){ 0 };
+}
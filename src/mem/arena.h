@@ -0,0 +1,35 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#define ARENA_ALIGNMENT 32          // Every allocation starts on a cache line (and PVR vertex) boundary
+
+// One block of memory handed out front to back and released all at once. Owners size it up
+// front, so loading a level costs a single heap allocation and unloading a single free.
+typedef struct MemArena {
+    void *memory;           // The single allocation
+    unsigned char *base;    // First aligned byte of it
+    size_t capacity;
+    size_t used;
+    size_t peak;            // Highest 'used' since InitArena(), scratch that was rewound included
+    int allocations;        // ArenaAlloc() calls since InitArena()
+} MemArena;
+
+// Space an allocation of 'size' bytes takes up, for owners adding up their capacity
+static inline size_t GetArenaAllocSize(size_t size)
+{
+    return (size + ARENA_ALIGNMENT - 1) & ~(size_t)(ARENA_ALIGNMENT - 1);
+}
+
+// Function declarations
+bool InitArena(MemArena *arena, size_t capacity);
+void *ArenaAlloc(MemArena *arena, size_t size);
+void *ArenaCalloc(MemArena *arena, size_t count, size_t size);
+size_t GetArenaMark(const MemArena *arena);
+void RewindArena(MemArena *arena, size_t mark);
+void ResetArena(MemArena *arena);
+void UnloadArena(MemArena *arena);
+
+#endif // ARENA_H
@@ -0,0 +1,237 @@
+#include "budget.h"
+#include <raylib.h>
+#include <stdio.h>
+#include <string.h>
+
+static AssetMemoryEntry assetEntries[ASSET_MEMORY_MAX_ENTRIES] = { 0 };
+static size_t assetPoolUsed[ASSET_MEMORY_POOL_COUNT] = { 0 };
+static size_t assetPoolPeak[ASSET_MEMORY_POOL_COUNT] = { 0 };
+static size_t assetPoolBudget[ASSET_MEMORY_POOL_COUNT] = { ASSET_RAM_BUDGET, ASSET_VRAM_BUDGET };
+static size_t assetCategoryUsed[ASSET_CATEGORY_COUNT] = { 0 };
+static size_t assetCategoryBudget[ASSET_CATEGORY_COUNT] = { 0 };    // 0: only the pool's budget applies
+static int assetFailures = 0;
+
+static const char *poolNames[ASSET_MEMORY_POOL_COUNT] = { "RAM", "VRAM" };
+
+AssetMemoryPool GetAssetCategoryPool(AssetCategory category)
+{
+    return ((category == ASSET_TEXTURE) || (category == ASSET_MESH_BUFFER))? ASSET_MEMORY_VRAM : ASSET_MEMORY_RAM;
+}
+
+const char *GetAssetCategoryName(AssetCategory category)
+{
+    static const char *names[ASSET_CATEGORY_COUNT] = { "models", "tracks", "textures", "mesh buffers" };
+    return ((category >= 0) && (category < ASSET_CATEGORY_COUNT))? names[category] : "?";
+}
+
+static AssetMemoryEntry *FindAssetEntry(AssetCategory category, uintptr_t key)
+{
+    for (int i = 0; i < ASSET_MEMORY_MAX_ENTRIES; i++)
+    {
+        AssetMemoryEntry *entry = &assetEntries[i];
+        if ((entry->bytes > 0) && (entry->category == category) && (entry->key == key)) return entry;
+    }
+    return NULL;
+}
+
+// LogAssetMemory() at any log level
+static void LogAssetMemoryAt(int logLevel)
+{
+    for (int p = 0; p < ASSET_MEMORY_POOL_COUNT; p++)
+    {
+        float share = (assetPoolBudget[p] > 0)? 100.0f * assetPoolUsed[p] / assetPoolBudget[p] : 100.0f;
+        TraceLog(logLevel, "ASSETMEM: %s %u of %u bytes (%.1f%%), peak %u", poolNames[p], (unsigned)assetPoolUsed[p], (unsigned)assetPoolBudget[p],
+                 share, (unsigned)assetPoolPeak[p]);
+    }
+
+    for (int c = 0; c < ASSET_CATEGORY_COUNT; c++)
+    {
+        if (assetCategoryUsed[c] == 0) continue;
+        TraceLog(logLevel, "ASSETMEM:   %-12s %10u bytes %s", GetAssetCategoryName((AssetCategory)c), (unsigned)assetCategoryUsed[c],
+                 poolNames[GetAssetCategoryPool((AssetCategory)c)]);
+    }
+
+    // Each tag once, where it first appears
+    for (int i = 0; i < ASSET_MEMORY_MAX_ENTRIES; i++)
+    {
+        const AssetMemoryEntry *entry = &assetEntries[i];
+        if (entry->bytes == 0) continue;
+
+        bool seen = false;
+        for (int j = 0; (j < i) && !seen; j++) seen = (assetEntries[j].bytes > 0) && (strcmp(assetEntries[j].tag, entry->tag) == 0);
+        if (seen) continue;
+
+        TraceLog(logLevel, "ASSETMEM:   [%s] %u bytes RAM, %u bytes VRAM", entry->tag, (unsigned)GetAssetTagUsed(entry->tag, ASSET_MEMORY_RAM),
+                 (unsigned)GetAssetTagUsed(entry->tag, ASSET_MEMORY_VRAM));
+    }
+}
+
+// Why 'bytes' more of 'category' can't be charged, logged with everything charged so far
+static void ReportAssetMemoryFailure(AssetCategory category, const char *tag, size_t bytes, const char *reason)
+{
+    assetFailures++;
+    TraceLog(LOG_ERROR, "ASSETMEM: [%s] Refused %u bytes of %s: %s", tag, (unsigned)bytes, GetAssetCategoryName(category), reason);
+    LogAssetMemoryAt(LOG_ERROR);
+}
+
+// Charge 'bytes' for the asset 'key' to 'category', under 'tag'. Charging a key already charged
+// to the category adds to it. False, with nothing charged and a report logged, if a budget or
+// the entry table would overflow.
+bool ReserveAssetMemory(AssetCategory category, uintptr_t key, const char *tag, size_t bytes)
+{
+    if (bytes == 0) return true;
+
+    AssetMemoryPool pool = GetAssetCategoryPool(category);
+    char reason[128];
+
+    if (assetPoolUsed[pool] + bytes > assetPoolBudget[pool])
+    {
+        snprintf(reason, sizeof(reason), "%s would reach %u of its %u byte budget", poolNames[pool],
+                 (unsigned)(assetPoolUsed[pool] + bytes), (unsigned)assetPoolBudget[pool]);
+        ReportAssetMemoryFailure(category, tag, bytes, reason);
+        return false;
+    }
+
+    if ((assetCategoryBudget[category] > 0) && (assetCategoryUsed[category] + bytes > assetCategoryBudget[category]))
+    {
+        snprintf(reason, sizeof(reason), "%s would reach %u of their %u byte budget", GetAssetCategoryName(category),
+                 (unsigned)(assetCategoryUsed[category] + bytes), (unsigned)assetCategoryBudget[category]);
+        ReportAssetMemoryFailure(category, tag, bytes, reason);
+        return false;
+    }
+
+    AssetMemoryEntry *entry = FindAssetEntry(category, key);
+    for (int i = 0; (entry == NULL) && (i < ASSET_MEMORY_MAX_ENTRIES); i++)
+    {
+        if (assetEntries[i].bytes == 0)
+        {
+            entry = &assetEntries[i];
+            entry->key = key;
+            entry->category = category;
+            strncpy(entry->tag, tag, sizeof(entry->tag) - 1);
+            entry->tag[sizeof(entry->tag) - 1] = '\0';
+        }
+    }
+
+    if (entry == NULL)
+    {
+        ReportAssetMemoryFailure(category, tag, bytes, "no free entry, raise ASSET_MEMORY_MAX_ENTRIES");
+        return false;
+    }
+
+    entry->bytes += bytes;
+    assetCategoryUsed[category] += bytes;
+    assetPoolUsed[pool] += bytes;
+    if (assetPoolUsed[pool] > assetPoolPeak[pool]) assetPoolPeak[pool] = assetPoolUsed[pool];
+    return true;
+}
+
+// Credit back everything charged for 'key' in 'category'. Assets never charged are ignored, so
+// unload functions can release whatever they're given.
+void ReleaseAssetMemory(AssetCategory category, uintptr_t key)
+{
+    AssetMemoryEntry *entry = FindAssetEntry(category, key);
+    if (entry == NULL) return;
+
+    assetCategoryUsed[category] -= entry->bytes;
+    assetPoolUsed[GetAssetCategoryPool(category)] -= entry->bytes;
+    memset(entry, 0, sizeof(*entry));
+}
+
+void SetAssetMemoryBudget(AssetMemoryPool pool, size_t bytes)
+{
+    assetPoolBudget[pool] = bytes;
+}
+
+// 0 leaves the category limited by its pool's budget alone
+void SetAssetCategoryBudget(AssetCategory category, size_t bytes)
+{
+    assetCategoryBudget[category] = bytes;
+}
+
+// Forget every charge and go back to the default budgets
+void ResetAssetMemory(void)
+{
+    memset(assetEntries, 0, sizeof(assetEntries));
+    memset(assetPoolUsed, 0, sizeof(assetPoolUsed));
+    memset(assetPoolPeak, 0, sizeof(assetPoolPeak));
+    memset(assetCategoryUsed, 0, sizeof(assetCategoryUsed));
+    memset(assetCategoryBudget, 0, sizeof(assetCategoryBudget));
+    assetPoolBudget[ASSET_MEMORY_RAM] = ASSET_RAM_BUDGET;
+    assetPoolBudget[ASSET_MEMORY_VRAM] = ASSET_VRAM_BUDGET;
+    assetFailures = 0;
+}
+
+size_t GetAssetMemoryUsed(AssetMemoryPool pool)
+{
+    return assetPoolUsed[pool];
+}
+
+size_t GetAssetMemoryPeak(AssetMemoryPool pool)
+{
+    return assetPoolPeak[pool];
+}
+
+size_t GetAssetMemoryBudget(AssetMemoryPool pool)
+{
+    return assetPoolBudget[pool];
+}
+
+size_t GetAssetCategoryUsed(AssetCategory category)
+{
+    return assetCategoryUsed[category];
+}
+
+// Bytes charged under 'tag' in 'pool', over every category
+size_t GetAssetTagUsed(const char *tag, AssetMemoryPool pool)
+{
+    size_t bytes = 0;
+    for (int i = 0; i < ASSET_MEMORY_MAX_ENTRIES; i++)
+    {
+        const AssetMemoryEntry *entry = &assetEntries[i];
+        if ((entry->bytes > 0) && (GetAssetCategoryPool(entry->category) == pool) && (strcmp(entry->tag, tag) == 0)) bytes += entry->bytes;
+    }
+    return bytes;
+}
+
+// Charges refused since the start or the last ResetAssetMemory()
+int GetAssetMemoryFailures(void)
+{
+    return assetFailures;
+}
+
+// Each pool against its budget, then each category and each tag
+void LogAssetMemory(void)
+{
+    LogAssetMemoryAt(LOG_INFO);
+}
+
+// Texels of a texture and its mip chain
+size_t GetTextureDataSize(int width, int height, int mipmaps, int format)
+{
+    size_t bytes = 0;
+    for (int i = 0; i < mipmaps; i++)
+    {
+        bytes += GetPixelDataSize(width, height, format);
+        width = (width > 1)? width / 2 : 1;
+        height = (height > 1)? height / 2 : 1;
+    }
+    return bytes;
+}
+
+// GPU copies UploadMesh() made of a mesh's arrays. None under GLdc, which draws from the
+// arrays in RAM, so this is 0 there.
+size_t GetMeshBufferSize(Mesh mesh)
+{
+    if ((mesh.vboId == NULL) || (mesh.vboId[0] == 0)) return 0;
+
+    size_t vertices = (size_t)mesh.vertexCount;
+    size_t bytes = vertices * 3 * sizeof(float);
+    if (mesh.texcoords != NULL) bytes += vertices * 2 * sizeof(float);
+    if (mesh.normals != NULL) bytes += vertices * 3 * sizeof(float);
+    if (mesh.colors != NULL) bytes += vertices * 4;
+    if (mesh.tangents != NULL) bytes += vertices * 4 * sizeof(float);
+    if (mesh.texcoords2 != NULL) bytes += vertices * 2 * sizeof(float);
+    if (mesh.indices != NULL) bytes += (size_t)mesh.triangleCount * 3 * sizeof(unsigned short);
+    return bytes;
+}
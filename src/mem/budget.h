@@ -0,0 +1,66 @@
+#ifndef BUDGET_H
+#define BUDGET_H
+
+#include <raylib.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// Asset memory accounting. Models, outlines, tracks and textures are charged to a category when
+// they're created, under a tag (their file name), and credited back when they're unloaded. Each
+// category counts against main RAM or VRAM, and both pools have a budget, as can a category. A
+// charge that would pass one is refused: nothing is recorded, the owner drops the asset as if its
+// file were missing, and the report names the budget and everything that fills it. Render thread
+// only, like the texture cache.
+
+#ifndef ASSET_RAM_BUDGET
+#define ASSET_RAM_BUDGET (8 * 1024 * 1024)  // Of 16 MB; code, KOS, stacks and per-frame pools need the rest
+#endif
+#ifndef ASSET_VRAM_BUDGET
+#define ASSET_VRAM_BUDGET (5 * 1024 * 1024) // Of 8 MB; the framebuffers and the PVR's vertex lists need the rest
+#endif
+#define ASSET_MEMORY_MAX_ENTRIES 64         // Assets charged at once
+
+typedef enum {
+    ASSET_MEMORY_RAM = 0,
+    ASSET_MEMORY_VRAM,
+    ASSET_MEMORY_POOL_COUNT
+} AssetMemoryPool;
+
+typedef enum {
+    ASSET_MODEL = 0,        // RAM: model arenas, whose vertex arrays GLdc draws from, and outlines
+    ASSET_TRACK,            // RAM: track arenas
+    ASSET_TEXTURE,          // VRAM: texels of every mip level
+    ASSET_MESH_BUFFER,      // VRAM: buffers UploadMesh() made, none where meshes draw from RAM
+    ASSET_CATEGORY_COUNT
+} AssetCategory;
+
+// One asset's charge to one category
+typedef struct AssetMemoryEntry {
+    uintptr_t key;          // The asset within its category: an arena's base, a texture id
+    AssetCategory category;
+    char tag[48];
+    size_t bytes;           // 0 marks a free entry
+} AssetMemoryEntry;
+
+// Function declarations
+bool ReserveAssetMemory(AssetCategory category, uintptr_t key, const char *tag, size_t bytes);
+void ReleaseAssetMemory(AssetCategory category, uintptr_t key);
+void SetAssetMemoryBudget(AssetMemoryPool pool, size_t bytes);
+void SetAssetCategoryBudget(AssetCategory category, size_t bytes);
+void ResetAssetMemory(void);
+
+size_t GetAssetMemoryUsed(AssetMemoryPool pool);
+size_t GetAssetMemoryPeak(AssetMemoryPool pool);
+size_t GetAssetMemoryBudget(AssetMemoryPool pool);
+size_t GetAssetCategoryUsed(AssetCategory category);
+size_t GetAssetTagUsed(const char *tag, AssetMemoryPool pool);
+int GetAssetMemoryFailures(void);
+AssetMemoryPool GetAssetCategoryPool(AssetCategory category);
+const char *GetAssetCategoryName(AssetCategory category);
+void LogAssetMemory(void);
+
+size_t GetTextureDataSize(int width, int height, int mipmaps, int format);
+size_t GetMeshBufferSize(Mesh mesh);
+
+#endif // BUDGET_H
@@ -0,0 +1,293 @@
+#include "meshbin.h"
+#include "../mem/budget.h"
+#include <raylib.h>
+#include <raymath.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+static bool RangeInFile(uint64_t offset, uint64_t size, int dataSize)
+{
+    return (offset + size) <= (uint64_t)dataSize;
+}
+
+// GetArenaAllocSize() in 64 bits, for sizes taken from a file that may not fit a size_t
+static uint64_t GetArenaAllocSize64(uint64_t size)
+{
+    return (size + ARENA_ALIGNMENT - 1) & ~(uint64_t)(ARENA_ALIGNMENT - 1);
+}
+
+// Check the first 'meshCount' meshes before anything is allocated for them: every vertex and
+// index block inside the file and every material in the table. In 64 bits, so no count from
+// the file can wrap a size. Adds up the arena space the model needs in 'arenaSize': its mesh,
+// material and mesh-material arrays plus every mesh's vertex and index arrays. False at the
+// first bad mesh.
+static bool CheckModelMeshes(const MeshBinMesh *meshes, int meshCount, int materialCount, int dataSize, uint64_t *arenaSize)
+{
+    uint64_t size = GetArenaAllocSize64((uint64_t)meshCount * sizeof(Mesh)) + GetArenaAllocSize64((uint64_t)materialCount * sizeof(Material)) +
+                    GetArenaAllocSize64((uint64_t)meshCount * sizeof(int));
+
+    for (int i = 0; i < meshCount; i++)
+    {
+        MeshBinMesh info = meshes[i];
+        uint64_t vertices = info.vertexCount, indexBytes = (uint64_t)info.triangleCount * 3 * sizeof(unsigned short);
+
+        if (!RangeInFile(info.vertexOffset, vertices * MESHBIN_VERTEX_FLOATS * sizeof(float), dataSize) ||
+            !RangeInFile(info.indexOffset, indexBytes, dataSize) || (info.material >= (uint32_t)materialCount))
+        {
+            TraceLog(LOG_WARNING, "MESHBIN: Mesh %i is out of range", i);
+            return false;
+        }
+
+        size += 2 * GetArenaAllocSize64(vertices * 3 * sizeof(float)) + GetArenaAllocSize64(vertices * 2 * sizeof(float)) + GetArenaAllocSize64(indexBytes);
+    }
+
+    *arenaSize = size;
+    return true;
+}
+
+// Read up to 'maxLevels' levels of detail from an in-memory .hsm image: header checks, then a
+// memcpy per attribute. Every level's meshes go in 'arena', sized from the tables in one
+// allocation, and share one materials array. Returns the number of levels, 0 on failure.
+// Everything that can fail is checked before the arena is reserved, so a failed load leaves
+// nothing to unload.
+static int LoadModelLevels(const unsigned char *data, int dataSize, MemArena *arena, ModelLods *lods, int maxLevels)
+{
+    memset(lods, 0, sizeof(*lods));
+
+    if ((data == NULL) || (dataSize < (int)sizeof(MeshBinHeader))) return 0;
+
+    MeshBinHeader header;
+    memcpy(&header, data, sizeof(header));
+    if ((header.magic != MESHBIN_MAGIC) || (header.version != MESHBIN_VERSION))
+    {
+        TraceLog(LOG_WARNING, "MESHBIN: Unrecognized file (magic 0x%08x, version %u)", header.magic, header.version);
+        return 0;
+    }
+
+    uint64_t tablesSize = (uint64_t)header.materialCount * sizeof(MeshBinMaterial) + (uint64_t)header.meshCount * sizeof(MeshBinMesh) +
+                          (uint64_t)header.lodCount * sizeof(MeshBinLod);
+    if ((header.lodCount > MESHBIN_MAX_LODS) || !RangeInFile(sizeof(header), tablesSize, dataSize))
+    {
+        TraceLog(LOG_WARNING, "MESHBIN: Truncated file");
+        return 0;
+    }
+
+    const MeshBinMaterial *materials = (const MeshBinMaterial *)(data + sizeof(header));
+    const MeshBinMesh *meshes = (const MeshBinMesh *)(materials + header.materialCount);
+    const MeshBinLod *levels = (const MeshBinLod *)(meshes + header.meshCount);
+
+    // A file without a level table is one level of every mesh
+    int levelCount = (header.lodCount > 0)? (int)header.lodCount : 1;
+    if (levelCount > maxLevels) levelCount = maxLevels;
+
+    uint32_t levelMeshes[MESHBIN_MAX_LODS];
+    uint64_t levelTotal = 0;
+    for (int l = 0; l < levelCount; l++)
+    {
+        levelMeshes[l] = (header.lodCount > 0)? levels[l].meshCount : header.meshCount;
+        lods->errors[l] = (header.lodCount > 0)? levels[l].error : 0.0f;
+        levelTotal += levelMeshes[l];
+    }
+    if (levelTotal > header.meshCount)
+    {
+        TraceLog(LOG_WARNING, "MESHBIN: Level table is out of range");
+        return 0;
+    }
+    if (levelMeshes[0] == 0)
+    {
+        TraceLog(LOG_WARNING, "MESHBIN: Model has no meshes");
+        return 0;
+    }
+
+    // The tables fit in the file, so these counts are well inside an int
+    int meshCount = (int)levelTotal;
+    int materialCount = (header.materialCount > 0)? (int)header.materialCount : 1;
+    uint64_t arenaSize = 0;
+    if (!CheckModelMeshes(meshes, meshCount, materialCount, dataSize, &arenaSize)) return 0;
+    if ((arenaSize > SIZE_MAX) || !InitArena(arena, (size_t)arenaSize)) return 0;
+
+    Mesh *allMeshes = (Mesh *)ArenaCalloc(arena, meshCount, sizeof(Mesh));
+    Material *allMaterials = (Material *)ArenaCalloc(arena, materialCount, sizeof(Material));
+    int *allMeshMaterials = (int *)ArenaCalloc(arena, meshCount, sizeof(int));
+
+    for (int i = 0; i < materialCount; i++)
+    {
+        allMaterials[i] = LoadMaterialDefault();
+        if (i < (int)header.materialCount)
+        {
+            const uint8_t *c = materials[i].diffuse;
+            allMaterials[i].maps[MATERIAL_MAP_DIFFUSE].color = (Color){ c[0], c[1], c[2], c[3] };
+        }
+    }
+
+    for (int i = 0; i < meshCount; i++)
+    {
+        MeshBinMesh info = meshes[i];   // Checked by CheckModelMeshes()
+        size_t indexBytes = (size_t)info.triangleCount * 3 * sizeof(unsigned short);
+
+        const float *positions = (const float *)(data + info.vertexOffset);
+        const float *texcoords = positions + info.vertexCount * 3;
+        const float *normals = texcoords + info.vertexCount * 2;
+
+        Mesh *mesh = &allMeshes[i];
+        mesh->vertexCount = info.vertexCount;
+        mesh->triangleCount = info.triangleCount;
+        mesh->vertices = (float *)ArenaAlloc(arena, info.vertexCount * 3 * sizeof(float));
+        mesh->texcoords = (float *)ArenaAlloc(arena, info.vertexCount * 2 * sizeof(float));
+        mesh->normals = (float *)ArenaAlloc(arena, info.vertexCount * 3 * sizeof(float));
+        mesh->indices = (unsigned short *)ArenaAlloc(arena, indexBytes);
+
+        memcpy(mesh->vertices, positions, info.vertexCount * 3 * sizeof(float));
+        memcpy(mesh->texcoords, texcoords, info.vertexCount * 2 * sizeof(float));
+        memcpy(mesh->normals, normals, info.vertexCount * 3 * sizeof(float));
+        memcpy(mesh->indices, data + info.indexOffset, indexBytes);
+
+        allMeshMaterials[i] = info.material;
+    }
+
+    // Each level is a Model over its slice of the mesh arrays
+    for (int l = 0, first = 0; l < levelCount; first += levelMeshes[l], l++)
+    {
+        Model *model = &lods->levels[l];
+        model->transform = MatrixIdentity();
+        model->meshCount = (int)levelMeshes[l];
+        model->materialCount = materialCount;
+        model->meshes = allMeshes + first;
+        model->materials = allMaterials;
+        model->meshMaterial = allMeshMaterials + first;
+    }
+    lods->count = levelCount;
+
+    return levelCount;
+}
+
+// Build a model from an in-memory .hsm image, its finest level of detail only. Everything but
+// the material maps goes in 'arena'; release it with UnloadModelBinary(). The meshes are not
+// uploaded, so this is safe to call off the render thread.
+Model LoadModelBinaryData(const unsigned char *data, int dataSize, MemArena *arena)
+{
+    ModelLods lods;
+    LoadModelLevels(data, dataSize, arena, &lods, 1);
+    return lods.levels[0];
+}
+
+// Every level of detail in an in-memory .hsm image, finest first, for SelectLod(). Like
+// LoadModelBinaryData(), but released with UnloadModelLods(). False if no level loaded.
+bool LoadModelLodsData(const unsigned char *data, int dataSize, MemArena *arena, ModelLods *lods)
+{
+    return (LoadModelLevels(data, dataSize, arena, lods, MESHBIN_MAX_LODS) > 0);
+}
+
+// Charge an uploaded model's arena to RAM and its GPU buffers, if it has any, to VRAM under
+// 'tag'. False, with neither charged, if that's over budget; the caller unloads the model.
+static bool ReserveModelMemory(const Model *levels, int count, const MemArena *arena, const char *tag)
+{
+    size_t buffers = 0;
+    for (int l = 0; l < count; l++)
+    {
+        for (int i = 0; i < levels[l].meshCount; i++) buffers += GetMeshBufferSize(levels[l].meshes[i]);
+    }
+
+    uintptr_t key = (uintptr_t)arena->base;
+    if (!ReserveAssetMemory(ASSET_MODEL, key, tag, arena->capacity)) return false;
+    if (!ReserveAssetMemory(ASSET_MESH_BUFFER, key, tag, buffers))
+    {
+        ReleaseAssetMemory(ASSET_MODEL, key);
+        return false;
+    }
+    return true;
+}
+
+// Load a converted .hsm model with a single file read and upload its meshes. The GL 1.1
+// path draws from the CPU arrays, so they stay in 'arena' for the model's lifetime.
+Model LoadModelBinary(const char *fileName, MemArena *arena)
+{
+    int dataSize = 0;
+    unsigned char *data = LoadFileData(fileName, &dataSize);
+
+    Model model = LoadModelBinaryData(data, dataSize, arena);
+    UnloadFileData(data);
+
+    if (model.meshCount == 0)
+    {
+        TraceLog(LOG_WARNING, "MESHBIN: [%s] Failed to load model", fileName);
+        return model;
+    }
+
+    UploadModelBinary(&model);
+    if (!ReserveModelMemory(&model, 1, arena, fileName))
+    {
+        UnloadModelBinary(model, arena);
+        return (Model){ 0 };
+    }
+
+    TraceLog(LOG_INFO, "MESHBIN: [%s] Loaded %i meshes, %i materials (%i bytes)", fileName, model.meshCount, model.materialCount, dataSize);
+
+    return model;
+}
+
+// Upload the meshes of a model built by LoadModelBinaryData(), on the render thread
+void UploadModelBinary(Model *model)
+{
+    for (int i = 0; i < model->meshCount; i++)
+    {
+        if (model->meshes[i].vertices != NULL) UploadMesh(&model->meshes[i], false);
+    }
+}
+
+void UploadModelLods(ModelLods *lods)
+{
+    for (int l = 0; l < lods->count; l++) UploadModelBinary(&lods->levels[l]);
+}
+
+// Charge levels loaded into 'arena' to the asset memory budgets, once uploaded. If they're over
+// budget nothing is charged and false returned; unload them with UnloadModelLods().
+bool ReserveModelLodsMemory(const ModelLods *lods, const MemArena *arena, const char *tag)
+{
+    return ReserveModelMemory(lods->levels, lods->count, arena, tag);
+}
+
+static void ReleaseModelMemory(const MemArena *arena)
+{
+    ReleaseAssetMemory(ASSET_MODEL, (uintptr_t)arena->base);
+    ReleaseAssetMemory(ASSET_MESH_BUFFER, (uintptr_t)arena->base);
+}
+
+static void UnloadModelMeshes(Model model)
+{
+    for (int i = 0; i < model.meshCount; i++)
+    {
+        Mesh mesh = model.meshes[i];
+        mesh.vertices = NULL;   // Arena memory, UnloadMesh() only gets the buffers
+        mesh.texcoords = NULL;
+        mesh.normals = NULL;
+        mesh.indices = NULL;
+        UnloadMesh(mesh);
+    }
+}
+
+// Unload a model loaded into 'arena': the GPU buffers and material maps raylib allocated,
+// then the arena with everything else
+void UnloadModelBinary(Model model, MemArena *arena)
+{
+    UnloadModelMeshes(model);
+    for (int i = 0; i < model.materialCount; i++) RL_FREE(model.materials[i].maps);
+
+    ReleaseModelMemory(arena);
+    UnloadArena(arena);
+}
+
+// Unload every level of detail loaded into 'arena'. The levels share their materials.
+void UnloadModelLods(ModelLods *lods, MemArena *arena)
+{
+    for (int l = 0; l < lods->count; l++) UnloadModelMeshes(lods->levels[l]);
+    if (lods->count > 0)
+    {
+        for (int i = 0; i < lods->levels[0].materialCount; i++) RL_FREE(lods->levels[0].materials[i].maps);
+    }
+
+    ReleaseModelMemory(arena);
+    UnloadArena(arena);
+    lods->count = 0;
+}
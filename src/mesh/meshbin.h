@@ -0,0 +1,25 @@
+#ifndef MESHBIN_H
+#define MESHBIN_H
+
+#include <raylib.h>
+#include "meshbin_format.h"
+#include "../mem/arena.h"
+
+// A model's levels of detail, finest first, sharing one arena and one materials array
+typedef struct ModelLods {
+    Model levels[MESHBIN_MAX_LODS];
+    float errors[MESHBIN_MAX_LODS];     // Each level's largest distance from the finest, in model units
+    int count;
+} ModelLods;
+
+// Function declarations
+Model LoadModelBinary(const char *fileName, MemArena *arena);
+Model LoadModelBinaryData(const unsigned char *data, int dataSize, MemArena *arena);
+void UploadModelBinary(Model *model);
+void UnloadModelBinary(Model model, MemArena *arena);
+bool LoadModelLodsData(const unsigned char *data, int dataSize, MemArena *arena, ModelLods *lods);
+void UploadModelLods(ModelLods *lods);
+bool ReserveModelLodsMemory(const ModelLods *lods, const MemArena *arena, const char *tag);
+void UnloadModelLods(ModelLods *lods, MemArena *arena);
+
+#endif // MESHBIN_H
@@ -0,0 +1,75 @@
+#ifndef MESHBIN_FORMAT_H
+#define MESHBIN_FORMAT_H
+
+// Binary mesh file (.hsm) written by tools/meshconv and read by LoadModelBinary().
+// Little-endian, as both the host tools and the SH4 are. Layout:
+//
+//   MeshBinHeader
+//   MeshBinMaterial[materialCount]
+//   MeshBinMesh[meshCount]
+//   MeshBinLod[lodCount]
+//   per mesh, 4-byte aligned: positions (3 floats), texcoords (2 floats) and normals
+//   (3 floats) as consecutive vertexCount-long blocks, then triangleCount * 3 indices
+//   at outlineOffset, if not 0: MeshBinOutline, then its positions (3 floats each), face
+//   planes (4 floats each) and edges (MeshBinEdge)
+//
+// Vertex blocks are planar because that is the layout raylib's Mesh uploads from. The
+// outline section is the whole model's edge adjacency for silhouette extraction (see
+// src/render/outline.h), over positions welded across materials and seams.
+//
+// The meshes are grouped by level of detail, finest first, each level taking the next
+// MeshBinLod.meshCount entries of the mesh table. All levels share the material table; the
+// outline section is the finest level's.
+
+#include <stdint.h>
+
+#define MESHBIN_MAGIC 0x4d475348u   // "HSGM"
+#define MESHBIN_VERSION 3
+#define MESHBIN_MAX_LODS 4          // Levels of detail a model may have, the finest included
+
+typedef struct MeshBinHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t materialCount;
+    uint32_t meshCount;             // Over every level of detail
+    uint32_t lodCount;
+    uint32_t outlineOffset;         // 0 when the model has no outline section
+} MeshBinHeader;
+
+typedef struct MeshBinMaterial {
+    uint8_t diffuse[4];             // RGBA from the .mtl Kd and d
+} MeshBinMaterial;
+
+typedef struct MeshBinMesh {
+    uint32_t vertexCount;
+    uint32_t triangleCount;
+    uint32_t material;              // Index into the material table
+    uint32_t vertexOffset;          // File offset of the position block
+    uint32_t indexOffset;           // File offset of the unsigned short indices
+} MeshBinMesh;
+
+typedef struct MeshBinLod {
+    uint32_t meshCount;
+    float error;                    // Largest distance from the finest level's surface, in model units
+} MeshBinLod;
+
+typedef struct MeshBinOutline {
+    uint32_t positionCount;
+    uint32_t faceCount;
+    uint32_t edgeCount;
+} MeshBinOutline;
+
+// An edge between two welded positions and the one or two faces that share it
+typedef struct MeshBinEdge {
+    uint16_t a;
+    uint16_t b;
+    uint16_t faceA;
+    uint16_t faceB;                 // MESHBIN_NO_FACE on an open boundary
+} MeshBinEdge;
+
+#define MESHBIN_NO_FACE 0xffffu
+
+// Floats of vertex data per vertex: position + texcoord + normal
+#define MESHBIN_VERTEX_FLOATS (3 + 2 + 3)
+
+#endif // MESHBIN_FORMAT_H
@@ -0,0 +1,162 @@
+#include "governor.h"
+#if defined(_arch_dreamcast)
+#include <arch/timer.h>
+#else
+#include <time.h>
+#endif
+
+static inline uint64_t GetGovernorTime(void)
+{
+#if defined(_arch_dreamcast)
+    return timer_ns_gettime64();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+void InitGovernor(FrameGovernor *governor, float targetFps, QualitySettings best, QualitySettings worst)
+{
+    *governor = (FrameGovernor){ 0 };
+    governor->best = best;
+    governor->worst = worst;
+    governor->quality = best;
+    governor->budget = 1000.0f / targetFps;
+    for (int i = 0; i < GOVERNOR_LEVELS; i++) governor->hold[i] = GOVERNOR_HOLD;
+}
+
+// Settings for a level: every knob moves evenly from best to worst, except the grid, which only
+// the best level draws
+QualitySettings GetGovernorQuality(const FrameGovernor *governor, int level)
+{
+    float t = (float)level / (GOVERNOR_LEVELS - 1);
+    const QualitySettings *best = &governor->best, *worst = &governor->worst;
+
+    QualitySettings quality;
+    quality.drawDistance = best->drawDistance + (worst->drawDistance - best->drawDistance) * t;
+    quality.lodBias = best->lodBias + (worst->lodBias - best->lodBias) * t;
+    quality.effectDensity = best->effectDensity + (worst->effectDensity - best->effectDensity) * t;
+    quality.drawGrid = (level == 0)? best->drawGrid : worst->drawGrid;
+    return quality;
+}
+
+// Mean of the window without its GOVERNOR_TRIM slowest frames
+static float GetWindowLoad(const FrameGovernor *governor)
+{
+    float slowest[GOVERNOR_TRIM] = { 0.0f };
+    float sum = 0.0f;
+
+    for (int i = 0; i < governor->windowCount; i++)
+    {
+        float load = governor->window[i];
+        sum += load;
+
+        // Insert into the few slowest, largest first
+        for (int k = 0; k < GOVERNOR_TRIM; k++)
+        {
+            if (load <= slowest[k]) continue;
+            float bumped = slowest[k];
+            slowest[k] = load;
+            load = bumped;
+        }
+    }
+
+    for (int k = 0; k < GOVERNOR_TRIM; k++) sum -= slowest[k];
+    return sum / (governor->windowCount - GOVERNOR_TRIM);
+}
+
+static void SetGovernorLevel(FrameGovernor *governor, int level)
+{
+    governor->probing = (level < governor->level);
+    governor->previousLevel = governor->level;
+    governor->previousLoad = governor->load;
+    governor->level = level;
+    governor->quality = GetGovernorQuality(governor, level);
+    governor->framesAtLevel = 0;
+    governor->windowCount = 0;
+    governor->changes++;
+}
+
+// Take one frame's times in milliseconds: its update and draw work, and the whole frame as
+// displayed (0 if unknown). Returns true when the quality level changed.
+bool UpdateGovernor(FrameGovernor *governor, float updateTime, float drawTime, float frameTime)
+{
+    float load = updateTime + drawTime;
+
+    // A missed vsync costs the whole frame, even if the time went to the GPU rather than here
+    if ((frameTime > governor->budget * GOVERNOR_MISSED_FRAME) && (frameTime > load)) load = frameTime;
+
+    governor->updateTime = updateTime;
+    governor->drawTime = drawTime;
+    governor->window[governor->windowCount++] = load;
+    governor->framesAtLevel++;
+    if (governor->windowCount < GOVERNOR_WINDOW) return false;
+
+    int level = governor->level;
+    governor->load = GetWindowLoad(governor);
+    governor->windowCount = 0;
+
+    // The first window after a change prices the step between the two levels
+    if ((governor->previousLevel != level) && (governor->load > 0.0f) && (governor->previousLoad > 0.0f))
+    {
+        if (governor->previousLevel < level) governor->stepCost[governor->previousLevel] = governor->previousLoad / governor->load;
+        else governor->stepCost[level] = governor->load / governor->previousLoad;
+    }
+    governor->previousLevel = level;
+
+    if ((governor->load > governor->budget * GOVERNOR_DROP_LOAD) && (level < GOVERNOR_LEVELS - 1))
+    {
+        // A level just stepped up to that doesn't hold is tried less often
+        if (governor->probing)
+        {
+            governor->hold[level] *= 2;
+            if (governor->hold[level] > GOVERNOR_MAX_HOLD) governor->hold[level] = GOVERNOR_MAX_HOLD;
+        }
+        SetGovernorLevel(governor, level + 1);
+        return true;
+    }
+
+    // One that held for a hold period is trusted again
+    if (governor->probing && (governor->framesAtLevel >= GOVERNOR_HOLD))
+    {
+        governor->hold[level] = GOVERNOR_HOLD;
+        governor->probing = false;
+    }
+
+    if ((governor->load < governor->budget * GOVERNOR_RAISE_LOAD) && (level > 0) && (governor->framesAtLevel >= governor->hold[level - 1]))
+    {
+        // Unpriced steps are taken on trust
+        float predicted = governor->load * governor->stepCost[level - 1];
+
+        if (predicted < governor->budget * GOVERNOR_DROP_LOAD)
+        {
+            SetGovernorLevel(governor, level - 1);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// Timing for the game loop: begin at the top of the frame, mark the end of the update, and end
+// the frame once everything is drawn but before EndDrawing(), which waits for the frame rate
+// target. 'frameTime' is GetFrameTime(), the last frame as displayed, in seconds.
+void BeginGovernorFrame(FrameGovernor *governor)
+{
+    governor->frameStart = GetGovernorTime();
+}
+
+void EndGovernorUpdate(FrameGovernor *governor)
+{
+    governor->updateEnd = GetGovernorTime();
+}
+
+bool EndGovernorFrame(FrameGovernor *governor, float frameTime)
+{
+    uint64_t now = GetGovernorTime();
+    float updateTime = (float)((governor->updateEnd - governor->frameStart) / 1000000.0);
+    float drawTime = (float)((now - governor->updateEnd) / 1000000.0);
+
+    return UpdateGovernor(governor, updateTime, drawTime, frameTime * 1000.0f);
+}
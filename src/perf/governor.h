@@ -0,0 +1,70 @@
+#ifndef GOVERNOR_H
+#define GOVERNOR_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Frame-time governor. SetTargetFPS() only caps the frame rate, it can't make an overrunning
+// frame cheaper. The governor times each frame's update and draw, keeps the last
+// GOVERNOR_WINDOW of them and steps a quality level one way or the other at most once a window:
+// down when the window's load passes GOVERNOR_DROP_LOAD of the frame budget, up when it is
+// under GOVERNOR_RAISE_LOAD. Each level sets the quality knobs between the configured best and
+// worst settings.
+//
+// Going up again is what makes a governor oscillate. Every change measures what the step costs,
+// as the ratio of the loads either side of it, and a step up is only taken if the load now times
+// that ratio fits the budget. A level stepped up to that still has to be left waits twice as
+// long before the next try.
+
+#ifndef GOVERNOR_WINDOW
+#define GOVERNOR_WINDOW 30          // Frames per load measurement, and the least between changes
+#endif
+#define GOVERNOR_TRIM 2             // Slowest frames of a window left out, so one hitch changes nothing
+#define GOVERNOR_LEVELS 9           // Quality levels, 0 the best
+#define GOVERNOR_DROP_LOAD 0.95f    // Share of the budget that steps quality down
+#define GOVERNOR_RAISE_LOAD 0.75f   // Share of the budget under which quality may step up
+#define GOVERNOR_MISSED_FRAME 1.5f  // A frame this far over budget missed a vsync, and counts whole
+#define GOVERNOR_HOLD (GOVERNOR_WINDOW * 2)         // Frames at a level before trying a better one
+#define GOVERNOR_MAX_HOLD (GOVERNOR_WINDOW * 64)
+
+// What a quality level controls
+typedef struct QualitySettings {
+    float drawDistance;     // Track culling distance
+    float lodBias;          // Scales the level of detail pixel error budget, 1 at best
+    float effectDensity;    // Share of optional effects drawn, 0 to 1
+    bool drawGrid;          // Debug grid, the first thing to go
+} QualitySettings;
+
+typedef struct FrameGovernor {
+    QualitySettings best;           // Level 0
+    QualitySettings worst;          // The last level
+    QualitySettings quality;        // Current level's settings
+    float budget;                   // Milliseconds per frame
+
+    float window[GOVERNOR_WINDOW];  // Loads of the frames at the current level, milliseconds
+    int windowCount;
+    int level;
+    int framesAtLevel;
+    float stepCost[GOVERNOR_LEVELS];    // Load at a level over the load at the next worse one, 0 if never measured
+    int hold[GOVERNOR_LEVELS];          // Frames at level + 1 before trying this one again
+    bool probing;                   // The current level was entered going up
+    int previousLevel;              // Level and load before the last change, until the step is measured
+    float previousLoad;
+    int changes;
+
+    float load;                     // Last full window's load, milliseconds
+    float updateTime;               // Last frame, milliseconds
+    float drawTime;
+    uint64_t frameStart;
+    uint64_t updateEnd;
+} FrameGovernor;
+
+// Function declarations
+void InitGovernor(FrameGovernor *governor, float targetFps, QualitySettings best, QualitySettings worst);
+void BeginGovernorFrame(FrameGovernor *governor);
+void EndGovernorUpdate(FrameGovernor *governor);
+bool EndGovernorFrame(FrameGovernor *governor, float frameTime);
+bool UpdateGovernor(FrameGovernor *governor, float updateTime, float drawTime, float frameTime);
+QualitySettings GetGovernorQuality(const FrameGovernor *governor, int level);
+
+#endif // GOVERNOR_H
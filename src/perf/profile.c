@@ -0,0 +1,171 @@
+#include "profile.h"
+
+#if defined(HSGP_PROFILE)
+
+#include <raylib.h>
+#include <stdio.h>
+#include <stdint.h>
+#if defined(_arch_dreamcast)
+#include <arch/timer.h>
+#else
+#include <time.h>
+#endif
+
+#define PROFILE_FRAME_COLUMN PROFILE_PHASE_COUNT    // History column holding the whole frame
+#define PROFILE_OVERLAY_BAR_WIDTH 200               // Pixels for one 60 Hz frame
+#define PROFILE_OVERLAY_ROW_HEIGHT 12
+#define PROFILE_OVERLAY_LABEL_WIDTH 80
+
+static const char *phaseNames[PROFILE_PHASE_COUNT + 1] = {
+    "input", "ship update", "ai update", "track query", "collision", "camera", "skybox", "track draw", "ship draw", "render flush", "end drawing", "frame"
+};
+
+static const Color phaseColors[PROFILE_PHASE_COUNT + 1] = {
+    SKYBLUE, GREEN, LIME, DARKGREEN, MAROON, YELLOW, PURPLE, ORANGE, RED, PINK, GRAY, WHITE
+};
+
+// Everything is static so timing a phase never allocates
+static uint64_t phaseStart[PROFILE_PHASE_COUNT];
+static uint32_t current[PROFILE_PHASE_COUNT];
+static uint32_t history[PROFILE_HISTORY_FRAMES][PROFILE_PHASE_COUNT + 1];  // Nanoseconds per frame
+static uint64_t frameStart = 0;
+static int historyHead = 0;     // Next row to write
+static int historyCount = 0;
+
+static inline uint64_t GetProfileTime(void)
+{
+#if defined(_arch_dreamcast)
+    return timer_ns_gettime64();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+void ProfileBegin(ProfilePhase phase)
+{
+    phaseStart[phase] = GetProfileTime();
+}
+
+void ProfileEnd(ProfilePhase phase)
+{
+    current[phase] += (uint32_t)(GetProfileTime() - phaseStart[phase]);
+}
+
+// Close the frame: store its phase times in the history and start the next one
+void ProfileFrame(void)
+{
+    uint64_t now = GetProfileTime();
+    uint32_t *row = history[historyHead];
+
+    for (int i = 0; i < PROFILE_PHASE_COUNT; i++)
+    {
+        row[i] = current[i];
+        current[i] = 0;
+    }
+    row[PROFILE_FRAME_COLUMN] = (frameStart > 0)? (uint32_t)(now - frameStart) : 0;
+    frameStart = now;
+
+    historyHead = (historyHead + 1) % PROFILE_HISTORY_FRAMES;
+    if (historyCount < PROFILE_HISTORY_FRAMES) historyCount++;
+}
+
+// Milliseconds, over the frames in the history
+static float GetColumnAverage(int column)
+{
+    if (historyCount == 0) return 0.0f;
+
+    uint64_t total = 0;
+    for (int i = 0; i < historyCount; i++) total += history[i][column];
+    return (float)total / historyCount / 1e6f;
+}
+
+static float GetColumnMax(int column)
+{
+    uint32_t max = 0;
+    for (int i = 0; i < historyCount; i++) if (history[i][column] > max) max = history[i][column];
+    return max / 1e6f;
+}
+
+float GetProfileAverage(ProfilePhase phase)
+{
+    return GetColumnAverage(phase);
+}
+
+float GetProfileMax(ProfilePhase phase)
+{
+    return GetColumnMax(phase);
+}
+
+float GetProfileFrameAverage(void)
+{
+    return GetColumnAverage(PROFILE_FRAME_COLUMN);
+}
+
+int GetProfileFrameCount(void)
+{
+    return historyCount;
+}
+
+const char *GetProfilePhaseName(ProfilePhase phase)
+{
+    return phaseNames[phase];
+}
+
+// One bar per phase for its average over the history, with a tick at its worst frame.
+// The full bar width is a 60 Hz frame.
+void DrawProfileOverlay(int posX, int posY)
+{
+    float scale = PROFILE_OVERLAY_BAR_WIDTH / (1000.0f / 60.0f);
+    int height = (PROFILE_PHASE_COUNT + 1) * PROFILE_OVERLAY_ROW_HEIGHT + 4;
+
+    DrawRectangle(posX, posY, PROFILE_OVERLAY_LABEL_WIDTH + PROFILE_OVERLAY_BAR_WIDTH + 60, height, Fade(BLACK, 0.6f));
+
+    for (int i = 0; i <= PROFILE_PHASE_COUNT; i++)
+    {
+        int y = posY + 2 + i * PROFILE_OVERLAY_ROW_HEIGHT;
+        int barX = posX + PROFILE_OVERLAY_LABEL_WIDTH;
+        float average = GetColumnAverage(i);
+
+        int barWidth = (int)(average * scale);
+        int maxX = barX + (int)(GetColumnMax(i) * scale);
+        if (barWidth > PROFILE_OVERLAY_BAR_WIDTH) barWidth = PROFILE_OVERLAY_BAR_WIDTH;
+        if (maxX > barX + PROFILE_OVERLAY_BAR_WIDTH) maxX = barX + PROFILE_OVERLAY_BAR_WIDTH;
+
+        DrawText(phaseNames[i], posX + 4, y, 10, RAYWHITE);
+        DrawRectangle(barX, y + 1, barWidth, PROFILE_OVERLAY_ROW_HEIGHT - 3, phaseColors[i]);
+        DrawRectangle(maxX, y, 1, PROFILE_OVERLAY_ROW_HEIGHT - 1, phaseColors[i]);
+        DrawText(TextFormat("%.2f", average), barX + PROFILE_OVERLAY_BAR_WIDTH + 4, y, 10, RAYWHITE);
+    }
+}
+
+// Write the history oldest frame first, one column per phase in milliseconds
+bool SaveProfileCSV(const char *fileName)
+{
+    FILE *file = fopen(fileName, "w");
+    if (file == NULL)
+    {
+        TraceLog(LOG_WARNING, "PROFILE: [%s] Failed to open file for writing", fileName);
+        return false;
+    }
+
+    fprintf(file, "frame");
+    for (int i = 0; i <= PROFILE_PHASE_COUNT; i++) fprintf(file, ",%s (ms)", phaseNames[i]);
+    fprintf(file, "\n");
+
+    int oldest = (historyHead - historyCount + PROFILE_HISTORY_FRAMES) % PROFILE_HISTORY_FRAMES;
+    for (int f = 0; f < historyCount; f++)
+    {
+        const uint32_t *row = history[(oldest + f) % PROFILE_HISTORY_FRAMES];
+        fprintf(file, "%d", f);
+        for (int i = 0; i <= PROFILE_PHASE_COUNT; i++) fprintf(file, ",%.4f", row[i] / 1e6f);
+        fprintf(file, "\n");
+    }
+
+    fclose(file);
+    TraceLog(LOG_INFO, "PROFILE: [%s] %i frames saved", fileName, historyCount);
+    return true;
+}
+
+#endif // HSGP_PROFILE
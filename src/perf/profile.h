@@ -0,0 +1,70 @@
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#include <stdbool.h>
+
+// Per-frame phase timers, compiled in with -DHSGP_PROFILE (make PROFILE=1). Without it every
+// PROFILE_ macro expands to nothing and profile.c compiles to an empty object.
+
+#define PROFILE_HISTORY_FRAMES 256  // Frames kept for the overlay and the CSV dump
+
+// Where main() writes the CSV when Y is pressed (/pc is the dcload host's filesystem)
+#ifndef PROFILE_CSV_PATH
+#if defined(_arch_dreamcast)
+#define PROFILE_CSV_PATH "/pc/hsgp_profile.csv"
+#else
+#define PROFILE_CSV_PATH "hsgp_profile.csv"
+#endif
+#endif
+
+// Timed phases. Times add up over a frame, so a phase run once per tick reports its frame total.
+typedef enum {
+    PROFILE_INPUT = 0,      // Controller polling
+    PROFILE_SHIP_UPDATE,    // UpdateShip(), including its track query
+    PROFILE_AI_UPDATE,      // UpdateShips(), including their track queries
+    PROFILE_TRACK_QUERY,    // QueryTrackSurface() calls made by the ship updates
+    PROFILE_COLLISION,      // CollideShips(), ship against ship
+    PROFILE_CAMERA,
+    PROFILE_SKYBOX,         // Queueing only, the draws are in PROFILE_RENDER_FLUSH
+    PROFILE_TRACK_DRAW,     // Culling and queueing the chunks
+    PROFILE_SHIP_DRAW,
+    PROFILE_RENDER_FLUSH,   // FlushRenderQueue(): sorting and every 3D draw
+    PROFILE_END_DRAWING,    // Mostly waiting on the PVR and the vsync
+    PROFILE_PHASE_COUNT
+} ProfilePhase;
+
+#if defined(HSGP_PROFILE)
+
+// Function declarations
+void ProfileBegin(ProfilePhase phase);
+void ProfileEnd(ProfilePhase phase);
+void ProfileFrame(void);
+float GetProfileAverage(ProfilePhase phase);
+float GetProfileMax(ProfilePhase phase);
+float GetProfileFrameAverage(void);
+int GetProfileFrameCount(void);
+const char *GetProfilePhaseName(ProfilePhase phase);
+void DrawProfileOverlay(int posX, int posY);
+bool SaveProfileCSV(const char *fileName);
+
+#define PROFILE_BEGIN(phase) ProfileBegin(phase)
+#define PROFILE_END(phase) ProfileEnd(phase)
+#define PROFILE_FRAME() ProfileFrame()
+#define PROFILE_DRAW_OVERLAY(posX, posY) DrawProfileOverlay(posX, posY)
+#define PROFILE_SAVE_CSV(fileName) SaveProfileCSV(fileName)
+
+// Times the statement or block that follows. Leaving it with break or return skips the end.
+#define PROFILE_SCOPE(phase) for (int profileScope_ = (ProfileBegin(phase), 1); profileScope_; profileScope_ = (ProfileEnd(phase), 0))
+
+#else
+
+#define PROFILE_BEGIN(phase) ((void)0)
+#define PROFILE_END(phase) ((void)0)
+#define PROFILE_FRAME() ((void)0)
+#define PROFILE_DRAW_OVERLAY(posX, posY) ((void)0)
+#define PROFILE_SAVE_CSV(fileName) ((void)0)
+#define PROFILE_SCOPE(phase)
+
+#endif // HSGP_PROFILE
+
+#endif // PROFILE_H
@@ -0,0 +1,58 @@
+#include "frustum.h"
+#include <raylib.h>
+#include <raymath.h>
+#include <math.h>
+
+static Vector4 NormalizePlane(float a, float b, float c, float d)
+{
+    float length = sqrtf(a * a + b * b + c * c);
+    return (Vector4){ a / length, b / length, c / length, d / length };
+}
+
+// Planes of the clip volume of a combined view * projection matrix (Gribb/Hartmann)
+Frustum GetMatrixFrustum(Matrix m)
+{
+    Frustum frustum;
+
+    // Rows of the matrix as it transforms column vectors: x' = m0*x + m4*y + m8*z + m12
+    Vector4 row0 = { m.m0, m.m4, m.m8, m.m12 };
+    Vector4 row1 = { m.m1, m.m5, m.m9, m.m13 };
+    Vector4 row2 = { m.m2, m.m6, m.m10, m.m14 };
+    Vector4 row3 = { m.m3, m.m7, m.m11, m.m15 };
+
+    frustum.planes[0] = NormalizePlane(row3.x + row0.x, row3.y + row0.y, row3.z + row0.z, row3.w + row0.w);
+    frustum.planes[1] = NormalizePlane(row3.x - row0.x, row3.y - row0.y, row3.z - row0.z, row3.w - row0.w);
+    frustum.planes[2] = NormalizePlane(row3.x + row1.x, row3.y + row1.y, row3.z + row1.z, row3.w + row1.w);
+    frustum.planes[3] = NormalizePlane(row3.x - row1.x, row3.y - row1.y, row3.z - row1.z, row3.w - row1.w);
+    frustum.planes[4] = NormalizePlane(row3.x + row2.x, row3.y + row2.y, row3.z + row2.z, row3.w + row2.w);
+    frustum.planes[5] = NormalizePlane(row3.x - row2.x, row3.y - row2.y, row3.z - row2.z, row3.w - row2.w);
+
+    return frustum;
+}
+
+// Same view and projection BeginMode3D() sets up for a perspective camera
+Frustum GetCameraFrustum(Camera camera, float aspect, float nearPlane, float farPlane)
+{
+    Matrix view = MatrixLookAt(camera.position, camera.target, camera.up);
+    Matrix projection = MatrixPerspective(camera.fovy * DEG2RAD, aspect, nearPlane, farPlane);
+
+    return GetMatrixFrustum(MatrixMultiply(view, projection));
+}
+
+// Conservative: false only when the box is entirely outside one plane
+bool IsBoxInFrustum(const Frustum *frustum, BoundingBox box)
+{
+    for (int i = 0; i < 6; i++)
+    {
+        Vector4 p = frustum->planes[i];
+
+        // Corner furthest along the plane normal
+        float x = (p.x >= 0.0f)? box.max.x : box.min.x;
+        float y = (p.y >= 0.0f)? box.max.y : box.min.y;
+        float z = (p.z >= 0.0f)? box.max.z : box.min.z;
+
+        if (p.x * x + p.y * y + p.z * z + p.w < 0.0f) return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,18 @@
+#ifndef FRUSTUM_H
+#define FRUSTUM_H
+
+#include <raylib.h>
+#include <stdbool.h>
+
+// View volume as six inward-facing planes (xyz = normal, w = distance): left, right,
+// bottom, top, near, far
+typedef struct Frustum {
+    Vector4 planes[6];
+} Frustum;
+
+// Function declarations
+Frustum GetMatrixFrustum(Matrix viewProjection);
+Frustum GetCameraFrustum(Camera camera, float aspect, float nearPlane, float farPlane);
+bool IsBoxInFrustum(const Frustum *frustum, BoundingBox box);
+
+#endif // FRUSTUM_H
@@ -0,0 +1,36 @@
+#include "lod.h"
+#include <raylib.h>
+#include <raymath.h>
+#include <math.h>
+
+#define LOD_MIN_DISTANCE 0.01f      // Keeps a camera inside the model from dividing by zero
+
+// Same vertical field of view BeginMode3D() projects with
+LodView GetLodView(Camera camera, int screenHeight)
+{
+    LodView view;
+    view.position = camera.position;
+    view.pixelsPerUnit = (0.5f * screenHeight) / tanf(0.5f * camera.fovy * DEG2RAD);
+    view.maxError = LOD_PIXEL_ERROR;
+    view.hysteresis = LOD_HYSTERESIS;
+    return view;
+}
+
+// Level to draw a model at 'position' with, given the one it was drawn with last ('current').
+// Levels get coarser and their errors larger, so this only walks from 'current' as far as the
+// band forces it to.
+int SelectLod(const ModelLods *lods, LodView view, Vector3 position, int current)
+{
+    if (lods->count <= 1) return 0;
+
+    int level = (current < 0)? 0 : (current >= lods->count)? lods->count - 1 : current;
+    float scale = view.pixelsPerUnit / fmaxf(Vector3Distance(view.position, position), LOD_MIN_DISTANCE);
+
+    // Finer while this level shows more error than the band allows
+    while ((level > 0) && (lods->errors[level] * scale > view.maxError * (1.0f + view.hysteresis))) level--;
+
+    // Coarser while the next level hides its error well inside the budget
+    while ((level < lods->count - 1) && (lods->errors[level + 1] * scale <= view.maxError * (1.0f - view.hysteresis))) level++;
+
+    return level;
+}
@@ -0,0 +1,32 @@
+#ifndef LOD_H
+#define LOD_H
+
+#include <raylib.h>
+#include "../mesh/meshbin.h"
+
+// Level of detail selection. Each level of a ModelLods carries the geometric error meshconv
+// measured against the finest one; projected at the model's distance that is how many pixels
+// the level can be off by on screen. The coarsest level within LOD_PIXEL_ERROR is drawn, and a
+// model only changes level once that measure leaves a band of LOD_HYSTERESIS either side of
+// the budget, so a ship sitting at a threshold doesn't flicker between two.
+
+#ifndef LOD_PIXEL_ERROR
+#define LOD_PIXEL_ERROR 1.0f        // Screen-space error budget, pixels
+#endif
+#ifndef LOD_HYSTERESIS
+#define LOD_HYSTERESIS 0.25f        // Half-width of the band around the budget, as a share of it
+#endif
+
+// What selection needs from the camera, worked out once per frame
+typedef struct LodView {
+    Vector3 position;
+    float pixelsPerUnit;        // Pixels covered by one unit at distance one
+    float maxError;             // Pixels
+    float hysteresis;
+} LodView;
+
+// Function declarations
+LodView GetLodView(Camera camera, int screenHeight);
+int SelectLod(const ModelLods *lods, LodView view, Vector3 position, int current);
+
+#endif // LOD_H
@@ -0,0 +1,176 @@
+#include "outline.h"
+#include "../mem/budget.h"
+#include <raylib.h>
+#include <raymath.h>
+#include <string.h>
+
+static bool RangeInFile(uint32_t offset, uint64_t size, int dataSize)
+{
+    return ((uint64_t)offset + size) <= (uint64_t)dataSize;
+}
+
+// Copy the outline section of an in-memory .hsm into the outline's arena, in one allocation.
+// False if the file has no section or it doesn't check out.
+bool LoadOutlineMeshData(const unsigned char *data, int dataSize, OutlineMesh *outline)
+{
+    *outline = (OutlineMesh){ 0 };
+
+    if ((data == NULL) || (dataSize < (int)sizeof(MeshBinHeader))) return false;
+
+    MeshBinHeader header;
+    memcpy(&header, data, sizeof(header));
+    if ((header.magic != MESHBIN_MAGIC) || (header.version != MESHBIN_VERSION) || (header.outlineOffset == 0)) return false;
+    if (!RangeInFile(header.outlineOffset, sizeof(MeshBinOutline), dataSize)) return false;
+
+    MeshBinOutline counts;
+    memcpy(&counts, data + header.outlineOffset, sizeof(counts));
+
+    size_t positionBytes = counts.positionCount * 3 * sizeof(float);
+    size_t planeBytes = counts.faceCount * 4 * sizeof(float);
+    size_t edgeBytes = counts.edgeCount * sizeof(OutlineEdge);
+    if (!RangeInFile(header.outlineOffset + sizeof(counts), (uint64_t)positionBytes + planeBytes + edgeBytes, dataSize))
+    {
+        TraceLog(LOG_WARNING, "OUTLINE: Truncated outline section");
+        return false;
+    }
+
+    if (!InitArena(&outline->arena, GetArenaAllocSize(positionBytes) + GetArenaAllocSize(planeBytes) + GetArenaAllocSize(edgeBytes) +
+                   GetArenaAllocSize(counts.faceCount))) return false;
+
+    const unsigned char *cursor = data + header.outlineOffset + sizeof(counts);
+    outline->positionCount = counts.positionCount;
+    outline->faceCount = counts.faceCount;
+    outline->edgeCount = counts.edgeCount;
+    outline->positions = (Vector3 *)ArenaAlloc(&outline->arena, positionBytes);
+    outline->planes = (Vector4 *)ArenaAlloc(&outline->arena, planeBytes);
+    outline->edges = (OutlineEdge *)ArenaAlloc(&outline->arena, edgeBytes);
+    outline->facing = (unsigned char *)ArenaCalloc(&outline->arena, counts.faceCount, 1);
+
+    memcpy(outline->positions, cursor, positionBytes);
+    memcpy(outline->planes, cursor + positionBytes, planeBytes);
+    memcpy(outline->edges, cursor + positionBytes + planeBytes, edgeBytes);
+
+    // The extraction trusts the indices, so check them once here
+    for (int i = 0; i < outline->edgeCount; i++)
+    {
+        OutlineEdge edge = outline->edges[i];
+        if ((edge.a >= counts.positionCount) || (edge.b >= counts.positionCount) || (edge.faceA >= counts.faceCount) ||
+            ((edge.faceB != MESHBIN_NO_FACE) && (edge.faceB >= counts.faceCount)))
+        {
+            TraceLog(LOG_WARNING, "OUTLINE: Edge %i is out of range", i);
+            UnloadOutlineMesh(outline);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool LoadOutlineMesh(const char *fileName, OutlineMesh *outline)
+{
+    int dataSize = 0;
+    unsigned char *data = LoadFileData(fileName, &dataSize);
+    bool loaded = LoadOutlineMeshData(data, dataSize, outline);
+    UnloadFileData(data);
+
+    if (loaded) TraceLog(LOG_INFO, "OUTLINE: [%s] Loaded %i edges over %i faces", fileName, outline->edgeCount, outline->faceCount);
+    else TraceLog(LOG_WARNING, "OUTLINE: [%s] No outline section", fileName);
+
+    return loaded;
+}
+
+void UnloadOutlineMesh(OutlineMesh *outline)
+{
+    ReleaseAssetMemory(ASSET_MODEL, (uintptr_t)outline->arena.base);
+    UnloadArena(&outline->arena);
+    *outline = (OutlineMesh){ 0 };
+}
+
+// Silhouette of the model placed by 'transform' seen from 'eye' (world space), as one quad per
+// edge in world space: vertices 4 per edge, indices 6 per edge counting from the first vertex.
+// Returns the edges written, at most maxEdges.
+int ExtractSilhouette(const OutlineMesh *outline, Matrix transform, Vector3 eye, UnlitVertex *vertices, unsigned short *indices, int maxEdges)
+{
+    // Facing is decided in model space, so the faces need no transforming
+    Vector3 localEye = Vector3Transform(eye, MatrixInvert(transform));
+    unsigned char *facing = outline->facing;
+
+    for (int f = 0; f < outline->faceCount; f++)
+    {
+        Vector4 plane = outline->planes[f];
+        facing[f] = (plane.x * localEye.x + plane.y * localEye.y + plane.z * localEye.z) > plane.w;
+    }
+
+    int count = 0;
+    for (int i = 0; (i < outline->edgeCount) && (count < maxEdges); i++)
+    {
+        OutlineEdge edge = outline->edges[i];
+        bool front = facing[edge.faceA];
+        bool other = (edge.faceB != MESHBIN_NO_FACE) && facing[edge.faceB];
+        if (front == other) continue;
+
+        // Widen across the edge, square to the line of sight
+        Vector3 a = Vector3Transform(outline->positions[edge.a], transform);
+        Vector3 b = Vector3Transform(outline->positions[edge.b], transform);
+        Vector3 toEye = Vector3Subtract(eye, Vector3Scale(Vector3Add(a, b), 0.5f));
+        float distance = Vector3Length(toEye);
+        Vector3 side = Vector3Scale(Vector3Normalize(Vector3CrossProduct(Vector3Subtract(b, a), toEye)), OUTLINE_HALF_WIDTH * distance);
+        Vector3 pull = Vector3Scale(toEye, OUTLINE_DEPTH_PULL);
+        a = Vector3Add(a, pull);
+        b = Vector3Add(b, pull);
+
+        UnlitVertex *v = &vertices[count * 4];
+        v[0] = (UnlitVertex){ Vector3Subtract(a, side), { 0.0f, 0.0f } };
+        v[1] = (UnlitVertex){ Vector3Add(a, side), { 0.0f, 0.0f } };
+        v[2] = (UnlitVertex){ Vector3Add(b, side), { 0.0f, 0.0f } };
+        v[3] = (UnlitVertex){ Vector3Subtract(b, side), { 0.0f, 0.0f } };
+        count++;
+    }
+
+    GenQuadIndices(indices, count);
+    return count;
+}
+
+// Room for 'capacity' edges. Without memory the batch holds none and queues no outlines.
+void InitOutlineBatch(OutlineBatch *batch, int capacity, Color color)
+{
+    *batch = (OutlineBatch){ 0 };
+    batch->material = LoadMaterialDefault();
+    batch->material.maps[MATERIAL_MAP_DIFFUSE].color = color;
+    if (!InitArena(&batch->arena, GetArenaAllocSize(capacity * 4 * sizeof(UnlitVertex)) + GetArenaAllocSize(capacity * 6 * sizeof(unsigned short)))) return;
+
+    batch->vertices = (UnlitVertex *)ArenaAlloc(&batch->arena, capacity * 4 * sizeof(UnlitVertex));
+    batch->indices = (unsigned short *)ArenaAlloc(&batch->arena, capacity * 6 * sizeof(unsigned short));
+    batch->capacity = capacity;
+}
+
+// Start a frame's outlines. The previous frame's must have been flushed.
+void BeginOutlineBatch(OutlineBatch *batch)
+{
+    batch->edgeCount = 0;
+}
+
+// Extract the model's silhouette for the queue's viewpoint and queue it with the world's
+// opaque items, unculled as the quads face either way. Returns the edges queued.
+int QueueOutline(RenderQueue *queue, OutlineBatch *batch, const OutlineMesh *outline, Matrix transform)
+{
+    int maxEdges = batch->capacity - batch->edgeCount;
+    if (maxEdges > 65536 / 4) maxEdges = 65536 / 4; // Indices are 16-bit
+
+    UnlitVertex *vertices = &batch->vertices[batch->edgeCount * 4];
+    unsigned short *indices = &batch->indices[batch->edgeCount * 6];
+    int count = ExtractSilhouette(outline, transform, queue->viewPosition, vertices, indices, maxEdges);
+    if (count == 0) return 0;
+
+    Vector3 center = { transform.m12, transform.m13, transform.m14 };
+    QueueUnlitVertices(queue, RENDER_PASS_WORLD, RENDER_DEPTH_WRITE | RENDER_BLEND, vertices, count * 4, indices, count * 6, &batch->material, center);
+    batch->edgeCount += count;
+    return count;
+}
+
+void UnloadOutlineBatch(OutlineBatch *batch)
+{
+    UnloadArena(&batch->arena);
+    RL_FREE(batch->material.maps);
+    *batch = (OutlineBatch){ 0 };
+}
@@ -0,0 +1,66 @@
+#ifndef OUTLINE_H
+#define OUTLINE_H
+
+#include <raylib.h>
+#include "queue.h"
+#include "../mesh/meshbin_format.h"
+#include "../mem/arena.h"
+
+// Silhouette outlines without a shader. tools/meshconv bakes each model's edge adjacency into
+// its .hsm; every frame QueueOutline() finds the edges between a face turned towards the eye
+// and one turned away (or an open boundary of a front face) and queues them as thin quads.
+// The cost is one plane test per face and one compare per edge, in model space.
+
+// Half the width of an outline quad as a share of its distance to the eye, so lines keep
+// about the same width on screen: 0.002 is around a pixel each side at 480 lines and 45 degrees
+#ifndef OUTLINE_HALF_WIDTH
+#define OUTLINE_HALF_WIDTH 0.002f
+#endif
+
+// Quads are pulled this share of the way to the eye so they win the depth test
+// against the faces they sit on
+#ifndef OUTLINE_DEPTH_PULL
+#define OUTLINE_DEPTH_PULL 0.004f
+#endif
+
+// Edges an OutlineBatch holds per frame, 92 bytes each
+#ifndef OUTLINE_BATCH_CAPACITY
+#define OUTLINE_BATCH_CAPACITY 4096
+#endif
+
+typedef MeshBinEdge OutlineEdge;
+
+// A model's edge adjacency, loaded from the outline section of its .hsm
+typedef struct OutlineMesh {
+    MemArena arena;             // Single allocation holding every array below
+    Vector3 *positions;         // Welded across the model's meshes
+    int positionCount;
+    Vector4 *planes;            // Per face: outward normal in xyz, facing the eye when dot(normal, eye) > w
+    int faceCount;
+    OutlineEdge *edges;
+    int edgeCount;
+    unsigned char *facing;      // Per-face scratch for the extraction
+} OutlineMesh;
+
+// Per-frame store for the quads, which the render queue references until its flush
+typedef struct OutlineBatch {
+    UnlitVertex *vertices;      // 4 per edge, texcoords unused
+    unsigned short *indices;    // 6 per edge, relative to the first vertex of each outline
+    int edgeCount;
+    int capacity;               // Edges
+    Material material;          // Flat colour on the default texture
+    MemArena arena;             // The vertices and indices
+} OutlineBatch;
+
+// Function declarations
+bool LoadOutlineMeshData(const unsigned char *data, int dataSize, OutlineMesh *outline);
+bool LoadOutlineMesh(const char *fileName, OutlineMesh *outline);
+void UnloadOutlineMesh(OutlineMesh *outline);
+int ExtractSilhouette(const OutlineMesh *outline, Matrix transform, Vector3 eye, UnlitVertex *vertices, unsigned short *indices, int maxEdges);
+
+void InitOutlineBatch(OutlineBatch *batch, int capacity, Color color);
+void BeginOutlineBatch(OutlineBatch *batch);
+int QueueOutline(RenderQueue *queue, OutlineBatch *batch, const OutlineMesh *outline, Matrix transform);
+void UnloadOutlineBatch(OutlineBatch *batch);
+
+#endif // OUTLINE_H
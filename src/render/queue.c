@@ -0,0 +1,263 @@
+#include "queue.h"
+#include <raylib.h>
+#include <raymath.h>
+#include <rlgl.h>
+#include <math.h>
+
+#define DEPTH_BITS 24
+#define DEPTH_MAX ((1u << DEPTH_BITS) - 1)
+
+// Room for 'capacity' items. Without memory the queue holds none and drops every draw.
+void InitRenderQueue(RenderQueue *queue, int capacity)
+{
+    *queue = (RenderQueue){ 0 };
+    if (!InitArena(&queue->arena, GetArenaAllocSize(capacity * sizeof(uint64_t)) + GetArenaAllocSize(capacity * sizeof(RenderItem)) +
+                   GetArenaAllocSize(capacity * sizeof(int)))) return;
+
+    queue->keys = (uint64_t *)ArenaAlloc(&queue->arena, capacity * sizeof(uint64_t));
+    queue->items = (RenderItem *)ArenaAlloc(&queue->arena, capacity * sizeof(RenderItem));
+    queue->order = (int *)ArenaAlloc(&queue->arena, capacity * sizeof(int));
+    queue->capacity = capacity;
+}
+
+// Empty the queue for a new frame seen from 'viewPosition'
+void BeginRenderQueue(RenderQueue *queue, Vector3 viewPosition)
+{
+    queue->count = 0;
+    queue->viewPosition = viewPosition;
+    queue->stats = (RenderQueueStats){ 0 };
+}
+
+// Sort key, most significant bits first:
+//   opaque:       pass (2) | 0 | state (3) | texture (32) | depth (24), near first
+//   translucent:  pass (2) | 1 | far first depth (24) | state (3) | texture (32)
+static uint64_t GetRenderKey(const RenderQueue *queue, RenderPass pass, unsigned int flags, unsigned int texture, Vector3 position)
+{
+    float depth = Vector3Distance(position, queue->viewPosition) / RENDER_DEPTH_RANGE;
+    uint64_t quantized = (depth >= 1.0f)? DEPTH_MAX : (uint64_t)(depth * DEPTH_MAX);
+    uint64_t state = flags & RENDER_STATE_MASK;
+    uint64_t key = (uint64_t)pass << 62;
+
+    if (flags & RENDER_TRANSLUCENT) key |= (1ull << 61) | ((DEPTH_MAX - quantized) << 35) | (state << 32) | texture;
+    else key |= (state << 58) | ((uint64_t)texture << 24) | quantized;
+
+    return key;
+}
+
+// Next free item, or NULL (counted as dropped) when the queue is full
+static RenderItem *AddRenderItem(RenderQueue *queue, RenderPass pass, unsigned int flags, unsigned int texture, Vector3 position)
+{
+    if (queue->count >= queue->capacity)
+    {
+        if (queue->stats.dropped++ == 0) TraceLog(LOG_WARNING, "RENDER: Queue full at %i items, dropping draws", queue->capacity);
+        return NULL;
+    }
+
+    int index = queue->count++;
+    queue->keys[index] = GetRenderKey(queue, pass, flags, texture, position);
+
+    RenderItem *item = &queue->items[index];
+    item->state = flags & RENDER_STATE_MASK;
+    item->texture = texture;
+    return item;
+}
+
+void QueueMesh(RenderQueue *queue, RenderPass pass, unsigned int flags, const Mesh *mesh, const Material *material, Matrix transform, Color tint)
+{
+    Vector3 position = { transform.m12, transform.m13, transform.m14 };
+    RenderItem *item = AddRenderItem(queue, pass, flags, material->maps[MATERIAL_MAP_DIFFUSE].texture.id, position);
+    if (item == NULL) return;
+
+    item->type = RENDER_ITEM_MESH;
+    item->mesh.mesh = mesh;
+    item->mesh.material = material;
+    item->mesh.transform = transform;
+    item->mesh.tint = tint;
+}
+
+// Every mesh of a model, placed the way DrawModelEx() would place it
+void QueueModel(RenderQueue *queue, RenderPass pass, unsigned int flags, const Model *model, Matrix transform, Color tint)
+{
+    Matrix meshTransform = MatrixMultiply(model->transform, transform);
+
+    for (int i = 0; i < model->meshCount; i++)
+    {
+        QueueMesh(queue, pass, flags, &model->meshes[i], &model->materials[model->meshMaterial[i]], meshTransform, tint);
+    }
+}
+
+// A range of unlit vertices as DrawUnlitVertices() takes it, sorted by the range's centre
+void QueueUnlitVertices(RenderQueue *queue, RenderPass pass, unsigned int flags, const UnlitVertex *vertices, int vertexCount,
+                        const unsigned short *indices, int indexCount, const Material *material, Vector3 center)
+{
+    RenderItem *item = AddRenderItem(queue, pass, flags, material->maps[MATERIAL_MAP_DIFFUSE].texture.id, center);
+    if (item == NULL) return;
+
+    item->type = RENDER_ITEM_VERTICES;
+    item->unlit.vertices = vertices;
+    item->unlit.vertexCount = vertexCount;
+    item->unlit.indices = indices;
+    item->unlit.indexCount = indexCount;
+    item->unlit.material = material;
+}
+
+// Stable, so equal keys draw in submission order. Insertion sort: items are mostly queued a
+// pass at a time and the track near to far already, so few have far to move.
+void SortRenderQueue(RenderQueue *queue)
+{
+    const uint64_t *keys = queue->keys;
+    int *order = queue->order;
+
+    for (int i = 0; i < queue->count; i++)
+    {
+        int k = i;
+        while ((k > 0) && (keys[order[k - 1]] > keys[i]))
+        {
+            order[k] = order[k - 1];
+            k--;
+        }
+        order[k] = i;
+    }
+}
+
+// Sort and draw everything queued, leaving raylib's default state behind. The backend is
+// assumed to start in that state too.
+void FlushRenderQueue(RenderQueue *queue, const RenderBackend *backend)
+{
+    RenderQueueStats *stats = &queue->stats;
+    unsigned int state = RENDER_STATE_DEFAULT;
+    unsigned int texture = 0;
+
+    SortRenderQueue(queue);
+
+    for (int i = 0; i < queue->count; i++)
+    {
+        const RenderItem *item = &queue->items[queue->order[i]];
+
+        if (item->state != state)
+        {
+            backend->SetState(backend->context, item->state, item->state ^ state);
+            state = item->state;
+            stats->stateChanges++;
+        }
+        if (item->texture != texture)
+        {
+            backend->SetTexture(backend->context, item->texture);
+            texture = item->texture;
+            stats->textureChanges++;
+        }
+
+        backend->DrawItem(backend->context, item);
+        stats->draws++;
+    }
+
+    if (state != RENDER_STATE_DEFAULT)
+    {
+        backend->SetState(backend->context, RENDER_STATE_DEFAULT, RENDER_STATE_DEFAULT ^ state);
+        stats->stateChanges++;
+    }
+
+    stats->items = queue->count;
+    queue->count = 0;
+}
+
+void UnloadRenderQueue(RenderQueue *queue)
+{
+    UnloadArena(&queue->arena);
+    *queue = (RenderQueue){ 0 };
+}
+
+//----------------------------------------------------------------------------------
+// rlgl backend
+//----------------------------------------------------------------------------------
+
+static void SetRaylibState(void *context, unsigned int state, unsigned int changed)
+{
+    rlDrawRenderBatchActive(); // Anything still batched was queued under the old state
+
+    if (changed & RENDER_DEPTH_WRITE)
+    {
+        if (state & RENDER_DEPTH_WRITE) rlEnableDepthMask();
+        else rlDisableDepthMask();
+    }
+    if (changed & RENDER_CULL_BACK)
+    {
+        if (state & RENDER_CULL_BACK) rlEnableBackfaceCulling();
+        else rlDisableBackfaceCulling();
+    }
+    if (changed & RENDER_BLEND)
+    {
+        if (state & RENDER_BLEND) rlEnableColorBlend();
+        else rlDisableColorBlend();
+    }
+}
+
+// DrawMesh() and DrawUnlitVertices() bind their own texture; the sort is what keeps
+// consecutive draws on the same one
+static void SetRaylibTexture(void *context, unsigned int id)
+{
+}
+
+static void DrawRaylibItem(void *context, const RenderItem *item)
+{
+    if (item->type == RENDER_ITEM_VERTICES)
+    {
+        DrawUnlitVertices(item->unlit.vertices, item->unlit.vertexCount, item->unlit.indices, item->unlit.indexCount, *item->unlit.material);
+        return;
+    }
+
+    // Tint the diffuse colour for this draw only, as DrawModelEx() does
+    Material material = *item->mesh.material;
+    Color color = material.maps[MATERIAL_MAP_DIFFUSE].color;
+    Color tint = item->mesh.tint;
+
+    material.maps[MATERIAL_MAP_DIFFUSE].color = (Color){ (unsigned char)((color.r * tint.r) / 255), (unsigned char)((color.g * tint.g) / 255),
+                                                         (unsigned char)((color.b * tint.b) / 255), (unsigned char)((color.a * tint.a) / 255) };
+    DrawMesh(*item->mesh.mesh, material, item->mesh.transform);
+    material.maps[MATERIAL_MAP_DIFFUSE].color = color;
+}
+
+RenderBackend GetRaylibRenderBackend(void)
+{
+    return (RenderBackend){ SetRaylibState, SetRaylibTexture, DrawRaylibItem, NULL };
+}
+
+//----------------------------------------------------------------------------------
+// Counting backend
+//----------------------------------------------------------------------------------
+
+static void SetCountedState(void *context, unsigned int state, unsigned int changed)
+{
+    RenderCounters *counters = (RenderCounters *)context;
+    if (state == counters->state) counters->redundantChanges++;
+    counters->state = state;
+    counters->stateChanges++;
+}
+
+static void SetCountedTexture(void *context, unsigned int id)
+{
+    RenderCounters *counters = (RenderCounters *)context;
+    if (id == counters->texture) counters->redundantChanges++;
+    counters->texture = id;
+    counters->textureChanges++;
+}
+
+static void DrawCountedItem(void *context, const RenderItem *item)
+{
+    RenderCounters *counters = (RenderCounters *)context;
+    if ((item->state != counters->state) || (item->texture != counters->texture)) counters->mismatchedDraws++;
+    counters->vertices += (item->type == RENDER_ITEM_MESH)? item->mesh.mesh->vertexCount : item->unlit.vertexCount;
+    counters->draws++;
+}
+
+RenderBackend GetCountingRenderBackend(RenderCounters *counters)
+{
+    return (RenderBackend){ SetCountedState, SetCountedTexture, DrawCountedItem, counters };
+}
+
+// Back to raylib's default state, nothing bound and nothing counted
+void ResetRenderCounters(RenderCounters *counters)
+{
+    *counters = (RenderCounters){ 0 };
+    counters->state = RENDER_STATE_DEFAULT;
+}
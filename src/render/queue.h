@@ -0,0 +1,128 @@
+#ifndef QUEUE_H
+#define QUEUE_H
+
+#include <raylib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "vertices.h"
+#include "../mem/arena.h"
+
+// Draws are collected through the frame and issued together by FlushRenderQueue(), sorted by
+// pass, then opaque before translucent, then state and texture so equal ones run together,
+// then depth: opaque front to back (the nearer ones fill the depth buffer first), translucent
+// back to front (the order blending needs, ahead of state and texture). A state change is only
+// made when the next item needs a different one.
+
+#ifndef RENDER_QUEUE_CAPACITY
+#define RENDER_QUEUE_CAPACITY 512   // Items a frame can queue, each ship mesh is one
+#endif
+
+// Distance the depth part of the key spans; anything further sorts as if at it
+#ifndef RENDER_DEPTH_RANGE
+#define RENDER_DEPTH_RANGE 1000.0f
+#endif
+
+// Passes are drawn in order, whatever the items in them
+typedef enum {
+    RENDER_PASS_SKY = 0,    // Behind everything, usually without depth writes
+    RENDER_PASS_WORLD,
+    RENDER_PASS_OVERLAY     // Over the world, e.g. effects
+} RenderPass;
+
+// Item flags. The first three are the fixed-function state the item is drawn with, the last
+// puts it in the pass's translucent list.
+#define RENDER_DEPTH_WRITE  0x1
+#define RENDER_CULL_BACK    0x2
+#define RENDER_BLEND        0x4     // Alpha blending
+#define RENDER_TRANSLUCENT  0x8
+
+#define RENDER_STATE_MASK (RENDER_DEPTH_WRITE | RENDER_CULL_BACK | RENDER_BLEND)
+#define RENDER_STATE_DEFAULT RENDER_STATE_MASK  // raylib's own, restored after a flush
+
+typedef enum {
+    RENDER_ITEM_MESH = 0,
+    RENDER_ITEM_VERTICES
+} RenderItemType;
+
+// One queued draw. Meshes, materials and vertices are referenced, not copied, so they have to
+// outlive the flush.
+typedef struct RenderItem {
+    RenderItemType type;
+    unsigned int state;         // RENDER_STATE_MASK bits
+    unsigned int texture;       // Diffuse texture id
+    union {
+        struct {
+            const Mesh *mesh;
+            const Material *material;
+            Matrix transform;
+            Color tint;
+        } mesh;
+        struct {
+            const UnlitVertex *vertices;
+            int vertexCount;
+            const unsigned short *indices;  // NULL for a strip
+            int indexCount;
+            const Material *material;
+        } unlit;
+    };
+} RenderItem;
+
+// What a flush asked the backend for
+typedef struct RenderQueueStats {
+    int items;
+    int draws;
+    int stateChanges;
+    int textureChanges;
+    int dropped;                // Items past the capacity, never drawn
+} RenderQueueStats;
+
+// Where a flush goes. The queue only calls SetState() and SetTexture() with a value that
+// differs from the last one; 'changed' holds the state bits that flipped.
+typedef struct RenderBackend {
+    void (*SetState)(void *context, unsigned int state, unsigned int changed);
+    void (*SetTexture)(void *context, unsigned int id);
+    void (*DrawItem)(void *context, const RenderItem *item);
+    void *context;
+} RenderBackend;
+
+// Filled by the counting backend: what a driver would have been asked to do, and how much of
+// it was wasted
+typedef struct RenderCounters {
+    unsigned int state;         // Current state and texture, as the backend last set them
+    unsigned int texture;
+    int stateChanges;
+    int textureChanges;
+    int redundantChanges;       // Calls that set what was already set
+    int draws;
+    int mismatchedDraws;        // Draws made with a state or texture other than the item's
+    long vertices;
+} RenderCounters;
+
+typedef struct RenderQueue {
+    int count;
+    int capacity;
+    RenderItem *items;          // In submission order
+    uint64_t *keys;
+    int *order;                 // Items sorted by key, after a flush
+    MemArena arena;             // Every array above
+    Vector3 viewPosition;       // Depth is measured from here
+    RenderQueueStats stats;     // Of the last flush
+} RenderQueue;
+
+// Function declarations
+void InitRenderQueue(RenderQueue *queue, int capacity);
+void BeginRenderQueue(RenderQueue *queue, Vector3 viewPosition);
+void QueueMesh(RenderQueue *queue, RenderPass pass, unsigned int flags, const Mesh *mesh, const Material *material, Matrix transform, Color tint);
+void QueueModel(RenderQueue *queue, RenderPass pass, unsigned int flags, const Model *model, Matrix transform, Color tint);
+void QueueUnlitVertices(RenderQueue *queue, RenderPass pass, unsigned int flags, const UnlitVertex *vertices, int vertexCount,
+                        const unsigned short *indices, int indexCount, const Material *material, Vector3 center);
+void SortRenderQueue(RenderQueue *queue);
+void FlushRenderQueue(RenderQueue *queue, const RenderBackend *backend);
+void UnloadRenderQueue(RenderQueue *queue);
+
+// Backends: rlgl for the game, the counting one for host runs where nothing is drawn
+RenderBackend GetRaylibRenderBackend(void);
+RenderBackend GetCountingRenderBackend(RenderCounters *counters);
+void ResetRenderCounters(RenderCounters *counters);
+
+#endif // QUEUE_H
@@ -0,0 +1,83 @@
+#include "vertices.h"
+#include <raylib.h>
+#include <rlgl.h>
+
+// Indices for 'quadCount' quads of 4 consecutive vertices each, two triangles apiece (0 1 2,
+// 0 2 3), for batches of camera-facing quads drawn as an indexed list
+void GenQuadIndices(unsigned short *indices, int quadCount)
+{
+    for (int i = 0; i < quadCount; i++)
+    {
+        unsigned short first = (unsigned short)(i * 4);
+        unsigned short *index = &indices[i * 6];
+        index[0] = first; index[1] = first + 1; index[2] = first + 2;
+        index[3] = first; index[4] = first + 2; index[5] = first + 3;
+    }
+}
+
+#if defined(_arch_dreamcast)
+#include <GL/gl.h>
+
+// Submit vertices from their CPU array in one call, with the same state DrawMesh()
+// sets up on the GL 1.1 path: a triangle strip with glDrawArrays() when 'indices' is NULL,
+// otherwise an indexed triangle list. GLdc reads the interleaved array through the stride
+// and hands strips to the PVR as they are, one vertex per vertex.
+void DrawUnlitVertices(const UnlitVertex *vertices, int vertexCount, const unsigned short *indices, int indexCount, Material material)
+{
+    Color color = material.maps[MATERIAL_MAP_DIFFUSE].color;
+
+    rlEnableTexture(material.maps[MATERIAL_MAP_DIFFUSE].texture.id);
+
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+    glVertexPointer(3, GL_FLOAT, sizeof(UnlitVertex), &vertices[0].position);
+    glTexCoordPointer(2, GL_FLOAT, sizeof(UnlitVertex), &vertices[0].texcoord);
+
+    glColor4ub(color.r, color.g, color.b, color.a);
+    if (indices == NULL) glDrawArrays(GL_TRIANGLE_STRIP, 0, vertexCount);
+    else glDrawElements(GL_TRIANGLES, indexCount, GL_UNSIGNED_SHORT, indices);
+
+    glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+
+    rlDisableTexture();
+}
+
+#else
+
+static inline void SubmitUnlitVertex(const UnlitVertex *vertex)
+{
+    rlTexCoord2f(vertex->texcoord.x, vertex->texcoord.y);
+    rlVertex3f(vertex->position.x, vertex->position.y, vertex->position.z);
+}
+
+// Other platforms expand the vertices into raylib's batch, flipping every other strip triangle
+void DrawUnlitVertices(const UnlitVertex *vertices, int vertexCount, const unsigned short *indices, int indexCount, Material material)
+{
+    Color color = material.maps[MATERIAL_MAP_DIFFUSE].color;
+
+    rlSetTexture(material.maps[MATERIAL_MAP_DIFFUSE].texture.id);
+    rlBegin(RL_TRIANGLES);
+        rlColor4ub(color.r, color.g, color.b, color.a);
+
+        if (indices != NULL)
+        {
+            for (int i = 0; i < indexCount; i++) SubmitUnlitVertex(&vertices[indices[i]]);
+        }
+        else
+        {
+            for (int i = 0; i + 2 < vertexCount; i++)
+            {
+                int a = (i % 2 == 0)? i : i + 1;
+                int b = (i % 2 == 0)? i + 1 : i;
+
+                SubmitUnlitVertex(&vertices[a]);
+                SubmitUnlitVertex(&vertices[b]);
+                SubmitUnlitVertex(&vertices[i + 2]);
+            }
+        }
+    rlEnd();
+    rlSetTexture(0);
+}
+
+#endif
@@ -0,0 +1,18 @@
+#ifndef VERTICES_H
+#define VERTICES_H
+
+#include <raylib.h>
+
+// Unlit geometry drawn straight from CPU arrays: the track's chunks, ship outlines and particle
+// quads. Position and texcoord interleaved, so a vertex is a single 20-byte read; nothing here
+// is lit, so there are no normals.
+typedef struct UnlitVertex {
+    Vector3 position;
+    Vector2 texcoord;
+} UnlitVertex;
+
+// Function declarations
+void GenQuadIndices(unsigned short *indices, int quadCount);
+void DrawUnlitVertices(const UnlitVertex *vertices, int vertexCount, const unsigned short *indices, int indexCount, Material material);
+
+#endif // VERTICES_H
@@ -0,0 +1,324 @@
+#include "replay.h"
+#include <raylib.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define REPLAY_ACCELERATE 1
+#define REPLAY_BRAKE 2
+
+static int QuantizeSteer(float steer)
+{
+    int q = (int)lroundf(steer * REPLAY_STEER_STEPS);
+    if (q > REPLAY_STEER_STEPS) q = REPLAY_STEER_STEPS;
+    if (q < -REPLAY_STEER_STEPS) q = -REPLAY_STEER_STEPS;
+    return q;
+}
+
+static ShipInput GetReplayInput(int steer, int buttons)
+{
+    ShipInput input = { 0 };
+    input.steer = (float)steer / REPLAY_STEER_STEPS;
+    input.accelerate = (buttons & REPLAY_ACCELERATE) != 0;
+    input.brake = (buttons & REPLAY_BRAKE) != 0;
+    return input;
+}
+
+// Bits the gamma code of n (n >= 1) takes
+static int GetGammaBits(uint32_t n)
+{
+    int bits = 0;
+    while ((n >> bits) > 1) bits++;
+    return bits * 2 + 1;
+}
+
+//----------------------------------------------------------------------------------
+// Recording
+//----------------------------------------------------------------------------------
+
+static void WriteBits(ReplayRecorder *recorder, uint32_t value, int count)
+{
+    unsigned char *stream = recorder->data + sizeof(ReplayHeader);
+    for (int i = 0; i < count; i++)
+    {
+        uint32_t bit = recorder->header.bitCount++;
+        if (value & (1u << i)) stream[bit >> 3] |= (unsigned char)(1u << (bit & 7));
+    }
+}
+
+// Write the run being recorded, unless it doesn't fit
+static bool FlushRun(ReplayRecorder *recorder)
+{
+    int delta = recorder->steer - recorder->lastSteer;
+    int steerBits = (delta == 0)? 1 : ((delta >= -8) && (delta <= 7))? 2 + 4 : 2 + 8;
+    uint32_t bits = steerBits + 2 + GetGammaBits(recorder->runLength);
+
+    if (recorder->header.bitCount + bits > (uint32_t)recorder->capacity * 8)
+    {
+        if (!recorder->full) TraceLog(LOG_WARNING, "REPLAY: Recording full after %u ticks", recorder->header.tickCount);
+        recorder->full = true;
+        return false;
+    }
+
+    if (delta == 0) WriteBits(recorder, 0, 1);
+    else if (steerBits == 6)
+    {
+        WriteBits(recorder, 1, 2);
+        WriteBits(recorder, (uint32_t)((delta << 1) ^ (delta >> 31)) & 0xf, 4); // Zigzag, small magnitudes first
+    }
+    else
+    {
+        WriteBits(recorder, 3, 2);
+        WriteBits(recorder, (uint32_t)recorder->steer & 0xff, 8);
+    }
+    WriteBits(recorder, (uint32_t)recorder->buttons, 2);
+
+    // Gamma: as many zeros as the length has bits after the leading one, then the bits from the top
+    int top = (GetGammaBits(recorder->runLength) - 1) / 2;
+    WriteBits(recorder, 0, top);
+    for (int i = top; i >= 0; i--) WriteBits(recorder, (recorder->runLength >> i) & 1, 1);
+
+    recorder->header.tickCount += recorder->runLength;
+    recorder->lastSteer = recorder->steer;
+    return true;
+}
+
+static ReplayShipState GetReplayShipState(const Ship *ship)
+{
+    ReplayShipState state = { { ship->position.x, ship->position.y, ship->position.z }, ship->speed, ship->yaw,
+                              { ship->rotation.x, ship->rotation.y, ship->rotation.z, ship->rotation.w }, ship->segment };
+    return state;
+}
+
+// Start recording a ship from its current state. The stream gets REPLAY_MAX_BYTES, reserved here
+// so recording never allocates.
+bool InitReplayRecorder(ReplayRecorder *recorder, const Ship *start, uint32_t trackHash, float tickRate)
+{
+    *recorder = (ReplayRecorder){ 0 };
+    recorder->data = (unsigned char *)RL_CALLOC(sizeof(ReplayHeader) + REPLAY_MAX_BYTES, 1);
+    if (recorder->data == NULL) return false;
+
+    recorder->capacity = REPLAY_MAX_BYTES;
+    recorder->header.magic = REPLAY_MAGIC;
+    recorder->header.version = REPLAY_VERSION;
+    recorder->header.tickRate = (uint16_t)tickRate;
+    recorder->header.trackHash = trackHash;
+    recorder->header.start = GetReplayShipState(start);
+    return true;
+}
+
+// Record one tick. Returns the input as it will play back (steer quantized), which is what the
+// recorded ship must be updated with for the replay to match.
+ShipInput RecordReplayTick(ReplayRecorder *recorder, ShipInput input)
+{
+    int steer = QuantizeSteer(input.steer);
+    int buttons = (input.accelerate? REPLAY_ACCELERATE : 0) | (input.brake? REPLAY_BRAKE : 0);
+
+    if (!recorder->full)
+    {
+        if ((recorder->runLength > 0) && ((steer != recorder->steer) || (buttons != recorder->buttons)))
+        {
+            FlushRun(recorder);
+            recorder->runLength = 0;
+        }
+
+        recorder->steer = steer;
+        recorder->buttons = buttons;
+        recorder->runLength++;
+    }
+
+    return GetReplayInput(steer, buttons);
+}
+
+// Write the last run and the state the ship ended in. 'final' is the ship after the last
+// tick that made it into the recording.
+void FinishReplayRecording(ReplayRecorder *recorder, const Ship *final)
+{
+    if (!recorder->full && (recorder->runLength > 0)) FlushRun(recorder);
+    recorder->runLength = 0;
+    recorder->header.finalHash = GetShipStateHash(final);
+    memcpy(recorder->data, &recorder->header, sizeof(ReplayHeader));
+}
+
+// Bytes SaveReplay() writes
+int GetReplaySize(const ReplayRecorder *recorder)
+{
+    return (int)sizeof(ReplayHeader) + (int)((recorder->header.bitCount + 7) / 8);
+}
+
+bool SaveReplay(const ReplayRecorder *recorder, const char *fileName)
+{
+    if (!SaveFileData(fileName, recorder->data, GetReplaySize(recorder))) return false;
+
+    TraceLog(LOG_INFO, "REPLAY: [%s] %u ticks saved (%i bytes)", fileName, recorder->header.tickCount, GetReplaySize(recorder));
+    return true;
+}
+
+void UnloadReplayRecorder(ReplayRecorder *recorder)
+{
+    RL_FREE(recorder->data);
+    *recorder = (ReplayRecorder){ 0 };
+}
+
+//----------------------------------------------------------------------------------
+// Playback
+//----------------------------------------------------------------------------------
+
+static uint32_t ReadBits(ReplayPlayer *player, int count)
+{
+    const unsigned char *stream = player->data + sizeof(ReplayHeader);
+    uint32_t value = 0;
+    for (int i = 0; i < count; i++)
+    {
+        uint32_t bit = player->readBit++;
+        value |= (uint32_t)((stream[bit >> 3] >> (bit & 7)) & 1) << i;
+    }
+    return value;
+}
+
+// Whether 'count' more bits are left in the stream
+static bool HasBits(const ReplayPlayer *player, uint32_t count)
+{
+    return player->readBit + count <= player->header.bitCount;
+}
+
+// Decode the next run. False at the end of the stream or if it is malformed; every field is
+// checked against the stream's end before it's read, so a damaged file never reads past it.
+static bool ReadRun(ReplayPlayer *player)
+{
+    if (!HasBits(player, 4)) return false;
+
+    if (ReadBits(player, 1) != 0)
+    {
+        if (ReadBits(player, 1) == 0)
+        {
+            if (!HasBits(player, 4)) return false;
+            uint32_t zigzag = ReadBits(player, 4);
+            player->steer += (int)(zigzag >> 1) ^ -(int)(zigzag & 1);
+        }
+        else
+        {
+            if (!HasBits(player, 8)) return false;
+            player->steer = (int8_t)ReadBits(player, 8);
+        }
+    }
+    if (!HasBits(player, 2)) return false;
+    int buttons = (int)ReadBits(player, 2);
+
+    int top = 0;
+    while (HasBits(player, 1) && (ReadBits(player, 1) == 0)) top++;
+    if ((top > 31) || !HasBits(player, top)) return false;
+
+    uint32_t length = 1;
+    for (int i = 0; i < top; i++) length = (length << 1) | ReadBits(player, 1);
+
+    player->remaining = length;
+    player->input = GetReplayInput(player->steer, buttons);
+    return true;
+}
+
+// Take over a recording image, checking the header and that the stream fits in it
+bool LoadReplayData(ReplayPlayer *player, const unsigned char *data, int dataSize)
+{
+    *player = (ReplayPlayer){ 0 };
+    if ((data == NULL) || (dataSize < (int)sizeof(ReplayHeader))) return false;
+
+    ReplayHeader header;
+    memcpy(&header, data, sizeof(header));
+    if ((header.magic != REPLAY_MAGIC) || (header.version != REPLAY_VERSION) ||
+        ((uint64_t)sizeof(ReplayHeader) + (header.bitCount + 7ull) / 8 > (uint64_t)dataSize))
+    {
+        TraceLog(LOG_WARNING, "REPLAY: Unrecognized or truncated recording");
+        return false;
+    }
+
+    player->data = (unsigned char *)RL_MALLOC(dataSize);
+    memcpy(player->data, data, dataSize);
+    player->dataSize = dataSize;
+    player->header = header;
+    RestartReplay(player);
+    return true;
+}
+
+bool LoadReplay(ReplayPlayer *player, const char *fileName)
+{
+    *player = (ReplayPlayer){ 0 };
+    if (!FileExists(fileName)) return false;
+
+    int dataSize = 0;
+    unsigned char *data = LoadFileData(fileName, &dataSize);
+    bool loaded = LoadReplayData(player, data, dataSize);
+    UnloadFileData(data);
+
+    if (loaded) TraceLog(LOG_INFO, "REPLAY: [%s] %u ticks loaded (%i bytes)", fileName, player->header.tickCount, dataSize);
+    return loaded;
+}
+
+void RestartReplay(ReplayPlayer *player)
+{
+    player->readBit = 0;
+    player->remaining = 0;
+    player->tick = 0;
+    player->steer = 0;
+    player->input = (ShipInput){ 0 };
+}
+
+// Put a ship in the state the recording starts from
+void PlaceReplayShip(const ReplayPlayer *player, Ship *ship)
+{
+    const ReplayShipState *s = &player->header.start;
+    ship->position = (Vector3){ s->position[0], s->position[1], s->position[2] };
+    ship->speed = s->speed;
+    ship->yaw = s->yaw;
+    ship->rotation = (Quaternion){ s->rotation[0], s->rotation[1], s->rotation[2], s->rotation[3] };
+    ship->segment = s->segment;
+    ship->previous = (ShipPose){ ship->position, ship->rotation, ship->yaw };
+}
+
+// Input for the next tick. False once every recorded tick has been played.
+bool NextReplayInput(ReplayPlayer *player, ShipInput *input)
+{
+    if (player->tick >= player->header.tickCount) return false;
+    if ((player->remaining == 0) && !ReadRun(player))
+    {
+        player->tick = player->header.tickCount; // Malformed, stop here
+        return false;
+    }
+
+    player->remaining--;
+    player->tick++;
+    *input = player->input;
+    return true;
+}
+
+void UnloadReplay(ReplayPlayer *player)
+{
+    RL_FREE(player->data);
+    *player = (ReplayPlayer){ 0 };
+}
+
+//----------------------------------------------------------------------------------
+// Hashes
+//----------------------------------------------------------------------------------
+
+// FNV-1a over raw bytes, so any bit of difference shows
+static uint32_t HashBytes(uint32_t hash, const void *data, size_t size)
+{
+    const unsigned char *bytes = (const unsigned char *)data;
+    for (size_t i = 0; i < size; i++) hash = (hash ^ bytes[i]) * 16777619u;
+    return hash;
+}
+
+uint32_t GetShipStateHash(const Ship *ship)
+{
+    ReplayShipState state = GetReplayShipState(ship);
+    return HashBytes(2166136261u, &state, sizeof(state));
+}
+
+// Identifies the track a recording was made on, from the geometry the ships drive over
+uint32_t GetTrackSurfaceHash(const TrackSurface *surface)
+{
+    uint32_t hash = HashBytes(2166136261u, &surface->segmentCount, sizeof(surface->segmentCount));
+    for (int i = 0; i < surface->segmentCount; i++) hash = HashBytes(hash, surface->segments[i].corners, sizeof(surface->segments[i].corners));
+    return hash;
+}
@@ -0,0 +1,100 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "../ship/ship.h"
+
+// Per-tick ship inputs recorded as a bit-packed run-length stream, for ghosts and for replaying
+// a fixed workload. UpdateShip() is deterministic, so the same inputs from the same start state
+// reproduce the run exactly on the same build; the file carries a hash of the final state to
+// check that. Layout of a .hsr file (little-endian):
+//
+//   ReplayHeader
+//   bit stream, LSB first, one entry per run of identical inputs:
+//     steer      '0' same as the previous run, '10' + 4-bit zigzag delta (-8..7),
+//                '11' + 8-bit absolute (steer quantized to -127..127)
+//     buttons    2 bits, accelerate then brake
+//     length     ticks in the run, Elias gamma coded
+
+#define REPLAY_MAGIC 0x52475348u    // "HSGR"
+#define REPLAY_VERSION 1
+#define REPLAY_STEER_STEPS 127      // Steer resolution each side of centre
+
+// Largest stream a recording may grow to, 16 KB is 32 of a VMU's 200 blocks
+#ifndef REPLAY_MAX_BYTES
+#define REPLAY_MAX_BYTES 16384
+#endif
+
+// Where the game keeps its ghost (/vmu/a1 is the memory card in the first controller's slot)
+#ifndef REPLAY_PATH
+#if defined(_arch_dreamcast)
+#define REPLAY_PATH "/vmu/a1/HSGPGHST"
+#else
+#define REPLAY_PATH "hsgp_ghost.hsr"
+#endif
+#endif
+
+// Everything UpdateShip() reads from the ship
+typedef struct ReplayShipState {
+    float position[3];
+    float speed;
+    float yaw;
+    float rotation[4];
+    int32_t segment;
+} ReplayShipState;
+
+typedef struct ReplayHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t tickRate;          // Ticks per second the inputs were recorded at
+    uint32_t tickCount;
+    uint32_t bitCount;          // Length of the stream that follows
+    uint32_t trackHash;         // GetTrackSurfaceHash() of the track it was recorded on
+    uint32_t finalHash;         // GetShipStateHash() after the last tick
+    ReplayShipState start;
+} ReplayHeader;
+
+// Recording in progress. The stream is written behind the header so saving is one write.
+typedef struct ReplayRecorder {
+    ReplayHeader header;
+    unsigned char *data;        // Header then stream, one allocation
+    int capacity;               // Bytes reserved for the stream
+    int steer;                  // Quantized input of the run being recorded
+    int buttons;
+    uint32_t runLength;         // Ticks in that run, 0 before the first tick
+    int lastSteer;              // Steer of the last run written, for delta coding
+    bool full;                  // Ran out of space, later ticks are dropped
+} ReplayRecorder;
+
+// Playback of a loaded recording
+typedef struct ReplayPlayer {
+    ReplayHeader header;
+    unsigned char *data;        // Whole file
+    int dataSize;
+    uint32_t readBit;           // Position in the stream
+    uint32_t remaining;         // Ticks left in the current run
+    uint32_t tick;
+    int steer;
+    ShipInput input;            // Input of the current run
+} ReplayPlayer;
+
+// Function declarations
+bool InitReplayRecorder(ReplayRecorder *recorder, const Ship *start, uint32_t trackHash, float tickRate);
+ShipInput RecordReplayTick(ReplayRecorder *recorder, ShipInput input);
+void FinishReplayRecording(ReplayRecorder *recorder, const Ship *final);
+int GetReplaySize(const ReplayRecorder *recorder);
+bool SaveReplay(const ReplayRecorder *recorder, const char *fileName);
+void UnloadReplayRecorder(ReplayRecorder *recorder);
+
+bool LoadReplay(ReplayPlayer *player, const char *fileName);
+bool LoadReplayData(ReplayPlayer *player, const unsigned char *data, int dataSize);
+void RestartReplay(ReplayPlayer *player);
+void PlaceReplayShip(const ReplayPlayer *player, Ship *ship);
+bool NextReplayInput(ReplayPlayer *player, ShipInput *input);
+void UnloadReplay(ReplayPlayer *player);
+
+uint32_t GetShipStateHash(const Ship *ship);
+uint32_t GetTrackSurfaceHash(const TrackSurface *surface);
+
+#endif // REPLAY_H
@@ -0,0 +1,20 @@
+#include "input.h"
+#include <raylib.h>
+#include <math.h>
+
+ShipInput ReadShipInput(int gamepad)
+{
+    ShipInput input = { 0 };
+
+    // Read analog stick input for steering
+    input.steer = GetGamepadAxisMovement(gamepad, GAMEPAD_AXIS_LEFT_X); // Assuming left stick X-axis
+
+    // Apply deadzone to the steering input
+    float deadzone = 0.1f; // Adjust this value as needed
+    if (fabsf(input.steer) < deadzone) input.steer = 0.0f;
+
+    input.accelerate = IsGamepadButtonDown(gamepad, GAMEPAD_BUTTON_RIGHT_FACE_DOWN); // Assuming A button is RIGHT_FACE_DOWN
+    input.brake = IsGamepadButtonDown(gamepad, GAMEPAD_BUTTON_RIGHT_FACE_LEFT); // Assuming B button is RIGHT_FACE_LEFT
+
+    return input;
+}
@@ -0,0 +1,16 @@
+#ifndef INPUT_H
+#define INPUT_H
+
+#include <stdbool.h>
+
+// Controls for one ship for one update, so the simulation never touches the gamepad
+typedef struct ShipInput {
+    float steer;        // Left stick X after the deadzone, -1 to 1
+    bool accelerate;    // A button
+    bool brake;         // B button
+} ShipInput;
+
+// Function declarations
+ShipInput ReadShipInput(int gamepad);
+
+#endif // INPUT_H
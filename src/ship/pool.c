@@ -0,0 +1,246 @@
+#include "pool.h"
+#include <raylib.h>
+#include <raymath.h>
+#include <stdlib.h>
+#include <math.h>
+#include "../perf/profile.h"
+#include "../collision/collision.h"
+#include "../math/fastmath.h"
+
+#define POOL_LOOKAHEAD 40.0f        // AI aims for the first waypoint at least this far away
+#define POOL_STEER_GAIN 3.0f        // Stick deflection per unit of sideways error
+#define POOL_LIFT_THRESHOLD 0.5f    // Coast instead of accelerating when steering harder than this
+#define POOL_TURN_SPEED 2.0f        // Same handling as the player's ship, per reference frame
+#define POOL_ACCELERATION 0.05f
+#define POOL_COAST 0.02f
+#define POOL_HOVER_HEIGHT SHIP_HOVER_HEIGHT
+
+#define POOL_GRID_ROW_SPACING 24.0f // Distance between grid rows along the track
+#define POOL_GRID_LANE_OFFSET 30.0f // Sideways offset of the two staggered lanes
+
+// Room for 'capacity' ships. Without memory the pool holds none and AddPoolShip() refuses them.
+void InitShipPool(ShipPool *pool, int capacity, const ModelLods *sharedLods)
+{
+    *pool = (ShipPool){ 0 };
+    pool->lods = sharedLods;
+
+    size_t floats = GetArenaAllocSize(capacity * sizeof(float));
+    size_t ints = GetArenaAllocSize(capacity * sizeof(int));
+    size_t size = 8 * floats + 3 * ints + GetArenaAllocSize(capacity * sizeof(Vector3)) + 2 * GetArenaAllocSize(capacity * sizeof(Quaternion)) +
+                  GetArenaAllocSize(capacity * sizeof(ShipPose));
+    if (!InitArena(&pool->arena, size)) return;
+
+    MemArena *arena = &pool->arena;
+    pool->posX = (float *)ArenaCalloc(arena, capacity, sizeof(float));
+    pool->posY = (float *)ArenaCalloc(arena, capacity, sizeof(float));
+    pool->posZ = (float *)ArenaCalloc(arena, capacity, sizeof(float));
+    pool->speed = (float *)ArenaCalloc(arena, capacity, sizeof(float));
+    pool->yaw = (float *)ArenaCalloc(arena, capacity, sizeof(float));
+    pool->topSpeed = (float *)ArenaCalloc(arena, capacity, sizeof(float));
+    pool->targetX = (float *)ArenaCalloc(arena, capacity, sizeof(float));
+    pool->targetZ = (float *)ArenaCalloc(arena, capacity, sizeof(float));
+    pool->segment = (int *)ArenaCalloc(arena, capacity, sizeof(int));
+    pool->waypoint = (int *)ArenaCalloc(arena, capacity, sizeof(int));
+    pool->lod = (int *)ArenaCalloc(arena, capacity, sizeof(int));
+    pool->surfaceNormal = (Vector3 *)ArenaCalloc(arena, capacity, sizeof(Vector3));
+    pool->targetRotation = (Quaternion *)ArenaCalloc(arena, capacity, sizeof(Quaternion));
+    pool->rotation = (Quaternion *)ArenaCalloc(arena, capacity, sizeof(Quaternion));
+    pool->previous = (ShipPose *)ArenaCalloc(arena, capacity, sizeof(ShipPose));
+    pool->capacity = capacity;
+}
+
+// Returns the new ship's index, or -1 when the pool is full
+int AddPoolShip(ShipPool *pool, Vector3 position, float yaw, int waypoint, float topSpeed)
+{
+    if (pool->count >= pool->capacity) return -1;
+
+    int i = pool->count++;
+    pool->posX[i] = position.x;
+    pool->posY[i] = position.y;
+    pool->posZ[i] = position.z;
+    pool->speed[i] = 0.0f;
+    pool->yaw[i] = yaw;
+    pool->topSpeed[i] = topSpeed;
+    pool->segment[i] = -1;
+    pool->waypoint[i] = waypoint;
+    pool->lod[i] = 0;
+    pool->surfaceNormal[i] = (Vector3){ 0.0f, 1.0f, 0.0f };
+    pool->rotation[i] = QuaternionIdentity();
+    pool->previous[i] = (ShipPose){ position, pool->rotation[i], yaw };
+
+    return i;
+}
+
+// Line up 'count' ships in two staggered lanes behind waypoint 0, facing along the track
+void PlaceShipsOnGrid(ShipPool *pool, const Vector3 *waypoints, int waypointCount, int count)
+{
+    int wp = 0;
+    float walked = 0.0f;
+
+    for (int k = 0; k < count; k++)
+    {
+        float distance = (k + 1) * POOL_GRID_ROW_SPACING * 0.5f; // Staggered: each ship half a row back
+
+        // Walk backwards along the centreline until the next waypoint pair spans 'distance'
+        Vector3 from = waypoints[wp];
+        Vector3 to = waypoints[(wp + waypointCount - 1) % waypointCount];
+        float length = Vector3Distance(from, to);
+        while ((walked + length < distance) && (length > 0.0f))
+        {
+            walked += length;
+            wp = (wp + waypointCount - 1) % waypointCount;
+            from = to;
+            to = waypoints[(wp + waypointCount - 1) % waypointCount];
+            length = Vector3Distance(from, to);
+        }
+
+        float t = (length > 0.0f)? (distance - walked) / length : 0.0f;
+        Vector3 position = Vector3Lerp(from, to, t);
+
+        // Face from the slot towards the waypoint ahead of it
+        Vector3 forward = Vector3Normalize(Vector3Subtract(from, to));
+        Vector3 side = { -forward.z, 0.0f, forward.x };
+        float lane = (k % 2 == 0)? POOL_GRID_LANE_OFFSET : -POOL_GRID_LANE_OFFSET;
+        position = Vector3Add(position, Vector3Scale(side, lane));
+        position.y += POOL_HOVER_HEIGHT;
+
+        float yaw = atan2f(forward.x, forward.z) * RAD2DEG;
+        float topSpeed = 4.6f + 0.35f * (float)((k * 7) % 11) / 10.0f; // Spread the field out a little
+
+        AddPoolShip(pool, position, yaw, wp, topSpeed);
+    }
+}
+
+// Advance every ship one tick. Each phase is its own loop over contiguous arrays so the
+// steering/movement loop has no calls (FastSinCos is inline) and no cross-iteration dependencies.
+void UpdateShips(ShipPool *pool, const Vector3 *waypoints, int waypointCount, const TrackSurface *track, float dt)
+{
+    int n = pool->count;
+    float frames = dt * SHIP_REFERENCE_RATE;
+
+    // Phase 1: save poses for interpolation and pick each ship's steering target
+    for (int i = 0; i < n; i++)
+    {
+        pool->previous[i] = (ShipPose){ { pool->posX[i], pool->posY[i], pool->posZ[i] }, pool->rotation[i], pool->yaw[i] };
+
+        int wp = pool->waypoint[i];
+        for (int k = 0; k < waypointCount; k++)
+        {
+            float dx = waypoints[wp].x - pool->posX[i];
+            float dz = waypoints[wp].z - pool->posZ[i];
+            if (dx * dx + dz * dz > POOL_LOOKAHEAD * POOL_LOOKAHEAD) break;
+            wp = (wp + 1) % waypointCount;
+        }
+
+        pool->waypoint[i] = wp;
+        pool->targetX[i] = waypoints[wp].x;
+        pool->targetZ[i] = waypoints[wp].z;
+    }
+
+    // Phase 2: steering, throttle and movement
+    float *restrict posX = pool->posX;
+    float *restrict posZ = pool->posZ;
+    float *restrict speed = pool->speed;
+    float *restrict yaw = pool->yaw;
+    const float *restrict topSpeed = pool->topSpeed;
+    const float *restrict targetX = pool->targetX;
+    const float *restrict targetZ = pool->targetZ;
+
+    for (int i = 0; i < n; i++)
+    {
+        float fx, fz;
+        FastSinCos(yaw[i] * DEG2RAD, &fx, &fz);
+        float dx = targetX[i] - posX[i];
+        float dz = targetZ[i] - posZ[i];
+        float invLength = 1.0f / (sqrtf(dx * dx + dz * dz) + 0.0001f);
+
+        // Sine of the angle to the target; full lock if it is behind us
+        float side = (fz * dx - fx * dz) * invLength;
+        float ahead = fx * dx + fz * dz;
+        float steer = fminf(fmaxf(side * POOL_STEER_GAIN, -1.0f), 1.0f);
+        steer = (ahead < 0.0f)? ((side < 0.0f)? -1.0f : 1.0f) : steer;
+
+        // Lift off through tight corners, otherwise accelerate up to the ship's top speed
+        float throttle = (fabsf(steer) < POOL_LIFT_THRESHOLD)? POOL_ACCELERATION : -POOL_COAST;
+        speed[i] = fminf(fmaxf(speed[i] + throttle * frames, 0.0f), topSpeed[i]);
+
+        yaw[i] += steer * POOL_TURN_SPEED * frames;
+        FastSinCos(yaw[i] * DEG2RAD, &fx, &fz);
+        posX[i] += fx * speed[i] * frames;
+        posZ[i] += fz * speed[i] * frames;
+    }
+
+    // Phase 3: keep each ship inside the walls, sweeping the whole move so none tunnels through
+    for (int i = 0; i < n; i++)
+    {
+        Vector3 position = { pool->posX[i], pool->posY[i], pool->posZ[i] };
+        WallSweep wall = SweepAgainstWalls(track, pool->previous[i].position, position, SHIP_COLLISION_RADIUS, pool->segment[i]);
+        if (wall.hit)
+        {
+            pool->posX[i] = wall.position.x;
+            pool->posZ[i] = wall.position.z;
+            pool->speed[i] *= 1.0f - WALL_SCRAPE_DRAG * wall.impact;
+        }
+    }
+
+    // Phase 4: follow the track surface, each query walking from the ship's own hint
+    for (int i = 0; i < n; i++)
+    {
+        Vector3 position = { pool->posX[i], pool->posY[i], pool->posZ[i] };
+        PROFILE_BEGIN(PROFILE_TRACK_QUERY);
+        TrackSurfaceHit surface = QueryTrackSurface(track, position, pool->segment[i]);
+        PROFILE_END(PROFILE_TRACK_QUERY);
+
+        if (surface.hit)
+        {
+            pool->posY[i] = surface.height + POOL_HOVER_HEIGHT;
+            pool->surfaceNormal[i] = surface.normal;
+            pool->segment[i] = surface.segment;
+        }
+        else
+        {
+            pool->posY[i] = POOL_HOVER_HEIGHT;
+            pool->surfaceNormal[i] = (Vector3){ 0.0f, 1.0f, 0.0f };
+        }
+    }
+
+    // Phase 5: ease each ship's orientation onto the surface
+    float smoothing = 0.1f;
+    if (frames != 1.0f) smoothing = 1.0f - powf(1.0f - smoothing, frames);
+
+    // Headings go in the steering targets' scratch, which is free again by now
+    FastSinCosArray(pool->yaw, DEG2RAD, pool->targetX, pool->targetZ, n);
+    for (int i = 0; i < n; i++)
+    {
+        pool->targetRotation[i] = GetHeadingRotation((Vector2){ pool->targetX[i], pool->targetZ[i] }, pool->surfaceNormal[i]);
+    }
+    QuaternionSlerpFastArray(pool->rotation, pool->targetRotation, smoothing, n);
+}
+
+ShipPose GetPoolShipPose(const ShipPool *pool, int index, float alpha)
+{
+    const ShipPose *previous = &pool->previous[index];
+    ShipPose pose;
+    pose.position = Vector3Lerp(previous->position, (Vector3){ pool->posX[index], pool->posY[index], pool->posZ[index] }, alpha);
+    pose.rotation = QuaternionSlerpFast(previous->rotation, pool->rotation[index], alpha);
+    pose.yaw = Lerp(previous->yaw, pool->yaw[index], alpha);
+    return pose;
+}
+
+// Each ship at the level of detail its distance from the camera calls for
+void QueueShips(RenderQueue *queue, ShipPool *pool, float alpha, LodView view)
+{
+    for (int i = 0; i < pool->count; i++)
+    {
+        ShipPose pose = GetPoolShipPose(pool, i, alpha);
+        pool->lod[i] = SelectLod(pool->lods, view, pose.position, pool->lod[i]);
+        QueueShipModel(queue, &pool->lods->levels[pool->lod[i]], pose, RENDER_STATE_DEFAULT, WHITE);
+    }
+}
+
+void UnloadShipPool(ShipPool *pool)
+{
+    UnloadArena(&pool->arena);
+    pool->count = 0;
+    pool->capacity = 0;
+}
@@ -0,0 +1,49 @@
+#ifndef POOL_H
+#define POOL_H
+
+#include <raylib.h>
+#include "ship.h"
+#include "../mem/arena.h"
+
+// A field of AI racers. Physics state is stored as parallel arrays so UpdateShips can
+// stream through every ship per phase; the model's levels of detail are shared by reference,
+// not owned.
+typedef struct ShipPool {
+    int count;
+    int capacity;
+
+    // Hot state, one entry per ship
+    float *posX;
+    float *posY;
+    float *posZ;
+    float *speed;
+    float *yaw;
+    float *topSpeed;        // Per-ship skill, below the player's max speed
+    int *segment;           // Last track segment, hint for the surface query
+    int *waypoint;          // Waypoint each ship is steering for
+    int *lod;               // Level of detail each ship was last drawn at
+
+    // Per-tick scratch, filled by one phase and consumed by the next
+    float *targetX;
+    float *targetZ;
+    Vector3 *surfaceNormal;
+    Quaternion *targetRotation;
+
+    // Orientation and interpolation state, only touched once per ship per tick
+    Quaternion *rotation;
+    ShipPose *previous;
+
+    MemArena arena;         // Every array above
+    const ModelLods *lods;  // Shared by every ship in the pool
+} ShipPool;
+
+// Function declarations
+void InitShipPool(ShipPool *pool, int capacity, const ModelLods *sharedLods);
+int AddPoolShip(ShipPool *pool, Vector3 position, float yaw, int waypoint, float topSpeed);
+void PlaceShipsOnGrid(ShipPool *pool, const Vector3 *waypoints, int waypointCount, int count);
+void UpdateShips(ShipPool *pool, const Vector3 *waypoints, int waypointCount, const TrackSurface *track, float dt);
+ShipPose GetPoolShipPose(const ShipPool *pool, int index, float alpha);
+void QueueShips(RenderQueue *queue, ShipPool *pool, float alpha, LodView view);
+void UnloadShipPool(ShipPool *pool);
+
+#endif // POOL_H
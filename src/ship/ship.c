@@ -1,117 +1,201 @@
 #include "ship.h"
 #include <raylib.h>
 #include <raymath.h>
-#include <rlgl.h>
 #include <math.h>
-#include "../track/track.h"
+#include "../texture/cache.h"
+#include "../mesh/meshbin.h"
+#include "../perf/profile.h"
+#include "../collision/collision.h"
+#include "../math/fastmath.h"
+
+//                                       rate    life   size  speed  spread drag  gravity
+const ParticleStyle shipExhaustStyle = { 240.0f, 0.5f,  1.2f, 20.0f, 4.0f,  3.0f, -4.0f };  // Rises as it cools
+const ParticleStyle shipSparkStyle =   { 480.0f, 0.35f, 0.3f, 40.0f, 25.0f, 1.0f, 60.0f };
 
 // Custom function to get track surface info (approximated normal and height)
 // This is a simplified approach for fixed-function pipeline
 
 
-void InitShip(Ship *ship, Model shipModel, Texture2D shipTexture)
+void InitShip(Ship *ship, ModelLods shipLods, Texture2D shipTexture)
 {
     ship->position = (Vector3){ 0.0f, 2.0f, 0.0f };
     ship->speed = 0.0f;
     ship->yaw = 0.0f;
     ship->rotation = QuaternionIdentity();
-    ship->model = shipModel;
+    ship->segment = -1;
+    ship->previous = (ShipPose){ ship->position, ship->rotation, ship->yaw };
+    ship->lods = shipLods;
+    ship->lod = 0;
     ship->texture = shipTexture;
+    ship->exhaust = NULL;
+    ship->sparks = NULL;
 }
 
-void UpdateShip(Ship *ship, Mesh trackMesh)
+// The emitters are owned by the caller and updated with the ship, either may be NULL
+void AttachShipEmitters(Ship *ship, ParticleEmitter *exhaust, ParticleEmitter *sparks)
 {
-    // Read analog stick input for steering
-    float yawInput = GetGamepadAxisMovement(0, GAMEPAD_AXIS_LEFT_X); // Assuming left stick X-axis
+    ship->exhaust = exhaust;
+    ship->sparks = sparks;
+}
 
-    // Apply deadzone to yawInput
-    float deadzone = 0.1f; // Adjust this value as needed
-    if (fabsf(yawInput) < deadzone) yawInput = 0.0f;
+// Orientation for a heading (degrees) with the ship's up axis on the surface normal
+Quaternion GetSurfaceRotation(float yaw, Vector3 surfaceNormal)
+{
+    Vector2 heading;
+    FastSinCos(yaw * DEG2RAD, &heading.x, &heading.y);
+    return GetHeadingRotation(heading, surfaceNormal);
+}
 
-    // Update ship's yaw (heading)
-    float turnSpeed = 2.0f; // Adjust sensitivity
-    ship->yaw += yawInput * turnSpeed; // Accumulate yaw for 360-degree turns
+// Same, from the heading's sine and cosine (x and z of the flat forward vector) when the
+// caller already has them
+Quaternion GetHeadingRotation(Vector2 heading, Vector3 surfaceNormal)
+{
+    // Up on the surface normal, right orthogonal to it and the flat heading, then forward
+    // recomputed from the two so it lies in their plane and the ship never rolls
+    Vector3 shipUp = surfaceNormal;
+    Vector3 shipRight = Vector3Normalize(Vector3CrossProduct(shipUp, (Vector3){ heading.x, 0.0f, heading.y }));
+    Vector3 shipForward = Vector3Normalize(Vector3CrossProduct(shipRight, shipUp));
 
-    // Calculate new forward vector components based on current yaw
-    float forwardX = sinf(ship->yaw * DEG2RAD);
-    float forwardZ = cosf(ship->yaw * DEG2RAD);
+    // Straight from the basis, no Matrix in between
+    return QuaternionFromBasis(shipRight, shipUp, shipForward);
+}
 
-    // Move ship forward along its current heading
-    ship->position.x += forwardX * ship->speed;
-    ship->position.z += forwardZ * ship->speed;
+void UpdateShip(Ship *ship, ShipInput input, const TrackSurface *track, float dt)
+{
+    // Keep the pose this tick starts from so drawing can interpolate
+    ship->previous = (ShipPose){ ship->position, ship->rotation, ship->yaw };
 
-    // Update ship's Y position and orientation to follow the track surface
-    float surfaceHeight;
-    Vector3 surfaceNormal = GetTrackSurfaceInfo(ship->position, trackMesh, &surfaceHeight);
-    ship->position.y = surfaceHeight + 2.0f; // Offset above the surface
+    // Number of reference frames this tick covers, exactly 1 at 60 Hz
+    float frames = dt * SHIP_REFERENCE_RATE;
 
-    // Calculate pitch and roll from surface normal
-    Vector3 shipForward = { sinf(ship->yaw * DEG2RAD), 0.0f, cosf(ship->yaw * DEG2RAD) };
-    // 1. Define the Up vector (aligned with surface normal)
-    Vector3 shipUp = surfaceNormal;
+    // Update ship's yaw (heading)
+    float turnSpeed = 2.0f; // Adjust sensitivity
+    ship->yaw += input.steer * turnSpeed * frames; // Accumulate yaw for 360-degree turns
 
-    // 2. Define the initial Forward vector (based on shipYaw, in XZ plane)
-    Vector3 initialForward = { sinf(ship->yaw * DEG2RAD), 0.0f, cosf(ship->yaw * DEG2RAD) };
-    initialForward = Vector3Normalize(initialForward);
+    // Calculate new forward vector components based on current yaw, once for the whole tick
+    float forwardX, forwardZ;
+    FastSinCos(ship->yaw * DEG2RAD, &forwardX, &forwardZ);
 
-    // 3. Calculate the Right vector (orthogonal to Up and initialForward)
-    Vector3 shipRight = Vector3CrossProduct(shipUp, initialForward);
-    shipRight = Vector3Normalize(shipRight);
+    // Move ship forward along its current heading
+    Vector3 from = ship->position;
+    ship->position.x += forwardX * ship->speed * frames;
+    ship->position.z += forwardZ * ship->speed * frames;
 
-    // 4. Recalculate the Forward vector (orthogonal to Right and Up)
-    // This ensures the forward vector is truly in the plane defined by Right and Up,
-    // and thus prevents roll.
-    shipForward = Vector3CrossProduct(shipRight, shipUp);
-    shipForward = Vector3Normalize(shipForward);
+    // Stop at the track edge and slide along it, losing speed the more head on the hit
+    WallSweep wall = SweepAgainstWalls(track, from, ship->position, SHIP_COLLISION_RADIUS, ship->segment);
+    ship->position = wall.position;
+    if (wall.hit) ship->speed *= 1.0f - WALL_SCRAPE_DRAG * wall.impact;
 
-    // Construct the rotation matrix using these orthonormal vectors
-    Matrix targetMatrix = MatrixIdentity();
-    targetMatrix.m0 = shipRight.x;    targetMatrix.m4 = shipUp.x;    targetMatrix.m8 = shipForward.x;
-    targetMatrix.m1 = shipRight.y;    targetMatrix.m5 = shipUp.y;    targetMatrix.m9 = shipForward.y;
-    targetMatrix.m2 = shipRight.z;    targetMatrix.m6 = shipUp.z;    targetMatrix.m10 = shipForward.z;
+    // Update ship's Y position and orientation to follow the track surface
+    float surfaceHeight = 0.0f;
+    Vector3 surfaceNormal = { 0.0f, 1.0f, 0.0f };
+    PROFILE_BEGIN(PROFILE_TRACK_QUERY);
+    TrackSurfaceHit surface = QueryTrackSurface(track, ship->position, ship->segment);
+    PROFILE_END(PROFILE_TRACK_QUERY);
+    if (surface.hit)
+    {
+        surfaceHeight = surface.height;
+        surfaceNormal = surface.normal;
+        ship->segment = surface.segment;
+    }
+    ship->position.y = surfaceHeight + SHIP_HOVER_HEIGHT; // Offset above the surface
 
-    // Convert the target matrix to a quaternion
-    Quaternion targetRotation = QuaternionFromMatrix(targetMatrix);
+    // Calculate pitch and roll from surface normal
+    Quaternion targetRotation = GetHeadingRotation((Vector2){ forwardX, forwardZ }, surfaceNormal);
 
     // Smoothly interpolate ship's rotation
-    ship->rotation = QuaternionSlerp(ship->rotation, targetRotation, 0.1f); // Adjust interpolation factor (0.1f) for desired smoothness
+    float smoothing = 0.1f; // Adjust interpolation factor (0.1f per reference frame) for desired smoothness
+    if (frames != 1.0f) smoothing = 1.0f - powf(1.0f - smoothing, frames);
+    ship->rotation = QuaternionSlerpFast(ship->rotation, targetRotation, smoothing);
 
     // Check for 'A' button press to accelerate
-    if (IsGamepadButtonDown(0, GAMEPAD_BUTTON_RIGHT_FACE_DOWN)) // Assuming A button is RIGHT_FACE_DOWN
+    if (input.accelerate)
     {
-        ship->speed += 0.05f; // Increase speed
+        ship->speed += 0.05f * frames; // Increase speed
     }
     else
     {
         // Decelerate when A is not pressed
-        ship->speed -= 0.02f; // Deceleration rate
+        ship->speed -= 0.02f * frames; // Deceleration rate
         if (ship->speed < 0.0f) ship->speed = 0.0f; // Prevent negative speed
     }
 
     // Check for 'B' button press to brake
-    if (IsGamepadButtonDown(0, GAMEPAD_BUTTON_RIGHT_FACE_LEFT)) // Assuming B button is RIGHT_FACE_LEFT
+    if (input.brake)
     {
-        ship->speed -= 0.1f; // Brake rate
+        ship->speed -= 0.1f * frames; // Brake rate
         if (ship->speed < 0.0f) ship->speed = 0.0f; // Prevent negative speed
     }
 
     // Clamp ship speed to a reasonable maximum
     float maxSpeed = 5.0f;
     if (ship->speed > maxSpeed) ship->speed = maxSpeed;
+
+    // Particles move on from where they were, then the engine and any wall contact add to them
+    Vector3 forward = { forwardX, 0.0f, forwardZ };
+    if (ship->exhaust != NULL)
+    {
+        UpdateParticleEmitter(ship->exhaust, dt);
+        Vector3 engine = Vector3Subtract(ship->position, Vector3Scale(forward, SHIP_EXHAUST_OFFSET));
+        EmitParticles(ship->exhaust, engine, Vector3Negate(forward), Vector3Zero(), ship->speed / maxSpeed, dt);
+    }
+    if (ship->sparks != NULL)
+    {
+        UpdateParticleEmitter(ship->sparks, dt);
+        if (wall.hit)
+        {
+            // Off the contact, back over the track and up, carried along with the ship; a
+            // glancing scrape throws half as many as a head on hit
+            Vector3 contact = Vector3Add(ship->position, Vector3Scale(wall.normal, SHIP_COLLISION_RADIUS));
+            Vector3 direction = Vector3Normalize((Vector3){ -wall.normal.x, 0.5f, -wall.normal.z });
+            Vector3 velocity = Vector3Scale(forward, ship->speed * SHIP_REFERENCE_RATE * 0.5f);
+            EmitParticles(ship->sparks, contact, direction, velocity, 0.5f + 0.5f * wall.impact, dt);
+        }
+    }
+}
+
+// Pose between the previous tick (alpha 0) and the latest one (alpha 1)
+ShipPose GetShipPose(const Ship *ship, float alpha)
+{
+    ShipPose pose;
+    pose.position = Vector3Lerp(ship->previous.position, ship->position, alpha);
+    pose.rotation = QuaternionSlerpFast(ship->previous.rotation, ship->rotation, alpha);
+    pose.yaw = Lerp(ship->previous.yaw, ship->yaw, alpha);
+    return pose;
+}
+
+// Model to world for a pose: translation, rotation and the model's 90 degree turn about Y to its
+// default orientation, built as one matrix from the rotation's basis instead of three products
+Matrix GetShipTransform(ShipPose pose)
+{
+    Vector3 right, up, forward;
+    QuaternionToBasis(pose.rotation, &right, &up, &forward);
+
+    // Turning 90 degrees about Y takes the model's X axis to -Z and its Z axis to X
+    Matrix transform = { 0 };
+    transform.m0 = -forward.x; transform.m4 = up.x; transform.m8 = right.x;  transform.m12 = pose.position.x;
+    transform.m1 = -forward.y; transform.m5 = up.y; transform.m9 = right.y;  transform.m13 = pose.position.y;
+    transform.m2 = -forward.z; transform.m6 = up.z; transform.m10 = right.z; transform.m14 = pose.position.z;
+    transform.m15 = 1.0f;
+    return transform;
+}
+
+// The model goes by reference, so it has to outlive the queue's flush
+void QueueShipModel(RenderQueue *queue, const Model *model, ShipPose pose, unsigned int flags, Color tint)
+{
+    QueueModel(queue, RENDER_PASS_WORLD, flags, model, GetShipTransform(pose), tint);
 }
 
-void DrawShip(Ship *ship)
+// At the level of detail its distance from the camera calls for
+void QueueShip(RenderQueue *queue, Ship *ship, float alpha, LodView view)
 {
-    rlPushMatrix();
-        rlTranslatef(ship->position.x, ship->position.y, ship->position.z); // Translate to ship's world position
-        rlMultMatrixf(MatrixToFloatV(QuaternionToMatrix(ship->rotation)).v);
-        rlRotatef(90.0f, 0.0f, 1.0f, 0.0f); // Adjust for model's default orientation
-        DrawModel(ship->model, (Vector3){0.0f, 0.0f, 0.0f}, 1.0f, WHITE); // Draw at local origin
-    rlPopMatrix();
+    ShipPose pose = GetShipPose(ship, alpha);
+    ship->lod = SelectLod(&ship->lods, view, pose.position, ship->lod);
+    QueueShipModel(queue, &ship->lods.levels[ship->lod], pose, RENDER_STATE_DEFAULT, WHITE);
 }
 
 void UnloadShip(Ship *ship)
 {
-    UnloadTexture(ship->texture);
-    UnloadModel(ship->model);
+    ReleaseTexture(ship->texture);
+    UnloadModelLods(&ship->lods, &ship->arena);
 }
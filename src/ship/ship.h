@@ -3,6 +3,26 @@
 
 #include <raylib.h>
 #include <raymath.h>
+#include "input.h"
+#include "../track/surface.h"
+#include "../mem/arena.h"
+#include "../render/queue.h"
+#include "../render/lod.h"
+#include "../fx/particles.h"
+
+// Physics constants are tuned per 1/60 s, UpdateShip scales them by its tick length
+#define SHIP_REFERENCE_RATE 60.0f
+#define SHIP_HOVER_HEIGHT 2.0f     // Ride height above the track surface
+#define SHIP_EXHAUST_OFFSET 3.0f   // Engine distance behind the ship's centre
+#define SHIP_EXHAUST_PARTICLES 192 // Emitter capacities for the styles below
+#define SHIP_SPARK_PARTICLES 256
+
+// The parts of the ship state that drawing interpolates between ticks
+typedef struct ShipPose {
+    Vector3 position;
+    Quaternion rotation;
+    float yaw;
+} ShipPose;
 
 // Define the Ship structure
 typedef struct Ship {
@@ -10,14 +30,30 @@ typedef struct Ship {
     float speed;
     float yaw;
     Quaternion rotation;
-    Model model;
+    int segment;        // Last track segment the ship was over, -1 if unknown
+    ShipPose previous;  // Pose at the start of the last tick
+    ModelLods lods;
+    int lod;            // Level of detail it was last drawn at
+    MemArena arena;     // Holds the levels, filled by LoadModelLodsData() before InitShip()
     Texture2D texture;
+    ParticleEmitter *exhaust;   // Attached by AttachShipEmitters(), NULL for none
+    ParticleEmitter *sparks;
 } Ship;
 
+// Engine trail, emitted in proportion to speed, and sparks thrown off scraping a wall
+extern const ParticleStyle shipExhaustStyle;
+extern const ParticleStyle shipSparkStyle;
+
 // Function declarations
-void InitShip(Ship *ship, Model shipModel, Texture2D shipTexture);
-void UpdateShip(Ship *ship, Mesh trackMesh);
-void DrawShip(Ship *ship);
+void InitShip(Ship *ship, ModelLods shipLods, Texture2D shipTexture);
+void AttachShipEmitters(Ship *ship, ParticleEmitter *exhaust, ParticleEmitter *sparks);
+void UpdateShip(Ship *ship, ShipInput input, const TrackSurface *track, float dt);
+ShipPose GetShipPose(const Ship *ship, float alpha);
+Quaternion GetSurfaceRotation(float yaw, Vector3 surfaceNormal);
+Quaternion GetHeadingRotation(Vector2 heading, Vector3 surfaceNormal);
+Matrix GetShipTransform(ShipPose pose);
+void QueueShipModel(RenderQueue *queue, const Model *model, ShipPose pose, unsigned int flags, Color tint);
+void QueueShip(RenderQueue *queue, Ship *ship, float alpha, LodView view);
 void UnloadShip(Ship *ship);
 
 #endif // SHIP_H
@@ -0,0 +1,38 @@
+#include "timestep.h"
+
+void InitFixedTimestep(FixedTimestep *timestep, float tickRate, int maxTicksPerFrame)
+{
+    timestep->tickRate = tickRate;
+    timestep->tickTime = 1.0f / tickRate;
+    timestep->accumulator = 0.0f;
+    timestep->maxTicksPerFrame = maxTicksPerFrame;
+    timestep->droppedTicks = 0;
+}
+
+// Add a frame's worth of time and return how many ticks to simulate for it
+int AdvanceFixedTimestep(FixedTimestep *timestep, float frameTime)
+{
+    if (frameTime < 0.0f) frameTime = 0.0f;
+
+    timestep->accumulator += frameTime;
+
+    int ticks = (int)(timestep->accumulator / timestep->tickTime);
+    timestep->accumulator -= ticks * timestep->tickTime;
+    if (timestep->accumulator < 0.0f) timestep->accumulator = 0.0f; // Rounding
+
+    // After a long stall, run slow rather than spiral trying to catch up
+    if (ticks > timestep->maxTicksPerFrame)
+    {
+        timestep->droppedTicks += ticks - timestep->maxTicksPerFrame;
+        ticks = timestep->maxTicksPerFrame;
+    }
+
+    return ticks;
+}
+
+// How far the render frame is between the last two ticks, 0 to 1
+float GetFixedTimestepAlpha(const FixedTimestep *timestep)
+{
+    float alpha = timestep->accumulator / timestep->tickTime;
+    return (alpha > 1.0f)? 1.0f : alpha;
+}
@@ -0,0 +1,18 @@
+#ifndef TIMESTEP_H
+#define TIMESTEP_H
+
+// Fixed-rate simulation clock driven by variable render frame times
+typedef struct FixedTimestep {
+    float tickRate;         // Simulation ticks per second
+    float tickTime;         // Seconds per tick
+    float accumulator;      // Frame time not yet simulated, always below one tick after Advance
+    int maxTicksPerFrame;   // Catch-up limit, time beyond it is dropped instead of simulated
+    int droppedTicks;       // Ticks skipped because of the catch-up limit
+} FixedTimestep;
+
+// Function declarations
+void InitFixedTimestep(FixedTimestep *timestep, float tickRate, int maxTicksPerFrame);
+int AdvanceFixedTimestep(FixedTimestep *timestep, float frameTime);
+float GetFixedTimestepAlpha(const FixedTimestep *timestep);
+
+#endif // TIMESTEP_H
@@ -0,0 +1,127 @@
+#include "cache.h"
+#include "texbin.h"
+#include "../mem/budget.h"
+#include <raylib.h>
+#include <string.h>
+
+static TextureCacheEntry textureCache[TEXTURE_CACHE_CAPACITY] = { 0 };
+
+// Cached entry for 'fileName' with a reference added, or NULL with *freeSlot set to the first
+// unused entry (NULL too when the cache is full)
+static TextureCacheEntry *FindTexture(const char *fileName, TextureCacheEntry **freeSlot)
+{
+    *freeSlot = NULL;
+
+    for (int i = 0; i < TEXTURE_CACHE_CAPACITY; i++)
+    {
+        TextureCacheEntry *entry = &textureCache[i];
+        if (entry->references == 0)
+        {
+            if (*freeSlot == NULL) *freeSlot = entry;
+        }
+        else if (strcmp(entry->fileName, fileName) == 0)
+        {
+            entry->references++;
+            return entry;
+        }
+    }
+
+    return NULL;
+}
+
+// Charges the new texture's VRAM, and unloads it again if that's over budget
+static Texture2D AddTexture(TextureCacheEntry *slot, const char *fileName, Texture2D texture)
+{
+    if (texture.id == 0) return texture;
+
+    int bytes = (int)GetTextureDataSize(texture.width, texture.height, texture.mipmaps, texture.format);
+    if (!ReserveAssetMemory(ASSET_TEXTURE, texture.id, fileName, bytes))
+    {
+        UnloadTexture(texture);
+        return (Texture2D){ 0 };
+    }
+
+    if ((slot == NULL) || (strlen(fileName) >= sizeof(slot->fileName)))
+    {
+        TraceLog(LOG_WARNING, "TEXCACHE: [%s] Cache full, texture is not shared", fileName);
+        return texture;
+    }
+
+    strcpy(slot->fileName, fileName);
+    slot->texture = texture;
+    slot->references = 1;
+    slot->bytes = bytes;
+
+    return texture;
+}
+
+// Return the texture for 'fileName', loading it on first use. Converted .hst files keep
+// their stored format and mip chain; anything else goes through raylib's LoadTexture(). An id
+// of 0 if it didn't load or didn't fit the VRAM budget.
+Texture2D AcquireTexture(const char *fileName)
+{
+    TextureCacheEntry *slot = NULL;
+    TextureCacheEntry *entry = FindTexture(fileName, &slot);
+    if (entry != NULL) return entry->texture;
+
+    Texture2D texture = IsFileExtension(fileName, ".hst")? LoadTextureBinary(fileName) : LoadTexture(fileName);
+    return AddTexture(slot, fileName, texture);
+}
+
+// AcquireTexture() for an image decoded elsewhere, e.g. on the asset loader's thread: uploaded
+// unless 'fileName' is already cached. The image stays the caller's.
+Texture2D AcquireTextureFromImage(const char *fileName, Image image)
+{
+    TextureCacheEntry *slot = NULL;
+    TextureCacheEntry *entry = FindTexture(fileName, &slot);
+    if (entry != NULL) return entry->texture;
+
+    return AddTexture(slot, fileName, LoadTextureFromImage(image));
+}
+
+// Drop one reference, unloading the texture with the last one. Textures the cache
+// doesn't know about are unloaded directly.
+void ReleaseTexture(Texture2D texture)
+{
+    if (texture.id == 0) return;
+
+    for (int i = 0; i < TEXTURE_CACHE_CAPACITY; i++)
+    {
+        TextureCacheEntry *entry = &textureCache[i];
+        if ((entry->references > 0) && (entry->texture.id == texture.id))
+        {
+            if (--entry->references == 0)
+            {
+                ReleaseAssetMemory(ASSET_TEXTURE, entry->texture.id);
+                UnloadTexture(entry->texture);
+                memset(entry, 0, sizeof(*entry));
+            }
+            return;
+        }
+    }
+
+    ReleaseAssetMemory(ASSET_TEXTURE, texture.id);
+    UnloadTexture(texture);
+}
+
+int GetTextureCacheBytes(void)
+{
+    int bytes = 0;
+    for (int i = 0; i < TEXTURE_CACHE_CAPACITY; i++) bytes += textureCache[i].bytes;
+    return bytes;
+}
+
+// Per-texture memory of everything currently cached
+void LogTextureCache(void)
+{
+    for (int i = 0; i < TEXTURE_CACHE_CAPACITY; i++)
+    {
+        const TextureCacheEntry *entry = &textureCache[i];
+        if (entry->references == 0) continue;
+
+        TraceLog(LOG_INFO, "TEXCACHE: [%s] %ix%i, %i mipmaps, %i bytes, %i references", entry->fileName,
+                 entry->texture.width, entry->texture.height, entry->texture.mipmaps, entry->bytes, entry->references);
+    }
+
+    TraceLog(LOG_INFO, "TEXCACHE: %i bytes of texture data", GetTextureCacheBytes());
+}
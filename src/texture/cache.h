@@ -0,0 +1,23 @@
+#ifndef TEXTURE_CACHE_H
+#define TEXTURE_CACHE_H
+
+#include <raylib.h>
+
+#define TEXTURE_CACHE_CAPACITY 16
+
+// Textures loaded through the cache are uploaded once per path and shared by reference count
+typedef struct TextureCacheEntry {
+    char fileName[64];
+    Texture2D texture;
+    int references;         // 0 marks a free slot
+    int bytes;              // Pixel data of every uploaded mip level
+} TextureCacheEntry;
+
+// Function declarations
+Texture2D AcquireTexture(const char *fileName);
+Texture2D AcquireTextureFromImage(const char *fileName, Image image);
+void ReleaseTexture(Texture2D texture);
+int GetTextureCacheBytes(void);
+void LogTextureCache(void);
+
+#endif // TEXTURE_CACHE_H
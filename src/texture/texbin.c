@@ -0,0 +1,62 @@
+#include "texbin.h"
+#include <raylib.h>
+#include <string.h>
+
+// Point an Image at the pixel data inside an in-memory .hst file. Nothing is copied,
+// so the image is only valid while 'data' is.
+bool GetTextureBinaryImage(const unsigned char *data, int dataSize, Image *image)
+{
+    if ((data == NULL) || (dataSize < (int)sizeof(TexBinHeader))) return false;
+
+    TexBinHeader header;
+    memcpy(&header, data, sizeof(header));
+    if ((header.magic != TEXBIN_MAGIC) || (header.version != TEXBIN_VERSION))
+    {
+        TraceLog(LOG_WARNING, "TEXBIN: Unrecognized file (magic 0x%08x, version %u)", header.magic, header.version);
+        return false;
+    }
+
+    // Every level must fit in the data the header claims, and that data in the file
+    int expected = 0;
+    for (int i = 0, w = header.width, h = header.height; i < header.mipmaps; i++)
+    {
+        expected += GetPixelDataSize(w, h, header.format);
+        w = (w > 1)? w / 2 : 1;
+        h = (h > 1)? h / 2 : 1;
+    }
+    if ((header.mipmaps == 0) || ((uint32_t)expected != header.dataSize) ||
+        ((uint64_t)sizeof(header) + header.dataSize > (uint64_t)dataSize))
+    {
+        TraceLog(LOG_WARNING, "TEXBIN: Truncated or inconsistent file");
+        return false;
+    }
+
+    image->data = (void *)(data + sizeof(header));
+    image->width = header.width;
+    image->height = header.height;
+    image->mipmaps = header.mipmaps;
+    image->format = header.format;
+
+    return true;
+}
+
+// Load a converted .hst texture with a single file read, uploading the stored mip chain as-is
+Texture2D LoadTextureBinary(const char *fileName)
+{
+    Texture2D texture = { 0 };
+
+    int dataSize = 0;
+    unsigned char *data = LoadFileData(fileName, &dataSize);
+
+    Image image;
+    if (GetTextureBinaryImage(data, dataSize, &image))
+    {
+        texture = LoadTextureFromImage(image);
+        TraceLog(LOG_INFO, "TEXBIN: [%s] Loaded %ix%i, %i mipmaps (%i bytes)", fileName, image.width, image.height, image.mipmaps, dataSize - (int)sizeof(TexBinHeader));
+    }
+    else TraceLog(LOG_WARNING, "TEXBIN: [%s] Failed to load texture", fileName);
+
+    UnloadFileData(data);
+
+    return texture;
+}
@@ -0,0 +1,12 @@
+#ifndef TEXBIN_H
+#define TEXBIN_H
+
+#include <raylib.h>
+#include <stdbool.h>
+#include "texbin_format.h"
+
+// Function declarations
+Texture2D LoadTextureBinary(const char *fileName);
+bool GetTextureBinaryImage(const unsigned char *data, int dataSize, Image *image);
+
+#endif // TEXBIN_H
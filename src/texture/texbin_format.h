@@ -0,0 +1,27 @@
+#ifndef TEXBIN_FORMAT_H
+#define TEXBIN_FORMAT_H
+
+// Binary texture file (.hst) written by tools/texconv and read by LoadTextureBinary().
+// Little-endian. Layout:
+//
+//   TexBinHeader
+//   pixel data for every mip level, largest first, each level tightly packed
+//
+// which is exactly raylib's Image layout, so the data uploads straight from the file buffer.
+
+#include <stdint.h>
+
+#define TEXBIN_MAGIC 0x54475348u    // "HSGT"
+#define TEXBIN_VERSION 1
+
+typedef struct TexBinHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint16_t width;                 // Power of two, as the PVR requires
+    uint16_t height;
+    uint16_t format;                // raylib PixelFormat, one of the 16-bit formats
+    uint16_t mipmaps;               // Levels stored, down to 1x1
+    uint32_t dataSize;              // Bytes of pixel data after the header
+} TexBinHeader;
+
+#endif // TEXBIN_FORMAT_H
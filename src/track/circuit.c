@@ -0,0 +1,21 @@
+#include "circuit.h"
+
+// A stadium: a straight, a banked 180 onto a back straight over a crest, and a second banked
+// 180, turning the same way, back to the line. Positions, width and bank (degrees) per point.
+const TrackControlPoint stadiumCircuit[STADIUM_CIRCUIT_POINTS] = {
+    { {    0.0f,  0.0f, -350.0f }, 200.0f,  0.0f },   // Start/finish
+    { {  400.0f,  5.0f, -350.0f }, 200.0f,  0.0f },
+    { {  647.5f, 10.0f, -247.5f }, 200.0f, 12.0f },
+    { {  750.0f, 10.0f,    0.0f }, 200.0f, 12.0f },
+    { {  647.5f, 10.0f,  247.5f }, 200.0f, 12.0f },
+    { {  400.0f, 10.0f,  350.0f }, 200.0f,  0.0f },
+    { {    0.0f, 40.0f,  350.0f }, 200.0f,  0.0f },   // Crest
+    { { -400.0f, 10.0f,  350.0f }, 200.0f,  0.0f },
+    { { -647.5f, 10.0f,  247.5f }, 200.0f, 12.0f },
+    { { -750.0f, 10.0f,    0.0f }, 200.0f, 12.0f },
+    { { -647.5f, 10.0f, -247.5f }, 200.0f, 12.0f },
+    { { -400.0f,  5.0f, -350.0f }, 200.0f,  0.0f },
+};
+
+// New row every 4 degrees of turn or roll, 2 units of height error or 80 units of straight
+const TrackSplineSettings stadiumTessellation = { 4.0f, 2.0f, 4.0f, 80.0f, 0.0f };
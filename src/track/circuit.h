@@ -0,0 +1,12 @@
+#ifndef CIRCUIT_H
+#define CIRCUIT_H
+
+#include "spline.h"
+
+// Stadium circuit the game races on, shared with the host benchmarks that replay its recordings
+#define STADIUM_CIRCUIT_POINTS 12
+
+extern const TrackControlPoint stadiumCircuit[STADIUM_CIRCUIT_POINTS];
+extern const TrackSplineSettings stadiumTessellation;
+
+#endif // CIRCUIT_H
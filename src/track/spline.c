@@ -0,0 +1,132 @@
+#include "spline.h"
+#include <raylib.h>
+#include <raymath.h>
+#include <stdlib.h>
+#include <math.h>
+#include "track.h"
+
+#define SPLINE_SAMPLES_PER_SPAN 64  // Dense samples between two control points, the rows are picked from these
+
+// A dense point along the spline
+typedef struct SplineSample {
+    Vector3 position;
+    Vector3 tangent;
+    float width;
+    float roll;
+    float distance;
+} SplineSample;
+
+static inline float CatmullRom(float p0, float p1, float p2, float p3, float t)
+{
+    return 0.5f * ((2.0f * p1) + (-p0 + p2) * t + (2.0f * p0 - 5.0f * p1 + 4.0f * p2 - p3) * t * t +
+                   (-p0 + 3.0f * p1 - 3.0f * p2 + p3) * t * t * t);
+}
+
+static inline float CatmullRomSlope(float p0, float p1, float p2, float p3, float t)
+{
+    return 0.5f * ((-p0 + p2) + 2.0f * (2.0f * p0 - 5.0f * p1 + 4.0f * p2 - p3) * t +
+                   3.0f * (-p0 + 3.0f * p1 - 3.0f * p2 + p3) * t * t);
+}
+
+// Point 't' of the way through span 'span' (control point span to span + 1), wrapping around the loop
+static SplineSample SampleSpline(const TrackControlPoint *points, int pointCount, int span, float t)
+{
+    const TrackControlPoint *p0 = &points[(span + pointCount - 1) % pointCount];
+    const TrackControlPoint *p1 = &points[span % pointCount];
+    const TrackControlPoint *p2 = &points[(span + 1) % pointCount];
+    const TrackControlPoint *p3 = &points[(span + 2) % pointCount];
+
+    SplineSample sample = { 0 };
+    sample.position.x = CatmullRom(p0->position.x, p1->position.x, p2->position.x, p3->position.x, t);
+    sample.position.y = CatmullRom(p0->position.y, p1->position.y, p2->position.y, p3->position.y, t);
+    sample.position.z = CatmullRom(p0->position.z, p1->position.z, p2->position.z, p3->position.z, t);
+    sample.tangent.x = CatmullRomSlope(p0->position.x, p1->position.x, p2->position.x, p3->position.x, t);
+    sample.tangent.y = CatmullRomSlope(p0->position.y, p1->position.y, p2->position.y, p3->position.y, t);
+    sample.tangent.z = CatmullRomSlope(p0->position.z, p1->position.z, p2->position.z, p3->position.z, t);
+    sample.tangent = Vector3Normalize(sample.tangent);
+    sample.width = CatmullRom(p0->width, p1->width, p2->width, p3->width, t);
+    sample.roll = CatmullRom(p0->bank, p1->bank, p2->bank, p3->bank, t);
+    return sample;
+}
+
+// True if one segment from sample a to sample b would break any of the limits
+static bool ExceedsLimits(const SplineSample *samples, int a, int b, const TrackSplineSettings *settings)
+{
+    const SplineSample *start = &samples[a];
+    const SplineSample *end = &samples[b];
+
+    // The samples in between were already checked against 'a', so comparing the ends is enough
+    float turn = acosf(Clamp(Vector3DotProduct(start->tangent, end->tangent), -1.0f, 1.0f)) * RAD2DEG;
+    if (turn > settings->maxTurn) return true;
+    if (fabsf(end->roll - start->roll) > settings->maxRoll) return true;
+
+    float length = end->distance - start->distance;
+    if (length > settings->maxLength) return true;
+
+    // Height isn't monotonic, so every sample in between is tested against the straight segment
+    for (int j = a + 1; j < b; j++)
+    {
+        float t = (samples[j].distance - start->distance) / length;
+        float height = Lerp(start->position.y, end->position.y, t);
+        if (fabsf(samples[j].position.y - height) > settings->maxRise) return true;
+    }
+
+    return false;
+}
+
+// Sample the spline densely, then walk it and emit a row every time the segment from the last
+// row would break a limit. Rows land where the track bends, crests or banks.
+TrackRibbon GenSplineTrackRibbon(const TrackControlPoint *points, int pointCount, TrackSplineSettings settings)
+{
+    TrackRibbon ribbon = { 0 };
+
+    if (pointCount < 4)
+    {
+        TraceLog(LOG_WARNING, "TRACK: Spline needs at least 4 control points, got %i", pointCount);
+        return ribbon;
+    }
+
+    // One extra sample at the end repeats the first one a lap further on
+    int sampleCount = pointCount * SPLINE_SAMPLES_PER_SPAN;
+    SplineSample *samples = (SplineSample *)RL_MALLOC((sampleCount + 1) * sizeof(SplineSample));
+
+    for (int k = 0; k <= sampleCount; k++)
+    {
+        samples[k] = SampleSpline(points, pointCount, (k / SPLINE_SAMPLES_PER_SPAN) % pointCount,
+                                  (float)(k % SPLINE_SAMPLES_PER_SPAN) / SPLINE_SAMPLES_PER_SPAN);
+        if (k > 0) samples[k].distance = samples[k - 1].distance + Vector3Distance(samples[k - 1].position, samples[k].position);
+    }
+
+    // Twist is wound in with distance, so it reads the same whatever the tessellation
+    float lapLength = samples[sampleCount].distance;
+    for (int k = 0; k <= sampleCount; k++) samples[k].roll += settings.twist * samples[k].distance / lapLength;
+
+    int *rows = (int *)RL_MALLOC(sampleCount * sizeof(int));
+    int rowCount = 0;
+    rows[rowCount++] = 0;
+
+    for (int k = 1; k <= sampleCount; k++)
+    {
+        int last = rows[rowCount - 1];
+        if (!ExceedsLimits(samples, last, k, &settings)) continue;
+
+        // Stop just short of the limit, or take a single sample step if even that is too far
+        int row = (k - 1 > last)? k - 1 : k;
+        if (row < sampleCount) rows[rowCount++] = row;
+    }
+
+    ribbon = AllocTrackRibbon(rowCount);
+
+    for (int i = 0; i < rowCount; i++)
+    {
+        const SplineSample *sample = &samples[rows[i]];
+        TrackFrame frame = GetTrackFrame(sample->position, sample->tangent, sample->width, sample->roll);
+        frame.distance = sample->distance;
+        SetTrackRibbonRow(&ribbon, i, frame, sample->distance / lapLength);
+    }
+
+    RL_FREE(rows);
+    RL_FREE(samples);
+
+    return ribbon;
+}
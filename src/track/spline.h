@@ -0,0 +1,27 @@
+#ifndef SPLINE_H
+#define SPLINE_H
+
+#include <raylib.h>
+#include "surface.h"
+
+// A point the track's centreline passes through
+typedef struct TrackControlPoint {
+    Vector3 position;
+    float width;
+    float bank;             // Degrees, positive raises the outer edge
+} TrackControlPoint;
+
+// Limits on a single segment. A new row is emitted before any of them is exceeded, so
+// straights get long segments and tight, cresting or banking sections get short ones.
+typedef struct TrackSplineSettings {
+    float maxTurn;          // Degrees the direction may change, sideways or over a crest
+    float maxRise;          // Height the spline may stray from the straight segment
+    float maxRoll;          // Degrees the bank and twist may change
+    float maxLength;        // Longest segment even on a straight
+    float twist;            // Degrees of roll wound in over the lap (multiples of 360 close seamlessly)
+} TrackSplineSettings;
+
+// Closed Catmull-Rom spline through 'points' (at least 4, in driving order) as a ribbon
+TrackRibbon GenSplineTrackRibbon(const TrackControlPoint *points, int pointCount, TrackSplineSettings settings);
+
+#endif // SPLINE_H
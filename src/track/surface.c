@@ -0,0 +1,344 @@
+#include "surface.h"
+#include <raylib.h>
+#include <raymath.h>
+#include <stdlib.h>
+#include <math.h>
+#include <float.h>
+
+#define SURFACE_WALK_LIMIT 64       // Max segments stepped from the hint before falling back to the grid
+#define SURFACE_MAX_GRID_DIM 256    // Grid resolution cap per axis
+#define SURFACE_EDGE_EPSILON 0.0001f
+
+// Line through a and b in the XZ plane as (a, b, c), oriented so that 'inside' is on the positive
+// side and scaled so that EdgeSide() is the distance from it
+static Vector3 EdgeLine(Vector3 a, Vector3 b, Vector3 inside)
+{
+    Vector3 line = { -(b.z - a.z), b.x - a.x, 0.0f };
+    float length = sqrtf(line.x * line.x + line.y * line.y);
+    if (length > 0.0f)
+    {
+        line.x /= length;
+        line.y /= length;
+    }
+    line.z = -(line.x * a.x + line.y * a.z);
+
+    if (line.x * inside.x + line.y * inside.z + line.z < 0.0f) line = Vector3Negate(line);
+
+    return line;
+}
+
+static inline float EdgeSide(Vector3 line, Vector3 p)
+{
+    return line.x * p.x + line.y * p.z + line.z;
+}
+
+// Same normal GetRayCollisionTriangle() reports for (p1, p2, p3)
+static Vector4 TrianglePlane(Vector3 p1, Vector3 p2, Vector3 p3)
+{
+    Vector3 n = Vector3Normalize(Vector3CrossProduct(Vector3Subtract(p2, p1), Vector3Subtract(p3, p1)));
+    return (Vector4){ n.x, n.y, n.z, -Vector3DotProduct(n, p1) };
+}
+
+static inline float Cross2(Vector3 a, Vector3 b, Vector3 p)
+{
+    return (b.x - a.x) * (p.z - a.z) - (b.z - a.z) * (p.x - a.x);
+}
+
+static bool PointInTriangleXZ(Vector3 p, Vector3 a, Vector3 b, Vector3 c)
+{
+    float d0 = Cross2(a, b, p);
+    float d1 = Cross2(b, c, p);
+    float d2 = Cross2(c, a, p);
+    bool hasNeg = (d0 < -SURFACE_EDGE_EPSILON) || (d1 < -SURFACE_EDGE_EPSILON) || (d2 < -SURFACE_EDGE_EPSILON);
+    bool hasPos = (d0 > SURFACE_EDGE_EPSILON) || (d1 > SURFACE_EDGE_EPSILON) || (d2 > SURFACE_EDGE_EPSILON);
+    return !(hasNeg && hasPos);
+}
+
+// Test the two triangles of a segment and project the point vertically onto the one it is over
+static bool TestSegment(const TrackSurfaceSegment *seg, Vector3 p, TrackSurfaceHit *hit)
+{
+    const Vector3 *c = seg->corners;
+    int tri = -1;
+
+    if (PointInTriangleXZ(p, c[0], c[2], c[1])) tri = 0;
+    else if (PointInTriangleXZ(p, c[1], c[2], c[3])) tri = 1;
+    if (tri < 0) return false;
+
+    Vector4 plane = seg->planes[tri];
+    if (fabsf(plane.y) < SURFACE_EDGE_EPSILON) return false; // Vertical triangle, can't stand on it
+
+    // Blend the row normals by how far along the segment the point is, so orientation
+    // changes smoothly through banking instead of stepping at every triangle
+    float fromStart = fmaxf(EdgeSide(seg->startEdge, p), 0.0f);
+    float fromEnd = fmaxf(EdgeSide(seg->endEdge, p), 0.0f);
+    float t = (fromStart + fromEnd > 0.0f)? fromStart / (fromStart + fromEnd) : 0.0f;
+
+    hit->hit = true;
+    hit->height = -(plane.x * p.x + plane.z * p.z + plane.w) / plane.y;
+    hit->normal = Vector3Normalize(Vector3Lerp(seg->normals[0], seg->normals[1], t));
+    return true;
+}
+
+// Separating axis test between a segment quad (corners in TrackSurfaceSegment order) and a grid cell, both in XZ
+static bool QuadOverlapsCell(const Vector3 *c, float minX, float minZ, float maxX, float maxZ)
+{
+    static const int ring[4] = { 0, 1, 3, 2 };
+
+    for (int e = 0; e < 4; e++)
+    {
+        Vector3 a = c[ring[e]];
+        Vector3 b = c[ring[(e + 1) % 4]];
+        float nx = -(b.z - a.z);
+        float nz = b.x - a.x;
+
+        float quadMin = FLT_MAX, quadMax = -FLT_MAX;
+        for (int k = 0; k < 4; k++)
+        {
+            float d = nx * c[k].x + nz * c[k].z;
+            quadMin = fminf(quadMin, d);
+            quadMax = fmaxf(quadMax, d);
+        }
+
+        float cellMin = FLT_MAX, cellMax = -FLT_MAX;
+        float xs[2] = { minX, maxX };
+        float zs[2] = { minZ, maxZ };
+        for (int k = 0; k < 4; k++)
+        {
+            float d = nx * xs[k & 1] + nz * zs[k >> 1];
+            cellMin = fminf(cellMin, d);
+            cellMax = fmaxf(cellMax, d);
+        }
+
+        if ((quadMax < cellMin) || (cellMax < quadMin)) return false;
+    }
+
+    return true;
+}
+
+static void QuadBoundsXZ(const Vector3 *c, float *minX, float *minZ, float *maxX, float *maxZ)
+{
+    *minX = *minZ = FLT_MAX;
+    *maxX = *maxZ = -FLT_MAX;
+    for (int k = 0; k < 4; k++)
+    {
+        *minX = fminf(*minX, c[k].x);
+        *maxX = fmaxf(*maxX, c[k].x);
+        *minZ = fminf(*minZ, c[k].z);
+        *maxZ = fmaxf(*maxZ, c[k].z);
+    }
+}
+
+// Corners of segment i in TrackSurfaceSegment order
+static void GetRibbonQuad(const TrackRibbon *ribbon, int i, Vector3 *c)
+{
+    const Vector3 *v = (const Vector3 *)ribbon->vertices;
+    int next = (i + 1) % ribbon->rowCount;
+    c[0] = v[i * 2];
+    c[1] = v[i * 2 + 1];
+    c[2] = v[next * 2];
+    c[3] = v[next * 2 + 1];
+}
+
+// Grid placement for a ribbon, worked out from the ribbon alone so the memory for the
+// grid can be reserved before it is built
+typedef struct SurfaceGridLayout {
+    Vector2 origin;
+    float cellSize;
+    int width;
+    int height;
+    int entryCount;     // Segment-cell overlaps, the length of cellSegments (if counted)
+} SurfaceGridLayout;
+
+// Cells a quad overlaps. With 'cellStart' given, bumps each cell's count (in the next cell's
+// slot, ready for the prefix sum); with 'cellSegments' too, appends 'segment' to each cell's
+// list using 'cellStart' as the write positions. Returns the number of overlaps.
+static int AddQuadToCells(const SurfaceGridLayout *layout, const Vector3 *c, int *cellStart, int *cellSegments, int segment)
+{
+    float minX = layout->origin.x, minZ = layout->origin.y, cellSize = layout->cellSize;
+    float sx0, sz0, sx1, sz1;
+    QuadBoundsXZ(c, &sx0, &sz0, &sx1, &sz1);
+
+    int cx0 = (int)((sx0 - minX) / cellSize), cx1 = (int)((sx1 - minX) / cellSize);
+    int cz0 = (int)((sz0 - minZ) / cellSize), cz1 = (int)((sz1 - minZ) / cellSize);
+    int count = 0;
+
+    for (int cz = cz0; cz <= cz1; cz++)
+    {
+        for (int cx = cx0; cx <= cx1; cx++)
+        {
+            float x0 = minX + cx * cellSize, z0 = minZ + cz * cellSize;
+            if (!QuadOverlapsCell(c, x0, z0, x0 + cellSize, z0 + cellSize)) continue;
+
+            int cell = cz * layout->width + cx;
+            if (cellSegments != NULL) cellSegments[cellStart[cell]++] = segment;
+            else if (cellStart != NULL) cellStart[cell + 1]++;
+            count++;
+        }
+    }
+
+    return count;
+}
+
+static SurfaceGridLayout GetSurfaceGridLayout(const TrackRibbon *ribbon, bool countEntries)
+{
+    float minX = FLT_MAX, minZ = FLT_MAX, maxX = -FLT_MAX, maxZ = -FLT_MAX;
+    float totalArea = 0.0f;
+
+    for (int i = 0; i < ribbon->rowCount; i++)
+    {
+        Vector3 c[4];
+        float sx0, sz0, sx1, sz1;
+        GetRibbonQuad(ribbon, i, c);
+        QuadBoundsXZ(c, &sx0, &sz0, &sx1, &sz1);
+        minX = fminf(minX, sx0); minZ = fminf(minZ, sz0);
+        maxX = fmaxf(maxX, sx1); maxZ = fmaxf(maxZ, sz1);
+
+        totalArea += 0.5f * fabsf(Cross2(c[0], c[2], c[1])) + 0.5f * fabsf(Cross2(c[1], c[2], c[3]));
+    }
+
+    // Aim for cells a few quads across, capped so the grid stays small on huge tracks
+    float cellSize = 4.0f * sqrtf(totalArea / (float)ribbon->rowCount);
+    float extent = fmaxf(maxX - minX, maxZ - minZ);
+    if (cellSize < extent / SURFACE_MAX_GRID_DIM) cellSize = extent / SURFACE_MAX_GRID_DIM;
+    if (cellSize <= 0.0f) cellSize = 1.0f;
+
+    SurfaceGridLayout layout = { 0 };
+    layout.origin = (Vector2){ minX, minZ };
+    layout.cellSize = cellSize;
+    layout.width = (int)((maxX - minX) / cellSize) + 1;
+    layout.height = (int)((maxZ - minZ) / cellSize) + 1;
+
+    for (int i = 0; countEntries && (i < ribbon->rowCount); i++)
+    {
+        Vector3 c[4];
+        GetRibbonQuad(ribbon, i, c);
+        layout.entryCount += AddQuadToCells(&layout, c, NULL, NULL, i);
+    }
+
+    return layout;
+}
+
+static void BuildSurfaceGrid(TrackSurface *surface, SurfaceGridLayout layout, MemArena *arena)
+{
+    surface->gridOrigin = layout.origin;
+    surface->cellSize = layout.cellSize;
+    surface->gridWidth = layout.width;
+    surface->gridHeight = layout.height;
+
+    int cellCount = surface->gridWidth * surface->gridHeight;
+    surface->cellStart = (int *)ArenaCalloc(arena, cellCount + 1, sizeof(int));
+
+    // CSR layout: count per cell, prefix sum to get each cell's start, then fill with the
+    // starts as write positions. Filling leaves every start on the next cell's, so they are
+    // shifted back afterwards instead of keeping a separate cursor array.
+    for (int i = 0; i < surface->segmentCount; i++) AddQuadToCells(&layout, surface->segments[i].corners, surface->cellStart, NULL, i);
+    for (int i = 0; i < cellCount; i++) surface->cellStart[i + 1] += surface->cellStart[i];
+    surface->cellSegments = (int *)ArenaAlloc(arena, (surface->cellStart[cellCount] + 1) * sizeof(int));
+    for (int i = 0; i < surface->segmentCount; i++) AddQuadToCells(&layout, surface->segments[i].corners, surface->cellStart, surface->cellSegments, i);
+    for (int i = cellCount; i > 0; i--) surface->cellStart[i] = surface->cellStart[i - 1];
+    surface->cellStart[0] = 0;
+}
+
+// Arena space BuildTrackSurface() needs for this ribbon
+size_t GetTrackSurfaceSize(const TrackRibbon *ribbon)
+{
+    SurfaceGridLayout layout = GetSurfaceGridLayout(ribbon, true);
+    int cellCount = layout.width * layout.height;
+
+    return GetArenaAllocSize(ribbon->rowCount * sizeof(TrackSurfaceSegment)) + GetArenaAllocSize((cellCount + 1) * sizeof(int)) +
+           GetArenaAllocSize((layout.entryCount + 1) * sizeof(int));
+}
+
+// Build the surface index from the generators' ribbon, one segment per row. Everything
+// it points to lives in 'arena', which needs GetTrackSurfaceSize() bytes free.
+void BuildTrackSurface(TrackSurface *surface, const TrackRibbon *ribbon, MemArena *arena)
+{
+    surface->segmentCount = ribbon->rowCount;
+    surface->segments = (TrackSurfaceSegment *)ArenaAlloc(arena, surface->segmentCount * sizeof(TrackSurfaceSegment));
+
+    for (int i = 0; i < surface->segmentCount; i++)
+    {
+        TrackSurfaceSegment *seg = &surface->segments[i];
+        int next = (i + 1) % ribbon->rowCount;
+
+        GetRibbonQuad(ribbon, i, seg->corners);
+        seg->normals[0] = *(const Vector3 *)&ribbon->normals[i * 6];
+        seg->normals[1] = *(const Vector3 *)&ribbon->normals[next * 6];
+
+        seg->planes[0] = TrianglePlane(seg->corners[0], seg->corners[2], seg->corners[1]);
+        seg->planes[1] = TrianglePlane(seg->corners[1], seg->corners[2], seg->corners[3]);
+
+        Vector3 startMid = Vector3Scale(Vector3Add(seg->corners[0], seg->corners[1]), 0.5f);
+        Vector3 endMid = Vector3Scale(Vector3Add(seg->corners[2], seg->corners[3]), 0.5f);
+        seg->startEdge = EdgeLine(seg->corners[0], seg->corners[1], endMid);
+        seg->endEdge = EdgeLine(seg->corners[2], seg->corners[3], startMid);
+    }
+
+    BuildSurfaceGrid(surface, GetSurfaceGridLayout(ribbon, false), arena);
+}
+
+static TrackSurfaceHit QuerySurfaceGrid(const TrackSurface *surface, Vector3 position)
+{
+    TrackSurfaceHit best = { false, 0.0f, { 0.0f, 1.0f, 0.0f }, -1 };
+
+    int cx = (int)floorf((position.x - surface->gridOrigin.x) / surface->cellSize);
+    int cz = (int)floorf((position.z - surface->gridOrigin.y) / surface->cellSize);
+    if ((cx < 0) || (cz < 0) || (cx >= surface->gridWidth) || (cz >= surface->gridHeight)) return best;
+
+    int cell = cz * surface->gridWidth + cx;
+    float bestDistance = FLT_MAX;
+
+    // Where the ribbon overlaps itself, prefer the layer closest to the query height
+    for (int k = surface->cellStart[cell]; k < surface->cellStart[cell + 1]; k++)
+    {
+        int s = surface->cellSegments[k];
+        TrackSurfaceHit hit = { 0 };
+        if (TestSegment(&surface->segments[s], position, &hit))
+        {
+            float distance = fabsf(position.y - hit.height);
+            if (distance < bestDistance)
+            {
+                bestDistance = distance;
+                best = hit;
+                best.segment = s;
+            }
+        }
+    }
+
+    return best;
+}
+
+// Walk the ribbon from the last known segment; only the grid fallback is proportional to local density
+TrackSurfaceHit QueryTrackSurface(const TrackSurface *surface, Vector3 position, int lastSegment)
+{
+    if ((lastSegment >= 0) && (lastSegment < surface->segmentCount))
+    {
+        int s = lastSegment;
+
+        for (int step = 0; step < SURFACE_WALK_LIMIT; step++)
+        {
+            const TrackSurfaceSegment *seg = &surface->segments[s];
+
+            if (EdgeSide(seg->startEdge, position) < 0.0f)
+            {
+                s = (s == 0)? surface->segmentCount - 1 : s - 1;
+            }
+            else if (EdgeSide(seg->endEdge, position) < 0.0f)
+            {
+                s = (s + 1 == surface->segmentCount)? 0 : s + 1;
+            }
+            else
+            {
+                TrackSurfaceHit hit = { 0 };
+                if (TestSegment(seg, position, &hit))
+                {
+                    hit.segment = s;
+                    return hit;
+                }
+                break; // Off the side of the ribbon, or on another layer of it
+            }
+        }
+    }
+
+    return QuerySurfaceGrid(surface, position);
+}
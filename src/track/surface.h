@@ -0,0 +1,63 @@
+#ifndef SURFACE_H
+#define SURFACE_H
+
+#include <raylib.h>
+#include "../mem/arena.h"
+
+// Result of a track surface query
+typedef struct TrackSurfaceHit {
+    bool hit;
+    float height;       // Surface height below the query point
+    Vector3 normal;     // Ribbon normal blended along the segment
+    int segment;        // Segment index, feed it back as the hint for the next query
+} TrackSurfaceHit;
+
+// Orientation of the track at one ribbon row
+typedef struct TrackFrame {
+    Vector3 position;   // Centreline
+    Vector3 forward;    // Direction of travel, following the slope
+    Vector3 side;       // Towards the outer vertex, banked
+    Vector3 up;         // Surface normal
+    float width;
+    float distance;     // Along the centreline from row 0
+} TrackFrame;
+
+// Track geometry as the generators produce it, before it is cut into chunk meshes: an inner
+// and an outer vertex per row, segment i spanning rows i and i + 1, the last one closing onto row 0
+typedef struct TrackRibbon {
+    float *vertices;    // 2 xyz per row, inner first
+    float *texcoords;   // 2 uv per row
+    float *normals;     // 2 xyz per row
+    TrackFrame *frames; // 1 per row
+    int rowCount;
+} TrackRibbon;
+
+// One quad of the track ribbon, split into two triangles along the c1-c2 diagonal
+typedef struct TrackSurfaceSegment {
+    Vector3 corners[4]; // Inner/outer at the segment start, inner/outer at the segment end
+    Vector4 planes[2];  // Triangle planes (xyz = normal, w = distance)
+    Vector3 normals[2]; // Ribbon normals at the segment's start and end, blended for hits
+    Vector3 startEdge;  // XZ line (a, b, c) through corners 0-1, a*x + b*z + c >= 0 inside the segment
+    Vector3 endEdge;    // XZ line through corners 2-3
+} TrackSurfaceSegment;
+
+// Acceleration structure for surface queries, built once per track into its arena
+typedef struct TrackSurface {
+    TrackSurfaceSegment *segments;
+    int segmentCount;
+
+    // Uniform XZ grid used when the segment walk can't start from a hint
+    Vector2 gridOrigin;
+    float cellSize;
+    int gridWidth;
+    int gridHeight;
+    int *cellStart;     // gridWidth*gridHeight + 1 offsets into cellSegments
+    int *cellSegments;
+} TrackSurface;
+
+// Function declarations
+size_t GetTrackSurfaceSize(const TrackRibbon *ribbon);
+void BuildTrackSurface(TrackSurface *surface, const TrackRibbon *ribbon, MemArena *arena);
+TrackSurfaceHit QueryTrackSurface(const TrackSurface *surface, Vector3 position, int lastSegment);
+
+#endif // SURFACE_H
@@ -4,17 +4,15 @@
 #include <rlgl.h>
 #include <stdlib.h>
 #include <math.h>
-
-#include "track.h"
-#include <raylib.h>
-#include <raymath.h>
-#include <rlgl.h>
-#include <stdlib.h>
-#include <math.h>
+#include <string.h>
+#include "../texture/cache.h"
+#include "../mem/budget.h"
+#include "../render/vertices.h"
 
 // Custom function to get track surface info (approximated normal and height)
 // This is a simplified approach for fixed-function pipeline
-Vector3 GetTrackSurfaceInfo(Vector3 shipPos, Mesh trackMesh, float *outHeight)
+// Brute-force raycast against every triangle; kept as the reference for QueryTrackSurface()
+Vector3 GetTrackSurfaceInfo(Vector3 shipPos, const TrackRibbon *ribbon, float *outHeight)
 {
     Vector3 normal = { 0.0f, 1.0f, 0.0f }; // Default to flat normal
     *outHeight = 0.0f; // Default height
@@ -24,9 +22,19 @@ Vector3 GetTrackSurfaceInfo(Vector3 shipPos, Mesh trackMesh, float *outHeight)
     ray.position = (Vector3){ shipPos.x, 100.0f, shipPos.z }; // Start ray from a safe height above the track
     ray.direction = (Vector3){ 0.0f, -1.0f, 0.0f }; // Pointing straight down
 
-    // Get collision info between the ray and the track mesh
-    // Assuming trackModel.transform is identity, otherwise it should be passed here
-    RayCollision collision = GetRayCollisionMesh(ray, trackMesh, MatrixIdentity());
+    // Test both triangles of every segment and keep the closest hit
+    const Vector3 *v = (const Vector3 *)ribbon->vertices;
+    RayCollision collision = { 0 };
+    for (int i = 0; i < ribbon->rowCount; i++)
+    {
+        int next = (i + 1) % ribbon->rowCount;
+        Vector3 c0 = v[i * 2], c1 = v[i * 2 + 1], c2 = v[next * 2], c3 = v[next * 2 + 1];
+
+        RayCollision first = GetRayCollisionTriangle(ray, c0, c2, c1);
+        RayCollision second = GetRayCollisionTriangle(ray, c1, c2, c3);
+        if (first.hit && (!collision.hit || (first.distance < collision.distance))) collision = first;
+        if (second.hit && (!collision.hit || (second.distance < collision.distance))) collision = second;
+    }
 
     if (collision.hit)
     {
@@ -39,25 +47,75 @@ Vector3 GetTrackSurfaceInfo(Vector3 shipPos, Mesh trackMesh, float *outHeight)
     return normal;
 }
 
-// Custom function to generate a simple non-flat track mesh
-Mesh GenMeshTrack(float radius, float width, int segments, float heightVariation, float twistAmount, Vector3 **outWaypoints, int *outWaypointCount)
+// Ribbon with room for 'rows' rows, for the generators to fill with SetTrackRibbonRow().
+// It only lives while the track loads, so all of its arrays share one allocation.
+TrackRibbon AllocTrackRibbon(int rows)
+{
+    TrackRibbon ribbon = { 0 };
+    size_t frameBytes = rows * sizeof(TrackFrame);
+    size_t floats = rows * 2 * (3 + 2 + 3);
+    unsigned char *block = (unsigned char *)RL_MALLOC(frameBytes + floats * sizeof(float));
+
+    ribbon.rowCount = rows;
+    ribbon.frames = (TrackFrame *)block; block += frameBytes;
+    ribbon.vertices = (float *)block; block += rows * 2 * 3 * sizeof(float);
+    ribbon.texcoords = (float *)block; block += rows * 2 * 2 * sizeof(float);
+    ribbon.normals = (float *)block;
+    return ribbon;
+}
+
+void UnloadTrackRibbon(TrackRibbon *ribbon)
+{
+    RL_FREE(ribbon->frames); // Start of the block
+    *ribbon = (TrackRibbon){ 0 };
+}
+
+// Frame of a track 'width' wide at 'position' heading along 'forward', rolled by 'roll' degrees
+// about it. Positive roll raises the outer edge. Without roll the side vector stays level.
+TrackFrame GetTrackFrame(Vector3 position, Vector3 forward, float width, float roll)
 {
-    Mesh mesh = { 0 };
-    int numVertices = segments * 2; // Two vertices per segment (inner and outer edge)
-    int numTriangles = segments * 2; // Two triangles per segment
+    Vector3 f = Vector3Normalize(forward);
+    Vector3 side = Vector3Normalize(Vector3CrossProduct((Vector3){ 0.0f, 1.0f, 0.0f }, f));
+    Vector3 up = Vector3CrossProduct(f, side);
+    float c = cosf(roll * DEG2RAD);
+    float s = sinf(roll * DEG2RAD);
+
+    TrackFrame frame = { 0 };
+    frame.position = position;
+    frame.forward = f;
+    frame.side = Vector3Add(Vector3Scale(side, c), Vector3Scale(up, s));
+    frame.up = Vector3Subtract(Vector3Scale(up, c), Vector3Scale(side, s));
+    frame.width = width;
+    return frame;
+}
 
-    mesh.vertexCount = numVertices;
-    mesh.triangleCount = numTriangles;
+// Write the inner and outer vertex of a row from its frame. Both share the frame's normal.
+void SetTrackRibbonRow(TrackRibbon *ribbon, int row, TrackFrame frame, float u)
+{
+    Vector3 inner = Vector3Subtract(frame.position, Vector3Scale(frame.side, frame.width / 2.0f));
+    Vector3 outer = Vector3Add(frame.position, Vector3Scale(frame.side, frame.width / 2.0f));
 
-    mesh.vertices = (float *)RL_MALLOC(numVertices * 3 * sizeof(float));
-    mesh.texcoords = (float *)RL_MALLOC(numVertices * 2 * sizeof(float));
-    mesh.normals = (float *)RL_MALLOC(numVertices * 3 * sizeof(float));
-    mesh.indices = (unsigned short *)RL_MALLOC(numTriangles * 3 * sizeof(unsigned short));
+    memcpy(&ribbon->vertices[row * 6 + 0], &inner, sizeof(Vector3));
+    memcpy(&ribbon->vertices[row * 6 + 3], &outer, sizeof(Vector3));
+    memcpy(&ribbon->normals[row * 6 + 0], &frame.up, sizeof(Vector3));
+    memcpy(&ribbon->normals[row * 6 + 3], &frame.up, sizeof(Vector3));
+
+    ribbon->texcoords[row * 4 + 0] = u;     // U along the track
+    ribbon->texcoords[row * 4 + 1] = 0.0f;  // V across it, inner to outer
+    ribbon->texcoords[row * 4 + 2] = u;
+    ribbon->texcoords[row * 4 + 3] = 1.0f;
+
+    ribbon->frames[row] = frame;
+}
 
-    *outWaypointCount = segments;
-    *outWaypoints = (Vector3 *)RL_MALLOC(segments * sizeof(Vector3));
+// Custom function to generate a simple non-flat track. 'twistAmount' banks the whole
+// oval into the turn by that many degrees.
+TrackRibbon GenTrackRibbon(float radius, float width, int segments, float heightVariation, float twistAmount)
+{
+    TrackRibbon ribbon = AllocTrackRibbon(segments); // One row (inner and outer edge) per segment
 
     float angleStep = 360.0f / segments; // Degrees per segment
+    float distance = 0.0f;
 
     for (int i = 0; i < segments; i++)
     {
@@ -68,88 +126,28 @@ Mesh GenMeshTrack(float radius, float width, int segments, float heightVariation
         float currentHeight = heightVariation * sinf(radAngle * 2.0f); // Simple sine wave for height
 
         // Waypoint at the center of the track segment
-        (*outWaypoints)[i].x = radius * cosf(radAngle);
-        (*outWaypoints)[i].y = currentHeight;
-        (*outWaypoints)[i].z = radius * sinf(radAngle);
-
-        // Inner vertex
-        mesh.vertices[i * 6 + 0] = (radius - width / 2.0f) * cosf(radAngle);
-        mesh.vertices[i * 6 + 1] = currentHeight;
-        mesh.vertices[i * 6 + 2] = (radius - width / 2.0f) * sinf(radAngle);
-
-        // Outer vertex
-        mesh.vertices[i * 6 + 3] = (radius + width / 2.0f) * cosf(radAngle);
-        mesh.vertices[i * 6 + 4] = currentHeight;
-        mesh.vertices[i * 6 + 5] = (radius + width / 2.0f) * sinf(radAngle);
-
-        // Texture coordinates (simple mapping)
-        mesh.texcoords[i * 4 + 0] = (float)i / segments; // U for inner
-        mesh.texcoords[i * 4 + 1] = 0.0f;                // V for inner
-        mesh.texcoords[i * 4 + 2] = (float)i / segments; // U for outer
-        mesh.texcoords[i * 4 + 3] = 1.0f;                // V for outer
-
-        // Normals (simplified for now, will be calculated more accurately later)
-        // For now, assume flat normal, will be updated by surface scanning
-        mesh.normals[i * 6 + 0] = 0.0f;
-        mesh.normals[i * 6 + 1] = 1.0f;
-        mesh.normals[i * 6 + 2] = 0.0f;
-        mesh.normals[i * 6 + 3] = 0.0f;
-        mesh.normals[i * 6 + 4] = 1.0f;
-        mesh.normals[i * 6 + 5] = 0.0f;
-    }
+        Vector3 center = { radius * cosf(radAngle), currentHeight, radius * sinf(radAngle) };
 
-    // Generate indices for a closed loop track
-    int index = 0;
-    for (int i = 0; i < segments; i++)
-    {
-        int i0 = i * 2;
-        int i1 = (i * 2 + 1);
-        int i2 = ((i + 1) % segments) * 2;
-        int i3 = (((i + 1) % segments) * 2 + 1);
+        // Derivative of the centreline, so the frame follows the slope
+        Vector3 tangent = { -radius * sinf(radAngle), 2.0f * heightVariation * cosf(radAngle * 2.0f), radius * cosf(radAngle) };
 
-        // First triangle of quad
-        mesh.indices[index++] = i0;
-        mesh.indices[index++] = i2;
-        mesh.indices[index++] = i1;
+        if (i > 0) distance += Vector3Distance(ribbon.frames[i - 1].position, center);
 
-        // Second triangle of quad
-        mesh.indices[index++] = i1;
-        mesh.indices[index++] = i2;
-        mesh.indices[index++] = i3;
+        TrackFrame frame = GetTrackFrame(center, tangent, width, twistAmount);
+        frame.distance = distance;
+        SetTrackRibbonRow(&ribbon, i, frame, (float)i / segments);
     }
 
-    UploadMesh(&mesh, false);
-
-    return mesh;
+    return ribbon;
 }
 
-void InitTrack(Track *track, float radius, float width, int segments, float heightVariation, float twistAmount, Texture2D trackTexture)
+// Custom function to generate a figure 8 track
+TrackRibbon GenFigure8TrackRibbon(float loopRadius, float trackWidth, int segmentsPerLoop, float heightVariation)
 {
-    track->model = LoadModelFromMesh(GenMeshTrack(radius, width, segments, heightVariation, twistAmount, &track->waypoints, &track->waypointCount));
-    track->texture = trackTexture;
-    track->model.materials[0].maps[MATERIAL_MAP_DIFFUSE].texture = track->texture;
-}
-
-// Custom function to generate a figure 8 track mesh
-Mesh GenMeshFigure8Track(float loopRadius, float trackWidth, int segmentsPerLoop, float heightVariation, Vector3 **outWaypoints, int *outWaypointCount)
-{
-    Mesh mesh = { 0 };
     int totalSegments = segmentsPerLoop * 2; // Two loops for figure 8
-    int numVertices = totalSegments * 2; // Two vertices per segment (inner and outer edge)
-    int numTriangles = totalSegments * 2; // Two triangles per segment
-
-    mesh.vertexCount = numVertices;
-    mesh.triangleCount = numTriangles;
+    TrackRibbon ribbon = AllocTrackRibbon(totalSegments); // One row (inner and outer edge) per segment
 
-    mesh.vertices = (float *)RL_MALLOC(numVertices * 3 * sizeof(float));
-    mesh.texcoords = (float *)RL_MALLOC(numVertices * 2 * sizeof(float));
-    mesh.normals = (float *)RL_MALLOC(numVertices * 3 * sizeof(float));
-    mesh.indices = (unsigned short *)RL_MALLOC(numTriangles * 3 * sizeof(unsigned short));
-
-    *outWaypointCount = totalSegments;
-    *outWaypoints = (Vector3 *)RL_MALLOC(totalSegments * sizeof(Vector3));
-
-    
+    float distance = 0.0f;
 
     for (int i = 0; i < totalSegments; i++)
     {
@@ -163,95 +161,280 @@ Mesh GenMeshFigure8Track(float loopRadius, float trackWidth, int segmentsPerLoop
         float currentHeight = heightVariation * sinf(t * 2.0f); // Simple sine wave for height
 
         // Waypoint at the center of the track segment
-        (*outWaypoints)[i].x = x;
-        (*outWaypoints)[i].y = currentHeight;
-        (*outWaypoints)[i].z = z;
-
-        // Calculate tangent for track width
-        // Numerical differentiation for tangent
-        float dt = 0.001f;
-        float x_plus_dt = loopRadius * sinf(t + dt);
-        float z_plus_dt = loopRadius * sinf(t + dt) * cosf(t + dt);
-
-        float tangentX = x_plus_dt - x;
-        float tangentZ = z_plus_dt - z;
-
-        // Normalize tangent
-        float tangentLength = sqrtf(tangentX * tangentX + tangentZ * tangentZ);
-        if (tangentLength > 0) {
-            tangentX /= tangentLength;
-            tangentZ /= tangentLength;
-        }
+        Vector3 center = { x, currentHeight, z };
+
+        // Derivative of the centreline (z = loopRadius * sin(2t) / 2)
+        Vector3 tangent = { loopRadius * cosf(t), 2.0f * heightVariation * cosf(t * 2.0f), loopRadius * cosf(t * 2.0f) };
 
-        // Perpendicular vector for track width (rotated 90 degrees from tangent)
-        float perpX = -tangentZ;
-        float perpZ = tangentX;
-
-        // Inner vertex
-        mesh.vertices[i * 6 + 0] = x + (trackWidth / 2.0f) * perpX;
-        mesh.vertices[i * 6 + 1] = currentHeight;
-        mesh.vertices[i * 6 + 2] = z + (trackWidth / 2.0f) * perpZ;
-
-        // Outer vertex
-        mesh.vertices[i * 6 + 3] = x - (trackWidth / 2.0f) * perpX;
-        mesh.vertices[i * 6 + 4] = currentHeight;
-        mesh.vertices[i * 6 + 5] = z - (trackWidth / 2.0f) * perpZ;
-
-        // Texture coordinates (simple mapping)
-        mesh.texcoords[i * 4 + 0] = (float)i / totalSegments; // U for inner
-        mesh.texcoords[i * 4 + 1] = 0.0f;                // V for inner
-        mesh.texcoords[i * 4 + 2] = (float)i / totalSegments; // U for outer
-        mesh.texcoords[i * 4 + 3] = 1.0f;                // V for outer
-
-        // Normals (simplified for now, will be updated by surface scanning)
-        mesh.normals[i * 6 + 0] = 0.0f;
-        mesh.normals[i * 6 + 1] = 1.0f;
-        mesh.normals[i * 6 + 2] = 0.0f;
-        mesh.normals[i * 6 + 3] = 0.0f;
-        mesh.normals[i * 6 + 4] = 1.0f;
-        mesh.normals[i * 6 + 5] = 0.0f;
+        if (i > 0) distance += Vector3Distance(ribbon.frames[i - 1].position, center);
+
+        TrackFrame frame = GetTrackFrame(center, tangent, trackWidth, 0.0f);
+        frame.distance = distance;
+        SetTrackRibbonRow(&ribbon, i, frame, (float)i / totalSegments);
+    }
+
+    return ribbon;
+}
+
+// Copy one ribbon vertex (side 0 inner, 1 outer). 'row' may run past the end of the loop,
+// in which case U keeps increasing across the seam instead of jumping back to 0.
+static void CopyRibbonVertex(TrackVertex *vertex, const TrackRibbon *ribbon, int row, int side)
+{
+    int source = (row % ribbon->rowCount) * 2 + side;
+    memcpy(&vertex->position, &ribbon->vertices[source * 3], sizeof(Vector3));
+    memcpy(&vertex->texcoord, &ribbon->texcoords[source * 2], sizeof(Vector2));
+    vertex->texcoord.x += (float)(row / ribbon->rowCount);
+}
+
+// Indexed triangle list for 'segments' segments from row 'first', two triangles per segment.
+// Writes (segments + 1) * 2 vertices and segments * 6 indices.
+static void GenTrackList(TrackVertex *vertices, unsigned short *indices, const TrackRibbon *ribbon, int first, int segments)
+{
+    // Each chunk repeats the first row of the next one so chunks meet without gaps
+    for (int r = 0; r <= segments; r++)
+    {
+        CopyRibbonVertex(&vertices[r * 2], ribbon, first + r, 0);
+        CopyRibbonVertex(&vertices[r * 2 + 1], ribbon, first + r, 1);
     }
 
-    // Generate indices for a closed loop track
     int index = 0;
-    for (int i = 0; i < totalSegments; i++)
+    for (int i = 0; i < segments; i++)
     {
         int i0 = i * 2;
-        int i1 = (i * 2 + 1);
-        int i2 = ((i + 1) % totalSegments) * 2; // Connect last segment to first
-        int i3 = (((i + 1) % totalSegments) * 2 + 1);
+        int i1 = i * 2 + 1;
+        int i2 = (i + 1) * 2;
+        int i3 = (i + 1) * 2 + 1;
 
         // First triangle of quad
-        mesh.indices[index++] = i0;
-        mesh.indices[index++] = i2;
-        mesh.indices[index++] = i1;
+        indices[index++] = i0;
+        indices[index++] = i2;
+        indices[index++] = i1;
 
         // Second triangle of quad
-        mesh.indices[index++] = i1;
-        mesh.indices[index++] = i2;
-        mesh.indices[index++] = i3;
+        indices[index++] = i1;
+        indices[index++] = i2;
+        indices[index++] = i3;
     }
+}
 
-    UploadMesh(&mesh, false);
+// Vertices GenTrackStrips() writes for these runs
+int GetTrackStripVertexCount(const int *runSegments, int runCount)
+{
+    int count = runCount - 1;   // Repeats of each previous strip's last vertex
+    for (int k = 0; k < runCount; k++) count += 1 + (runSegments[k] + 1) * 2;
+    return count;
+}
 
-    return mesh;
+// Non-indexed triangle strip covering each run of segments, one strip per run.
+// Vertices alternate inner/outer, so every vertex is submitted once instead of three
+// times. Each strip starts with its first vertex doubled, which puts the strip on an odd
+// vertex and gives its triangles the same winding and diagonal as the indexed list.
+// Strips are joined by also repeating the previous strip's last vertex, so the whole
+// run is still one draw with only zero-area triangles in between (every strip has an
+// even length, so the parity holds). Runs may cross the closed loop's seam.
+// Returns the number of vertices written.
+int GenTrackStrips(TrackVertex *vertices, const TrackRibbon *ribbon, const int *runFirst, const int *runSegments, int runCount)
+{
+    int v = 0;
+    for (int k = 0; k < runCount; k++)
+    {
+        if (v > 0)
+        {
+            vertices[v] = vertices[v - 1];
+            v++;
+        }
+
+        CopyRibbonVertex(&vertices[v++], ribbon, runFirst[k], 0);
+        for (int r = 0; r <= runSegments[k]; r++)
+        {
+            CopyRibbonVertex(&vertices[v++], ribbon, runFirst[k] + r, 0);
+            CopyRibbonVertex(&vertices[v++], ribbon, runFirst[k] + r, 1);
+        }
+    }
+
+    return v;
+}
+
+static BoundingBox GetVertexBounds(const TrackVertex *vertices, int vertexCount)
+{
+    BoundingBox bounds = { vertices[0].position, vertices[0].position };
+    for (int i = 1; i < vertexCount; i++)
+    {
+        bounds.min = Vector3Min(bounds.min, vertices[i].position);
+        bounds.max = Vector3Max(bounds.max, vertices[i].position);
+    }
+    return bounds;
+}
+
+static int GetChunkSegments(const TrackRibbon *ribbon, int chunk)
+{
+    int first = chunk * TRACK_CHUNK_SEGMENTS;
+    return (ribbon->rowCount - first < TRACK_CHUNK_SEGMENTS)? ribbon->rowCount - first : TRACK_CHUNK_SEGMENTS;
+}
+
+// Vertex and index totals for every chunk of the ribbon
+static void GetTrackChunkCounts(const TrackRibbon *ribbon, TrackPrimitive primitive, int *vertexCount, int *indexCount)
+{
+    int chunkCount = (ribbon->rowCount + TRACK_CHUNK_SEGMENTS - 1) / TRACK_CHUNK_SEGMENTS;
+    *vertexCount = 0;
+    *indexCount = 0;
+
+    for (int c = 0; c < chunkCount; c++)
+    {
+        int segments = GetChunkSegments(ribbon, c);
+        if (primitive == TRACK_STRIPS) *vertexCount += GetTrackStripVertexCount(&segments, 1);
+        else
+        {
+            *vertexCount += (segments + 1) * 2;
+            *indexCount += segments * 6;
+        }
+    }
+}
+
+// Arena space BuildTrack() needs for this ribbon
+size_t GetTrackArenaSize(const TrackRibbon *ribbon, TrackPrimitive primitive)
+{
+    int chunkCount = (ribbon->rowCount + TRACK_CHUNK_SEGMENTS - 1) / TRACK_CHUNK_SEGMENTS;
+    int vertexCount = 0, indexCount = 0;
+    GetTrackChunkCounts(ribbon, primitive, &vertexCount, &indexCount);
+
+    return GetArenaAllocSize(chunkCount * sizeof(TrackChunk)) + GetArenaAllocSize(chunkCount * sizeof(int)) +
+           GetArenaAllocSize(vertexCount * sizeof(TrackVertex)) + GetArenaAllocSize(indexCount * sizeof(unsigned short)) +
+           GetArenaAllocSize(ribbon->rowCount * sizeof(Vector3)) + GetArenaAllocSize(ribbon->rowCount * sizeof(TrackFrame)) +
+           GetTrackSurfaceSize(ribbon);
+}
+
+// Everything a track keeps from its ribbon, in one arena: the surface index, the waypoints and
+// frames, and the chunks, which cut the ribbon into runs of up to TRACK_CHUNK_SEGMENTS segments
+// with their own bounds. All chunks share one interleaved vertex array (and index array for
+// lists, 16-bit per chunk, so track length isn't limited by the index width). CPU only; the
+// ribbon can be unloaded afterwards. False for a ribbon of fewer than 3 rows, which
+// GenSplineTrackRibbon() returns empty when it has too few points.
+bool BuildTrack(Track *track, const TrackRibbon *ribbon, TrackPrimitive primitive)
+{
+    if (ribbon->rowCount < 3)
+    {
+        TraceLog(LOG_WARNING, "TRACK: A track needs at least 3 rows, the ribbon has %i", ribbon->rowCount);
+        return false;
+    }
+    if (!InitArena(&track->arena, GetTrackArenaSize(ribbon, primitive))) return false;
+    MemArena *arena = &track->arena;
+
+    track->primitive = primitive;
+    track->chunkCount = (ribbon->rowCount + TRACK_CHUNK_SEGMENTS - 1) / TRACK_CHUNK_SEGMENTS;
+    track->chunks = (TrackChunk *)ArenaCalloc(arena, track->chunkCount, sizeof(TrackChunk));
+    track->visibleChunks = (int *)ArenaAlloc(arena, track->chunkCount * sizeof(int));
+    track->visibleCount = 0;
+
+    GetTrackChunkCounts(ribbon, primitive, &track->vertexCount, &track->indexCount);
+    track->vertices = (TrackVertex *)ArenaAlloc(arena, track->vertexCount * sizeof(TrackVertex));
+    track->indices = (unsigned short *)ArenaAlloc(arena, track->indexCount * sizeof(unsigned short));
+
+    int vertex = 0, index = 0;
+    for (int c = 0; c < track->chunkCount; c++)
+    {
+        TrackChunk *chunk = &track->chunks[c];
+        int first = c * TRACK_CHUNK_SEGMENTS;
+        int segments = GetChunkSegments(ribbon, c);
+
+        chunk->firstVertex = vertex;
+        chunk->firstIndex = index;
+        if (primitive == TRACK_STRIPS)
+        {
+            chunk->vertexCount = GenTrackStrips(&track->vertices[vertex], ribbon, &first, &segments, 1);
+        }
+        else
+        {
+            GenTrackList(&track->vertices[vertex], &track->indices[index], ribbon, first, segments);
+            chunk->vertexCount = (segments + 1) * 2;
+            chunk->indexCount = segments * 6;
+        }
+
+        chunk->bounds = GetVertexBounds(&track->vertices[vertex], chunk->vertexCount);
+        vertex += chunk->vertexCount;
+        index += chunk->indexCount;
+    }
+
+    // Waypoints are the rows' centreline
+    track->waypointCount = ribbon->rowCount;
+    track->waypoints = (Vector3 *)ArenaAlloc(arena, ribbon->rowCount * sizeof(Vector3));
+    track->frames = (TrackFrame *)ArenaAlloc(arena, ribbon->rowCount * sizeof(TrackFrame));
+    for (int i = 0; i < ribbon->rowCount; i++) track->waypoints[i] = ribbon->frames[i].position;
+    memcpy(track->frames, ribbon->frames, ribbon->rowCount * sizeof(TrackFrame));
+
+    BuildTrackSurface(&track->surface, ribbon, arena);
+
+    return true;
 }
 
-void InitFigure8Track(Track *track, float loopRadius, float trackWidth, int segmentsPerLoop, float heightVariation, Texture2D trackTexture)
+// Material for a built track, taking over the reference to 'trackTexture'
+void LoadTrackMaterial(Track *track, Texture2D trackTexture)
 {
-    track->model = LoadModelFromMesh(GenMeshFigure8Track(loopRadius, trackWidth, segmentsPerLoop, heightVariation, &track->waypoints, &track->waypointCount));
     track->texture = trackTexture;
-    track->model.materials[0].maps[MATERIAL_MAP_DIFFUSE].texture = track->texture;
+    track->material = LoadMaterialDefault();
+    track->material.maps[MATERIAL_MAP_DIFFUSE].texture = track->texture;
+    track->material.maps[MATERIAL_MAP_DIFFUSE].color = DARKGRAY;
 }
 
-void DrawTrack(Track *track)
+// Track through control points: generation and BuildTrack() only, so it can run off the
+// render thread. LoadTrackMaterial() finishes the track. False if it can't be built.
+bool GenSplineTrack(Track *track, const TrackControlPoint *points, int pointCount, TrackSplineSettings settings)
 {
-    DrawModel(track->model, (Vector3){ 0.0f, 0.0f, 0.0f }, 1.0f, DARKGRAY);
+    *track = (Track){ 0 };
+    TrackRibbon ribbon = GenSplineTrackRibbon(points, pointCount, settings);
+    bool built = BuildTrack(track, &ribbon, TRACK_DEFAULT_PRIMITIVE);
+    UnloadTrackRibbon(&ribbon);
+    return built;
+}
+
+// Collect the chunks whose bounds touch the frustum into visibleChunks, nearest first
+int CullTrackChunks(Track *track, const Frustum *frustum, Vector3 viewPosition)
+{
+    int visible = 0;
+
+    for (int c = 0; c < track->chunkCount; c++)
+    {
+        TrackChunk *chunk = &track->chunks[c];
+        if (!IsBoxInFrustum(frustum, chunk->bounds)) continue;
+
+        Vector3 center = Vector3Scale(Vector3Add(chunk->bounds.min, chunk->bounds.max), 0.5f);
+        chunk->viewDistance = Vector3DistanceSqr(center, viewPosition);
+
+        // Insertion sort: only a handful of chunks are ever visible at once
+        int k = visible++;
+        while ((k > 0) && (track->chunks[track->visibleChunks[k - 1]].viewDistance > chunk->viewDistance))
+        {
+            track->visibleChunks[k] = track->visibleChunks[k - 1];
+            k--;
+        }
+        track->visibleChunks[k] = c;
+    }
+
+    track->visibleCount = visible;
+    return visible;
+}
+
+// Queue the chunks inside the view frustum, near to far as the queue will sort them anyway
+void QueueTrack(RenderQueue *queue, Track *track, const Frustum *frustum, Vector3 viewPosition)
+{
+    CullTrackChunks(track, frustum, viewPosition);
+
+    for (int i = 0; i < track->visibleCount; i++)
+    {
+        const TrackChunk *chunk = &track->chunks[track->visibleChunks[i]];
+        const unsigned short *indices = (track->primitive == TRACK_TRIANGLES)? &track->indices[chunk->firstIndex] : NULL;
+        Vector3 center = Vector3Scale(Vector3Add(chunk->bounds.min, chunk->bounds.max), 0.5f);
+        QueueUnlitVertices(queue, RENDER_PASS_WORLD, RENDER_STATE_DEFAULT, &track->vertices[chunk->firstVertex], chunk->vertexCount,
+                           indices, chunk->indexCount, &track->material, center);
+    }
 }
 
+// Everything but the material goes with the arena
 void UnloadTrack(Track *track)
 {
-    UnloadTexture(track->texture);
-    UnloadModel(track->model);
-    RL_FREE(track->waypoints);
+    ReleaseTexture(track->texture);
+    RL_FREE(track->material.maps); // The material's texture belongs to the cache
+    ReleaseAssetMemory(ASSET_TRACK, (uintptr_t)track->arena.base);
+    UnloadArena(&track->arena);
+    *track = (Track){ 0 };
 }
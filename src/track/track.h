@@ -2,24 +2,81 @@
 #define TRACK_H
 
 #include <raylib.h>
+#include "surface.h"
+#include "spline.h"
+#include "../mem/arena.h"
+#include "../render/frustum.h"
+#include "../render/vertices.h"
+#include "../render/queue.h"
 
-// Define the Track structure
+#define TRACK_CHUNK_SEGMENTS 16     // Segments per chunk, the unit of culling
+
+// The track is unlit, so its vertices have no normals; the surface index keeps its own
+typedef UnlitVertex TrackVertex;
+
+// How chunks are built and submitted
+typedef enum {
+    TRACK_TRIANGLES = 0,    // Indexed triangle list
+    TRACK_STRIPS            // One non-indexed triangle strip per run of segments
+} TrackPrimitive;
+
+// Primitive the track generators and trackbake build (e.g. -DTRACK_DEFAULT_PRIMITIVE=TRACK_TRIANGLES to compare)
+#ifndef TRACK_DEFAULT_PRIMITIVE
+#define TRACK_DEFAULT_PRIMITIVE TRACK_STRIPS
+#endif
+
+// A run of consecutive track segments drawn in one call, as a range of the track's vertex
+// (and for lists, index) arrays. List indices are relative to firstVertex.
+typedef struct TrackChunk {
+    int firstVertex;
+    int vertexCount;
+    int firstIndex;
+    int indexCount;         // 0 for strips
+    BoundingBox bounds;
+    float viewDistance;     // Squared distance to the viewpoint of the last CullTrackChunks()
+} TrackChunk;
+
+// Define the Track structure. Everything but the material lives in the track's arena, so
+// loading is one allocation and UnloadTrack() releases it in one go.
 typedef struct Track {
-    Model model;
+    MemArena arena;
+    TrackVertex *vertices;  // Every chunk's vertices, interleaved
+    int vertexCount;
+    unsigned short *indices;
+    int indexCount;
+    TrackChunk *chunks;
+    int chunkCount;
+    int *visibleChunks;     // Chunks that passed the last CullTrackChunks(), nearest first
+    int visibleCount;
+    TrackPrimitive primitive;
+    Material material;
     Texture2D texture;
     Vector3 *waypoints;
     int waypointCount;
+    TrackFrame *frames;     // Orientation at the start of each segment, baked by the generator
+    TrackSurface surface;
 } Track;
 
 // Function declarations
-void InitTrack(Track *track, float radius, float width, int segments, float heightVariation, float twistAmount, Texture2D trackTexture);
-void DrawTrack(Track *track);
+TrackRibbon AllocTrackRibbon(int rows);
+TrackFrame GetTrackFrame(Vector3 position, Vector3 forward, float width, float roll);
+void SetTrackRibbonRow(TrackRibbon *ribbon, int row, TrackFrame frame, float u);
+TrackRibbon GenTrackRibbon(float radius, float width, int segments, float heightVariation, float twistAmount);
+TrackRibbon GenFigure8TrackRibbon(float loopRadius, float trackWidth, int segmentsPerLoop, float heightVariation);
+void UnloadTrackRibbon(TrackRibbon *ribbon);
+int GenTrackStrips(TrackVertex *vertices, const TrackRibbon *ribbon, const int *runFirst, const int *runSegments, int runCount);
+int GetTrackStripVertexCount(const int *runSegments, int runCount);
+size_t GetTrackArenaSize(const TrackRibbon *ribbon, TrackPrimitive primitive);
+bool BuildTrack(Track *track, const TrackRibbon *ribbon, TrackPrimitive primitive);
+int CullTrackChunks(Track *track, const Frustum *frustum, Vector3 viewPosition);
+void QueueTrack(RenderQueue *queue, Track *track, const Frustum *frustum, Vector3 viewPosition);
 void UnloadTrack(Track *track);
 
-// New function for a figure 8 track
-void InitFigure8Track(Track *track, float loopRadius, float trackWidth, int segmentsPerLoop, float heightVariation, Texture2D trackTexture);
+// Track through control points, tessellated by curvature (see spline.h)
+bool GenSplineTrack(Track *track, const TrackControlPoint *points, int pointCount, TrackSplineSettings settings);
+void LoadTrackMaterial(Track *track, Texture2D trackTexture);
 
 // Function to get track surface info
-Vector3 GetTrackSurfaceInfo(Vector3 shipPos, Mesh trackMesh, float *outHeight);
+Vector3 GetTrackSurfaceInfo(Vector3 shipPos, const TrackRibbon *ribbon, float *outHeight);
 
-#endif // TRACK_H
\ No newline at end of file
+#endif // TRACK_H
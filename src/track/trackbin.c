@@ -0,0 +1,117 @@
+#include "trackbin.h"
+#include <raylib.h>
+#include <stdio.h>
+#include <string.h>
+
+// Pointer to an array of 'count' elements of 'size' bytes in the image, or NULL if it doesn't
+// fit or isn't aligned as the arena left it
+static void *GetImageArray(unsigned char *image, uint32_t dataSize, TrackBinArray array, size_t size)
+{
+    if ((array.offset % ARENA_ALIGNMENT) != 0) return NULL;
+    if ((uint64_t)array.offset + (uint64_t)array.count * size > dataSize) return NULL;
+    return image + array.offset;
+}
+
+// Point 'track' at the arrays of the image its arena holds, after the header checks. Chunk
+// ranges and the grid are checked too, so a bad file can't send a draw or a query outside it.
+static bool MapTrackImage(Track *track, const TrackBinHeader *header, unsigned char *image)
+{
+    uint32_t dataSize = header->dataSize;
+    TrackSurface *surface = &track->surface;
+
+    track->primitive = (TrackPrimitive)header->primitive;
+    track->chunks = (TrackChunk *)GetImageArray(image, dataSize, header->chunks, sizeof(TrackChunk));
+    track->visibleChunks = (int *)GetImageArray(image, dataSize, header->visibleChunks, sizeof(int));
+    track->vertices = (TrackVertex *)GetImageArray(image, dataSize, header->vertices, sizeof(TrackVertex));
+    track->indices = (unsigned short *)GetImageArray(image, dataSize, header->indices, sizeof(unsigned short));
+    track->waypoints = (Vector3 *)GetImageArray(image, dataSize, header->waypoints, sizeof(Vector3));
+    track->frames = (TrackFrame *)GetImageArray(image, dataSize, header->frames, sizeof(TrackFrame));
+    surface->segments = (TrackSurfaceSegment *)GetImageArray(image, dataSize, header->segments, sizeof(TrackSurfaceSegment));
+    surface->cellStart = (int *)GetImageArray(image, dataSize, header->cellStart, sizeof(int));
+    surface->cellSegments = (int *)GetImageArray(image, dataSize, header->cellSegments, sizeof(int));
+
+    track->chunkCount = header->chunks.count;
+    track->vertexCount = header->vertices.count;
+    track->indexCount = header->indices.count;
+    track->waypointCount = header->waypoints.count;
+    track->visibleCount = 0;
+    surface->segmentCount = header->segments.count;
+    surface->gridOrigin = (Vector2){ header->gridOrigin[0], header->gridOrigin[1] };
+    surface->cellSize = header->cellSize;
+    surface->gridWidth = header->gridWidth;
+    surface->gridHeight = header->gridHeight;
+
+    if ((track->chunks == NULL) || (track->visibleChunks == NULL) || (track->vertices == NULL) || (track->indices == NULL) ||
+        (track->waypoints == NULL) || (track->frames == NULL) || (surface->segments == NULL) || (surface->cellStart == NULL) ||
+        (surface->cellSegments == NULL)) return false;
+
+    if ((header->primitive > TRACK_STRIPS) || (header->waypoints.count < 3) || (header->visibleChunks.count != header->chunks.count) ||
+        (header->frames.count != header->waypoints.count) || (header->segments.count != header->waypoints.count)) return false;
+
+    for (int c = 0; c < track->chunkCount; c++)
+    {
+        const TrackChunk *chunk = &track->chunks[c];
+        if ((chunk->firstVertex < 0) || (chunk->vertexCount < 0) || (chunk->firstVertex + chunk->vertexCount > track->vertexCount)) return false;
+        if ((chunk->firstIndex < 0) || (chunk->indexCount < 0) || (chunk->firstIndex + chunk->indexCount > track->indexCount)) return false;
+    }
+
+    uint64_t cellCount = (uint64_t)header->gridWidth * header->gridHeight;
+    if ((header->cellStart.count != cellCount + 1) || (surface->cellStart[0] != 0) ||
+        (surface->cellStart[cellCount] != (int)header->cellSegments.count)) return false;
+    for (uint64_t i = 0; i < cellCount; i++)
+    {
+        if (surface->cellStart[i] > surface->cellStart[i + 1]) return false;
+    }
+    for (uint32_t i = 0; i < header->cellSegments.count; i++)
+    {
+        if ((surface->cellSegments[i] < 0) || (surface->cellSegments[i] >= surface->segmentCount)) return false;
+    }
+
+    return true;
+}
+
+// Load a baked .hsk track: one allocation for its arena, one read of the whole file into it,
+// then the Track is pointed at the arrays in place. Nothing is generated. CPU only like
+// GenSplineTrack(), so it can run off the render thread; LoadTrackMaterial() finishes it.
+bool LoadTrackBinary(const char *fileName, Track *track)
+{
+    *track = (Track){ 0 };
+
+    FILE *file = fopen(fileName, "rb");
+    if (file == NULL)
+    {
+        TraceLog(LOG_WARNING, "TRACKBIN: [%s] Failed to open file", fileName);
+        return false;
+    }
+
+    fseek(file, 0, SEEK_END);
+    long fileSize = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    bool loaded = (fileSize >= TRACKBIN_HEADER_SIZE) && InitArena(&track->arena, GetArenaAllocSize((size_t)fileSize));
+    unsigned char *data = loaded? (unsigned char *)ArenaAlloc(&track->arena, (size_t)fileSize) : NULL;
+    loaded = (data != NULL) && (fread(data, 1, (size_t)fileSize, file) == (size_t)fileSize);
+    fclose(file);
+
+    TrackBinHeader header = { 0 };
+    if (loaded) memcpy(&header, data, sizeof(header));
+
+    if (!loaded || (header.magic != TRACKBIN_MAGIC) || (header.version != TRACKBIN_VERSION))
+    {
+        TraceLog(LOG_WARNING, "TRACKBIN: [%s] Unrecognized file (magic 0x%08x, version %u)", fileName, header.magic, header.version);
+        UnloadArena(&track->arena);
+        return false;
+    }
+
+    if ((header.dataSize != (uint32_t)(fileSize - TRACKBIN_HEADER_SIZE)) || !MapTrackImage(track, &header, data + TRACKBIN_HEADER_SIZE))
+    {
+        TraceLog(LOG_WARNING, "TRACKBIN: [%s] Truncated or inconsistent file", fileName);
+        UnloadArena(&track->arena);
+        *track = (Track){ 0 };
+        return false;
+    }
+
+    TraceLog(LOG_INFO, "TRACKBIN: [%s] Loaded %i segments in %i chunks (%i bytes)", fileName, track->waypointCount, track->chunkCount, (int)fileSize);
+
+    return true;
+}
@@ -0,0 +1,11 @@
+#ifndef TRACKBIN_H
+#define TRACKBIN_H
+
+#include <stdbool.h>
+#include "track.h"
+#include "trackbin_format.h"
+
+// Function declarations
+bool LoadTrackBinary(const char *fileName, Track *track);
+
+#endif // TRACKBIN_H
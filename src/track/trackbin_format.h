@@ -0,0 +1,50 @@
+#ifndef TRACKBIN_FORMAT_H
+#define TRACKBIN_FORMAT_H
+
+// Binary track file (.hsk) written by tools/trackbake and read by LoadTrackBinary().
+// Little-endian, as both the host tools and the SH4 are. Layout:
+//
+//   TrackBinHeader, padded to TRACKBIN_HEADER_SIZE bytes
+//   the built track's arena image, dataSize bytes
+//
+// The image is the arena BuildTrack() filled, byte for byte: the chunks, the vertices and
+// indices, waypoints and frames, and the surface index's segments and grid. Those arrays hold
+// no pointers, only counts, floats and indices into each other, so the image means the same on
+// any 32-bit-int little-endian machine. The header gives each array's offset into the image;
+// the loader reads the file into a track arena in one go and points the Track at them.
+
+#include <stdint.h>
+
+#define TRACKBIN_MAGIC 0x4b475348u  // "HSGK"
+#define TRACKBIN_VERSION 1
+#define TRACKBIN_HEADER_SIZE 128    // The image starts here, a multiple of ARENA_ALIGNMENT
+
+// An array in the image
+typedef struct TrackBinArray {
+    uint32_t offset;                // From the start of the image, ARENA_ALIGNMENT aligned
+    uint32_t count;                 // Elements
+} TrackBinArray;
+
+typedef struct TrackBinHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t dataSize;              // Bytes of image after the header
+    uint32_t primitive;             // TrackPrimitive the chunks were built as
+
+    TrackBinArray chunks;           // TrackChunk
+    TrackBinArray visibleChunks;    // int, scratch for CullTrackChunks()
+    TrackBinArray vertices;         // TrackVertex
+    TrackBinArray indices;          // unsigned short, empty for strips
+    TrackBinArray waypoints;        // Vector3
+    TrackBinArray frames;           // TrackFrame, one per waypoint
+    TrackBinArray segments;         // TrackSurfaceSegment
+    TrackBinArray cellStart;        // int, gridWidth * gridHeight + 1
+    TrackBinArray cellSegments;     // int, cellStart[gridWidth * gridHeight] entries
+
+    float gridOrigin[2];            // Surface grid, see TrackSurface
+    float cellSize;
+    uint32_t gridWidth;
+    uint32_t gridHeight;
+} TrackBinHeader;
+
+#endif // TRACKBIN_FORMAT_H
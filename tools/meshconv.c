@@ -0,0 +1,72 @@
+// Converts an OBJ (and its .mtl) into the binary .hsm format loaded by LoadModelBinary(), with
+// coarser levels of detail for LoadModelLodsData() simplified down to each triangle ratio given
+// (0.4 and 0.15 of the original by default; a single 1 writes the OBJ alone).
+//
+// Usage: meshconv input.obj output.hsm [ratio...]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "objconv.h"
+#include "simplify.h"
+#include "../src/mesh/meshbin_format.h"
+
+int main(int argc, char **argv)
+{
+    float ratios[MESHBIN_MAX_LODS] = { 1.0f, 0.4f, 0.15f };
+    int levelCount = 3;
+
+    if ((argc < 3) || (argc > 2 + MESHBIN_MAX_LODS))
+    {
+        fprintf(stderr, "usage: %s input.obj output.hsm [ratio...]\n", argv[0]);
+        return 1;
+    }
+
+    if (argc > 3)
+    {
+        levelCount = 1;
+        for (int i = 3; i < argc; i++)
+        {
+            float ratio = strtof(argv[i], NULL);
+            if ((ratio <= 0.0f) || (ratio > 1.0f))
+            {
+                fprintf(stderr, "meshconv: triangle ratio %s is not in (0, 1]\n", argv[i]);
+                return 1;
+            }
+            if (ratio < 1.0f) ratios[levelCount++] = ratio;
+        }
+    }
+
+    ObjData levels[MESHBIN_MAX_LODS];
+    float errors[MESHBIN_MAX_LODS] = { 0.0f };
+    if (!ParseObj(argv[1], &levels[0]))
+    {
+        fprintf(stderr, "meshconv: no triangles in %s\n", argv[1]);
+        return 1;
+    }
+
+    for (int i = 1; i < levelCount; i++)
+    {
+        SimplifyObj(&levels[0], (int)(levels[0].triangleCount * ratios[i]), &levels[i]);
+        errors[i] = GetSimplifyError(&levels[0], &levels[i]);
+    }
+
+    unsigned char *data = NULL;
+    int size = 0;
+    bool ok = BuildMeshBinLods(levels, errors, levelCount, &data, &size);
+
+    FILE *file = fopen(argv[2], "wb");
+    if ((file == NULL) || (fwrite(data, 1, size, file) != (size_t)size))
+    {
+        fprintf(stderr, "meshconv: can't write %s\n", argv[2]);
+        ok = false;
+    }
+    if (file != NULL) fclose(file);
+
+    printf("meshconv: %s -> %s: %d triangles, %d materials, %d bytes\n", argv[1], argv[2], levels[0].triangleCount, levels[0].materialCount, size);
+    for (int i = 1; i < levelCount; i++) printf("meshconv:   LOD %d: %d triangles, error %.4f\n", i, levels[i].triangleCount, errors[i]);
+
+    free(data);
+    for (int i = 0; i < levelCount; i++) UnloadObj(&levels[i]);
+
+    return ok? 0 : 1;
+}
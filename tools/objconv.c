@@ -0,0 +1,580 @@
+#include "objconv.h"
+#include "../src/mesh/meshbin_format.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define OBJ_MAX_POLYGON 64
+
+// Growable array helper: makes room for element 'count' of 'size' bytes
+static void *Grow(void *array, int count, int *capacity, size_t size)
+{
+    if (count < *capacity) return array;
+    *capacity = (*capacity > 0)? *capacity * 2 : 256;
+    return realloc(array, (size_t)*capacity * size);
+}
+
+static char *ReadText(const char *fileName)
+{
+    FILE *file = fopen(fileName, "rb");
+    if (file == NULL) return NULL;
+
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    char *text = (char *)malloc(size + 1);
+    size_t read = fread(text, 1, size, file);
+    text[read] = '\0';
+    fclose(file);
+
+    return text;
+}
+
+static int FindMaterial(const ObjData *obj, const char *name)
+{
+    for (int i = 0; i < obj->materialCount; i++)
+    {
+        if (strcmp(obj->materials[i].name, name) == 0) return i;
+    }
+    return -1;
+}
+
+static int AddMaterial(ObjData *obj, int *capacity, const char *name)
+{
+    obj->materials = (ObjMaterial *)Grow(obj->materials, obj->materialCount, capacity, sizeof(ObjMaterial));
+    ObjMaterial *material = &obj->materials[obj->materialCount];
+    memset(material, 0, sizeof(*material));
+    snprintf(material->name, sizeof(material->name), "%s", name);
+    material->diffuse[0] = material->diffuse[1] = material->diffuse[2] = material->diffuse[3] = 1.0f;
+    return obj->materialCount++;
+}
+
+static void ParseMtl(ObjData *obj, int *capacity, const char *fileName)
+{
+    char *text = ReadText(fileName);
+    if (text == NULL)
+    {
+        fprintf(stderr, "objconv: can't open material library %s\n", fileName);
+        return;
+    }
+
+    int current = -1;
+    for (char *line = strtok(text, "\r\n"); line != NULL; line = strtok(NULL, "\r\n"))
+    {
+        char name[64];
+        float r, g, b, d;
+
+        while ((*line == ' ') || (*line == '\t')) line++;
+
+        if (sscanf(line, "newmtl %63s", name) == 1) current = AddMaterial(obj, capacity, name);
+        else if ((current >= 0) && (sscanf(line, "Kd %f %f %f", &r, &g, &b) == 3))
+        {
+            obj->materials[current].diffuse[0] = r;
+            obj->materials[current].diffuse[1] = g;
+            obj->materials[current].diffuse[2] = b;
+        }
+        else if ((current >= 0) && (sscanf(line, "d %f", &d) == 1)) obj->materials[current].diffuse[3] = d;
+    }
+
+    free(text);
+}
+
+// OBJ indices are 1-based, negative values count back from the latest element
+static int ResolveIndex(int index, int count)
+{
+    if (index > 0) return index - 1;
+    if (index < 0) return count + index;
+    return -1;
+}
+
+static bool ParseCorner(const char *token, const ObjData *obj, ObjCorner *corner)
+{
+    int p = 0, t = 0, n = 0;
+
+    if (sscanf(token, "%d/%d/%d", &p, &t, &n) == 3) { }
+    else if (sscanf(token, "%d//%d", &p, &n) == 2) t = 0;
+    else if (sscanf(token, "%d/%d", &p, &t) == 2) n = 0;
+    else if (sscanf(token, "%d", &p) != 1) return false;
+
+    corner->position = ResolveIndex(p, obj->positionCount);
+    corner->texcoord = ResolveIndex(t, obj->texcoordCount);
+    corner->normal = ResolveIndex(n, obj->normalCount);
+
+    return (corner->position >= 0) && (corner->position < obj->positionCount);
+}
+
+bool ParseObj(const char *fileName, ObjData *obj)
+{
+    memset(obj, 0, sizeof(*obj));
+
+    char *text = ReadText(fileName);
+    if (text == NULL)
+    {
+        fprintf(stderr, "objconv: can't open %s\n", fileName);
+        return false;
+    }
+
+    int positionCapacity = 0, texcoordCapacity = 0, normalCapacity = 0, triangleCapacity = 0, materialCapacity = 0;
+    int material = 0;
+
+    char *saveLine = NULL;
+    for (char *line = strtok_r(text, "\r\n", &saveLine); line != NULL; line = strtok_r(NULL, "\r\n", &saveLine))
+    {
+        while ((*line == ' ') || (*line == '\t')) line++;
+
+        if ((line[0] == 'v') && (line[1] == ' '))
+        {
+            obj->positions = (float *)Grow(obj->positions, obj->positionCount, &positionCapacity, 3 * sizeof(float));
+            float *p = &obj->positions[obj->positionCount * 3];
+            if (sscanf(line + 2, "%f %f %f", &p[0], &p[1], &p[2]) == 3) obj->positionCount++;
+        }
+        else if ((line[0] == 'v') && (line[1] == 't'))
+        {
+            obj->texcoords = (float *)Grow(obj->texcoords, obj->texcoordCount, &texcoordCapacity, 2 * sizeof(float));
+            float *t = &obj->texcoords[obj->texcoordCount * 2];
+            if (sscanf(line + 3, "%f %f", &t[0], &t[1]) == 2) obj->texcoordCount++;
+        }
+        else if ((line[0] == 'v') && (line[1] == 'n'))
+        {
+            obj->normals = (float *)Grow(obj->normals, obj->normalCount, &normalCapacity, 3 * sizeof(float));
+            float *n = &obj->normals[obj->normalCount * 3];
+            if (sscanf(line + 3, "%f %f %f", &n[0], &n[1], &n[2]) == 3) obj->normalCount++;
+        }
+        else if ((line[0] == 'f') && (line[1] == ' '))
+        {
+            ObjCorner polygon[OBJ_MAX_POLYGON];
+            int corners = 0;
+            char *saveToken = NULL;
+
+            for (char *token = strtok_r(line + 2, " \t", &saveToken); (token != NULL) && (corners < OBJ_MAX_POLYGON);
+                 token = strtok_r(NULL, " \t", &saveToken))
+            {
+                if (ParseCorner(token, obj, &polygon[corners])) corners++;
+            }
+
+            // Fan triangulation, matching raylib's loader for convex faces
+            for (int k = 1; k + 1 < corners; k++)
+            {
+                obj->triangles = (ObjTriangle *)Grow(obj->triangles, obj->triangleCount, &triangleCapacity, sizeof(ObjTriangle));
+                ObjTriangle *tri = &obj->triangles[obj->triangleCount++];
+                tri->corners[0] = polygon[0];
+                tri->corners[1] = polygon[k];
+                tri->corners[2] = polygon[k + 1];
+                tri->material = material;
+            }
+        }
+        else if (strncmp(line, "usemtl ", 7) == 0)
+        {
+            char name[64] = { 0 };
+            sscanf(line + 7, "%63s", name);
+            material = FindMaterial(obj, name);
+            if (material < 0) material = AddMaterial(obj, &materialCapacity, name);
+        }
+        else if (strncmp(line, "mtllib ", 7) == 0)
+        {
+            // Relative to the OBJ's directory
+            char path[512];
+            const char *slash = strrchr(fileName, '/');
+            int dirLength = (slash != NULL)? (int)(slash - fileName) + 1 : 0;
+            char name[256] = { 0 };
+            sscanf(line + 7, "%255s", name);
+            snprintf(path, sizeof(path), "%.*s%s", dirLength, fileName, name);
+            ParseMtl(obj, &materialCapacity, path);
+        }
+    }
+
+    free(text);
+
+    if (obj->materialCount == 0) AddMaterial(obj, &materialCapacity, "default");
+
+    return obj->triangleCount > 0;
+}
+
+void UnloadObj(ObjData *obj)
+{
+    free(obj->positions);
+    free(obj->texcoords);
+    free(obj->normals);
+    free(obj->triangles);
+    free(obj->materials);
+    memset(obj, 0, sizeof(*obj));
+}
+
+// Vertex deduplication: open-addressed table keyed on the (position, texcoord, normal) triple
+typedef struct CornerSlot {
+    ObjCorner key;
+    int vertex;                 // -1 when empty
+} CornerSlot;
+
+static unsigned int HashCorner(ObjCorner c)
+{
+    unsigned int h = (unsigned int)c.position * 73856093u;
+    h ^= (unsigned int)c.texcoord * 19349663u;
+    h ^= (unsigned int)c.normal * 83492791u;
+    return h;
+}
+
+typedef struct BuiltMesh {
+    int material;
+    int vertexCount;
+    int triangleCount;
+    float *vertexData;          // Planar: positions, texcoords, normals
+    unsigned short *indices;
+} BuiltMesh;
+
+static void FaceNormal(const ObjData *obj, const ObjTriangle *tri, float *out)
+{
+    const float *a = &obj->positions[tri->corners[0].position * 3];
+    const float *b = &obj->positions[tri->corners[1].position * 3];
+    const float *c = &obj->positions[tri->corners[2].position * 3];
+    float e1[3] = { b[0] - a[0], b[1] - a[1], b[2] - a[2] };
+    float e2[3] = { c[0] - a[0], c[1] - a[1], c[2] - a[2] };
+    float n[3] = { e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0] };
+    float length = sqrtf(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+    if (length > 0.0f) { n[0] /= length; n[1] /= length; n[2] /= length; }
+    memcpy(out, n, sizeof(n));
+}
+
+static bool BuildMaterialMesh(const ObjData *obj, int material, BuiltMesh *mesh)
+{
+    memset(mesh, 0, sizeof(*mesh));
+    mesh->material = material;
+
+    for (int i = 0; i < obj->triangleCount; i++)
+    {
+        if (obj->triangles[i].material == material) mesh->triangleCount++;
+    }
+    if (mesh->triangleCount == 0) return true;
+
+    int maxVertices = mesh->triangleCount * 3;
+    int tableSize = 1;
+    while (tableSize < maxVertices * 2) tableSize <<= 1;
+
+    CornerSlot *table = (CornerSlot *)malloc(tableSize * sizeof(CornerSlot));
+    for (int i = 0; i < tableSize; i++) table[i].vertex = -1;
+
+    float *positions = (float *)malloc(maxVertices * 3 * sizeof(float));
+    float *texcoords = (float *)malloc(maxVertices * 2 * sizeof(float));
+    float *normals = (float *)malloc(maxVertices * 3 * sizeof(float));
+    mesh->indices = (unsigned short *)malloc(maxVertices * sizeof(unsigned short));
+
+    int index = 0;
+    bool fits = true;
+    for (int i = 0; i < obj->triangleCount; i++)
+    {
+        const ObjTriangle *tri = &obj->triangles[i];
+        if (tri->material != material) continue;
+
+        for (int k = 0; k < 3; k++)
+        {
+            ObjCorner key = tri->corners[k];
+            if (key.normal < 0) key.normal = -2 - i; // Flat normal, unique to this face
+
+            unsigned int slot = HashCorner(key) & (tableSize - 1);
+            while ((table[slot].vertex >= 0) && ((table[slot].key.position != key.position) ||
+                   (table[slot].key.texcoord != key.texcoord) || (table[slot].key.normal != key.normal)))
+            {
+                slot = (slot + 1) & (tableSize - 1);
+            }
+
+            if (table[slot].vertex < 0)
+            {
+                int v = mesh->vertexCount++;
+                table[slot].key = key;
+                table[slot].vertex = v;
+
+                memcpy(&positions[v * 3], &obj->positions[key.position * 3], 3 * sizeof(float));
+
+                // Flip V like raylib's OBJ loader does
+                if (key.texcoord >= 0)
+                {
+                    texcoords[v * 2 + 0] = obj->texcoords[key.texcoord * 2 + 0];
+                    texcoords[v * 2 + 1] = 1.0f - obj->texcoords[key.texcoord * 2 + 1];
+                }
+                else texcoords[v * 2 + 0] = texcoords[v * 2 + 1] = 0.0f;
+
+                if (key.normal >= 0) memcpy(&normals[v * 3], &obj->normals[key.normal * 3], 3 * sizeof(float));
+                else FaceNormal(obj, tri, &normals[v * 3]);
+            }
+
+            mesh->indices[index++] = (unsigned short)table[slot].vertex;
+        }
+
+        if (mesh->vertexCount > 65535 - 3)
+        {
+            fits = false; // The next triangle could overflow unsigned short indices
+            break;
+        }
+    }
+
+    free(table);
+
+    if (!fits) fprintf(stderr, "objconv: material %s has more than 65535 vertices\n", obj->materials[material].name);
+
+    // Pack the planar blocks back to back
+    int v = mesh->vertexCount;
+    mesh->vertexData = (float *)malloc(v * MESHBIN_VERTEX_FLOATS * sizeof(float));
+    memcpy(mesh->vertexData, positions, v * 3 * sizeof(float));
+    memcpy(mesh->vertexData + v * 3, texcoords, v * 2 * sizeof(float));
+    memcpy(mesh->vertexData + v * 5, normals, v * 3 * sizeof(float));
+
+    free(positions);
+    free(texcoords);
+    free(normals);
+
+    return fits;
+}
+
+// Silhouette data for the outline section: positions welded by value across materials and
+// seams, a plane per triangle, and every edge with the faces either side of it
+typedef struct BuiltOutline {
+    float *positions;           // 3 per position
+    int positionCount;
+    float *planes;              // Normal and distance, 4 per face
+    int faceCount;
+    MeshBinEdge *edges;
+    int edgeCount;
+} BuiltOutline;
+
+static unsigned int HashPosition(const float *p)
+{
+    uint32_t bits[3];
+    float key[3] = { p[0] + 0.0f, p[1] + 0.0f, p[2] + 0.0f }; // -0 welds with +0
+    memcpy(bits, key, sizeof(bits));
+    return (bits[0] * 73856093u) ^ (bits[1] * 19349663u) ^ (bits[2] * 83492791u);
+}
+
+static int TableSize(int count)
+{
+    int size = 1;
+    while (size < count * 2) size <<= 1;
+    return size;
+}
+
+// Adds face 'face' to edge a-b: the first edge on those positions with a free side, or a new one
+static void AddOutlineEdge(BuiltOutline *outline, int *table, int tableSize, int a, int b, int face)
+{
+    int lo = (a < b)? a : b, hi = (a < b)? b : a;
+    unsigned int slot = ((unsigned int)lo * 73856093u ^ (unsigned int)hi * 19349663u) & (tableSize - 1);
+
+    while (table[slot] >= 0)
+    {
+        MeshBinEdge *edge = &outline->edges[table[slot]];
+        if ((edge->a == lo) && (edge->b == hi) && (edge->faceB == MESHBIN_NO_FACE))
+        {
+            edge->faceB = (uint16_t)face;
+            return;
+        }
+        slot = (slot + 1) & (tableSize - 1);
+    }
+
+    table[slot] = outline->edgeCount;
+    outline->edges[outline->edgeCount++] = (MeshBinEdge){ (uint16_t)lo, (uint16_t)hi, (uint16_t)face, MESHBIN_NO_FACE };
+}
+
+// False (and no section) if the welded model needs more than 16-bit indices
+static bool BuildOutline(const ObjData *obj, BuiltOutline *outline)
+{
+    memset(outline, 0, sizeof(*outline));
+
+    int *weld = (int *)malloc(obj->positionCount * sizeof(int));
+    int positionTableSize = TableSize(obj->positionCount);
+    int *positionTable = (int *)malloc(positionTableSize * sizeof(int));
+    for (int i = 0; i < positionTableSize; i++) positionTable[i] = -1;
+    outline->positions = (float *)malloc(obj->positionCount * 3 * sizeof(float));
+
+    for (int i = 0; i < obj->positionCount; i++)
+    {
+        const float *p = &obj->positions[i * 3];
+        unsigned int slot = HashPosition(p) & (positionTableSize - 1);
+        while ((positionTable[slot] >= 0) && (memcmp(&outline->positions[positionTable[slot] * 3], p, 3 * sizeof(float)) != 0))
+        {
+            slot = (slot + 1) & (positionTableSize - 1);
+        }
+
+        if (positionTable[slot] < 0)
+        {
+            positionTable[slot] = outline->positionCount;
+            memcpy(&outline->positions[outline->positionCount * 3], p, 3 * sizeof(float));
+            outline->positionCount++;
+        }
+        weld[i] = positionTable[slot];
+    }
+    free(positionTable);
+
+    int edgeTableSize = TableSize(obj->triangleCount * 3);
+    int *edgeTable = (int *)malloc(edgeTableSize * sizeof(int));
+    for (int i = 0; i < edgeTableSize; i++) edgeTable[i] = -1;
+    outline->planes = (float *)malloc(obj->triangleCount * 4 * sizeof(float));
+    outline->edges = (MeshBinEdge *)malloc(obj->triangleCount * 3 * sizeof(MeshBinEdge));
+
+    bool fits = (outline->positionCount <= 65535);
+    for (int i = 0; fits && (i < obj->triangleCount); i++)
+    {
+        const ObjTriangle *tri = &obj->triangles[i];
+        int v[3] = { weld[tri->corners[0].position], weld[tri->corners[1].position], weld[tri->corners[2].position] };
+        if ((v[0] == v[1]) || (v[1] == v[2]) || (v[2] == v[0])) continue;
+
+        // In doubles, so thin faces still get a plane that holds all three corners. Degenerate
+        // faces face nowhere, so they would turn every edge they share into a silhouette.
+        const float *p[3] = { &outline->positions[v[0] * 3], &outline->positions[v[1] * 3], &outline->positions[v[2] * 3] };
+        double e1[3] = { (double)p[1][0] - p[0][0], (double)p[1][1] - p[0][1], (double)p[1][2] - p[0][2] };
+        double e2[3] = { (double)p[2][0] - p[0][0], (double)p[2][1] - p[0][1], (double)p[2][2] - p[0][2] };
+        double n[3] = { e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0] };
+        double length = sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+        if (length == 0.0) continue;
+
+        if (outline->faceCount >= (int)MESHBIN_NO_FACE)
+        {
+            fits = false;
+            break;
+        }
+
+        int face = outline->faceCount++;
+        float *plane = &outline->planes[face * 4];
+        double w = 0.0;
+        for (int k = 0; k < 3; k++)
+        {
+            n[k] /= length;
+            plane[k] = (float)n[k];
+        }
+        for (int k = 0; k < 3; k++) w += (n[0] * p[k][0] + n[1] * p[k][1] + n[2] * p[k][2]) / 3.0;
+        plane[3] = (float)w;
+
+        for (int k = 0; k < 3; k++) AddOutlineEdge(outline, edgeTable, edgeTableSize, v[k], v[(k + 1) % 3], face);
+    }
+
+    free(edgeTable);
+    free(weld);
+
+    if (!fits) fprintf(stderr, "objconv: more than 65535 welded positions or faces, no outline section written\n");
+    return fits;
+}
+
+static uint32_t Align4(uint32_t offset)
+{
+    return (offset + 3u) & ~3u;
+}
+
+static uint8_t ColorByte(float value)
+{
+    if (value < 0.0f) value = 0.0f;
+    if (value > 1.0f) value = 1.0f;
+    return (uint8_t)(value * 255.0f + 0.5f);
+}
+
+// Every level of detail in turn, finest first: one mesh per used material, in material order,
+// each deduplicated into an indexed list. Then the level table, and the outline section from the
+// finest level. 'errors' gives each level's distance from the first, in model units.
+bool BuildMeshBinLods(const ObjData *levels, const float *errors, int levelCount, unsigned char **outData, int *outSize)
+{
+    if ((levelCount < 1) || (levelCount > MESHBIN_MAX_LODS)) return false;
+
+    const ObjData *obj = &levels[0];
+    int meshCapacity = 0;
+    for (int l = 0; l < levelCount; l++) meshCapacity += levels[l].materialCount;
+
+    BuiltMesh *meshes = (BuiltMesh *)calloc(meshCapacity > 0? meshCapacity : 1, sizeof(BuiltMesh));
+    MeshBinLod *lods = (MeshBinLod *)calloc(levelCount, sizeof(MeshBinLod));
+    int meshCount = 0;
+    bool ok = true;
+
+    for (int l = 0; l < levelCount; l++)
+    {
+        for (int m = 0; m < levels[l].materialCount; m++)
+        {
+            ok &= BuildMaterialMesh(&levels[l], m, &meshes[meshCount]);
+            if (meshes[meshCount].triangleCount > 0)
+            {
+                meshCount++;
+                lods[l].meshCount++;
+            }
+        }
+        lods[l].error = (errors != NULL)? errors[l] : 0.0f;
+    }
+
+    BuiltOutline outline;
+    bool hasOutline = BuildOutline(obj, &outline);
+
+    MeshBinHeader header = { MESHBIN_MAGIC, MESHBIN_VERSION, (uint32_t)obj->materialCount, (uint32_t)meshCount, (uint32_t)levelCount, 0 };
+    uint32_t offset = sizeof(header) + obj->materialCount * sizeof(MeshBinMaterial) + meshCount * sizeof(MeshBinMesh) +
+                      levelCount * sizeof(MeshBinLod);
+
+    MeshBinMesh *table = (MeshBinMesh *)calloc(meshCount > 0? meshCount : 1, sizeof(MeshBinMesh));
+    for (int i = 0; i < meshCount; i++)
+    {
+        offset = Align4(offset);
+        table[i].vertexCount = meshes[i].vertexCount;
+        table[i].triangleCount = meshes[i].triangleCount;
+        table[i].material = meshes[i].material;
+        table[i].vertexOffset = offset;
+        offset += meshes[i].vertexCount * MESHBIN_VERTEX_FLOATS * sizeof(float);
+        table[i].indexOffset = offset;
+        offset += meshes[i].triangleCount * 3 * sizeof(unsigned short);
+    }
+
+    if (hasOutline)
+    {
+        header.outlineOffset = offset = Align4(offset);
+        offset += sizeof(MeshBinOutline) + outline.positionCount * 3 * sizeof(float) + outline.faceCount * 4 * sizeof(float) +
+                  outline.edgeCount * sizeof(MeshBinEdge);
+    }
+
+    unsigned char *data = (unsigned char *)calloc(1, offset);
+    unsigned char *cursor = data;
+
+    memcpy(cursor, &header, sizeof(header));
+    cursor += sizeof(header);
+
+    for (int m = 0; m < obj->materialCount; m++)
+    {
+        MeshBinMaterial material;
+        for (int c = 0; c < 4; c++) material.diffuse[c] = ColorByte(obj->materials[m].diffuse[c]);
+        memcpy(cursor, &material, sizeof(material));
+        cursor += sizeof(material);
+    }
+
+    memcpy(cursor, table, meshCount * sizeof(MeshBinMesh));
+    cursor += meshCount * sizeof(MeshBinMesh);
+    memcpy(cursor, lods, levelCount * sizeof(MeshBinLod));
+
+    for (int i = 0; i < meshCount; i++)
+    {
+        memcpy(data + table[i].vertexOffset, meshes[i].vertexData, meshes[i].vertexCount * MESHBIN_VERTEX_FLOATS * sizeof(float));
+        memcpy(data + table[i].indexOffset, meshes[i].indices, meshes[i].triangleCount * 3 * sizeof(unsigned short));
+        free(meshes[i].vertexData);
+        free(meshes[i].indices);
+    }
+
+    if (hasOutline)
+    {
+        MeshBinOutline counts = { (uint32_t)outline.positionCount, (uint32_t)outline.faceCount, (uint32_t)outline.edgeCount };
+        cursor = data + header.outlineOffset;
+        memcpy(cursor, &counts, sizeof(counts));
+        cursor += sizeof(counts);
+        memcpy(cursor, outline.positions, outline.positionCount * 3 * sizeof(float));
+        cursor += outline.positionCount * 3 * sizeof(float);
+        memcpy(cursor, outline.planes, outline.faceCount * 4 * sizeof(float));
+        cursor += outline.faceCount * 4 * sizeof(float);
+        memcpy(cursor, outline.edges, outline.edgeCount * sizeof(MeshBinEdge));
+    }
+
+    free(outline.positions);
+    free(outline.planes);
+    free(outline.edges);
+    free(table);
+    free(lods);
+    free(meshes);
+
+    *outData = data;
+    *outSize = (int)offset;
+    return ok;
+}
+
+// A model with a single level of detail
+bool BuildMeshBin(const ObjData *obj, unsigned char **outData, int *outSize)
+{
+    return BuildMeshBinLods(obj, NULL, 1, outData, outSize);
+}
@@ -0,0 +1,46 @@
+#ifndef OBJCONV_H
+#define OBJCONV_H
+
+// Host-side OBJ/MTL reader and .hsm writer shared by tools/meshconv and the benchmarks
+
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef struct ObjMaterial {
+    char name[64];
+    float diffuse[4];           // Kd, d
+} ObjMaterial;
+
+typedef struct ObjCorner {
+    int position;               // 0-based, -1 if absent
+    int texcoord;
+    int normal;
+} ObjCorner;
+
+typedef struct ObjTriangle {
+    ObjCorner corners[3];
+    int material;
+} ObjTriangle;
+
+typedef struct ObjData {
+    float *positions;           // 3 per entry
+    float *texcoords;           // 2 per entry
+    float *normals;             // 3 per entry
+    int positionCount;
+    int texcoordCount;
+    int normalCount;
+
+    ObjTriangle *triangles;     // Polygons fan-triangulated in file order
+    int triangleCount;
+
+    ObjMaterial *materials;     // In .mtl order, like raylib's loader
+    int materialCount;
+} ObjData;
+
+// Function declarations
+bool ParseObj(const char *fileName, ObjData *obj);
+void UnloadObj(ObjData *obj);
+bool BuildMeshBin(const ObjData *obj, unsigned char **outData, int *outSize);
+bool BuildMeshBinLods(const ObjData *levels, const float *errors, int levelCount, unsigned char **outData, int *outSize);
+
+#endif // OBJCONV_H
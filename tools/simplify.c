@@ -0,0 +1,604 @@
+#include "simplify.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define SIMPLIFY_SEAM_WEIGHT 100.0      // Pull of the planes that keep boundaries, seams and material edges in place
+#define SIMPLIFY_MIN_NORMAL_DOT 0.25    // A collapse may turn no remaining face further than ~75 degrees
+
+// Symmetric 4x4 error quadric, upper triangle: aa ab ac ad bb bc bd cc cd dd
+typedef struct Quadric {
+    double q[10];
+} Quadric;
+
+typedef struct SimplifyFace {
+    int v[3];                   // Welded vertices
+    ObjCorner corners[3];       // The OBJ corners, whose texcoords and normals the face keeps
+    int material;
+    bool dead;
+} SimplifyFace;
+
+typedef struct VertexFaces {
+    int *faces;                 // Faces using the vertex, dead ones included until skipped
+    int count;
+    int capacity;
+} VertexFaces;
+
+// A candidate collapse of 'from' onto 'to', current while both vertices' stamps match
+typedef struct Collapse {
+    double cost;
+    int from;
+    int to;
+    unsigned int fromStamp;
+    unsigned int toStamp;
+} Collapse;
+
+typedef struct Simplifier {
+    double *positions;          // 3 per welded vertex
+    int *source;                // OBJ position index of each welded vertex
+    int vertexCount;
+    Quadric *quadrics;
+    unsigned int *stamps;
+    bool *removed;
+    VertexFaces *vertexFaces;
+    SimplifyFace *faces;
+    int faceCount;
+    int liveFaces;
+    int *marks;                 // Scratch per vertex for neighbourhood tests
+    int markRound;
+
+    Collapse *heap;
+    int heapCount;
+    int heapCapacity;
+} Simplifier;
+
+// Half-edge of a face, for finding the faces either side of each edge
+typedef struct FaceEdge {
+    int lo;
+    int hi;
+    int face;
+    int side;                   // Corner the edge starts at
+} FaceEdge;
+
+static void AddPlaneQuadric(Quadric *quadric, const double *n, double d, double weight)
+{
+    double a = n[0], b = n[1], c = n[2];
+    double *q = quadric->q;
+    q[0] += weight * a * a; q[1] += weight * a * b; q[2] += weight * a * c; q[3] += weight * a * d;
+    q[4] += weight * b * b; q[5] += weight * b * c; q[6] += weight * b * d;
+    q[7] += weight * c * c; q[8] += weight * c * d;
+    q[9] += weight * d * d;
+}
+
+static void AddQuadric(Quadric *to, const Quadric *from)
+{
+    for (int i = 0; i < 10; i++) to->q[i] += from->q[i];
+}
+
+static double GetQuadricError(const Quadric *a, const Quadric *b, const double *p)
+{
+    double q[10];
+    for (int i = 0; i < 10; i++) q[i] = a->q[i] + b->q[i];
+
+    double x = p[0], y = p[1], z = p[2];
+    double error = q[0] * x * x + 2.0 * q[1] * x * y + 2.0 * q[2] * x * z + 2.0 * q[3] * x +
+                   q[4] * y * y + 2.0 * q[5] * y * z + 2.0 * q[6] * y +
+                   q[7] * z * z + 2.0 * q[8] * z + q[9];
+    return (error > 0.0)? error : 0.0;
+}
+
+static void Subtract(const double *a, const double *b, double *out)
+{
+    out[0] = a[0] - b[0]; out[1] = a[1] - b[1]; out[2] = a[2] - b[2];
+}
+
+static void Cross(const double *a, const double *b, double *out)
+{
+    out[0] = a[1] * b[2] - a[2] * b[1];
+    out[1] = a[2] * b[0] - a[0] * b[2];
+    out[2] = a[0] * b[1] - a[1] * b[0];
+}
+
+static double Dot(const double *a, const double *b)
+{
+    return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+// Unnormalized normal of triangle a, b, c, twice its area long
+static void TriangleNormal(const double *a, const double *b, const double *c, double *out)
+{
+    double e1[3], e2[3];
+    Subtract(b, a, e1);
+    Subtract(c, a, e2);
+    Cross(e1, e2, out);
+}
+
+static void AddVertexFace(VertexFaces *list, int face)
+{
+    if (list->count == list->capacity)
+    {
+        list->capacity = (list->capacity > 0)? list->capacity * 2 : 8;
+        list->faces = (int *)realloc(list->faces, list->capacity * sizeof(int));
+    }
+    list->faces[list->count++] = face;
+}
+
+//----------------------------------------------------------------------------------
+// Candidate heap, cheapest first
+//----------------------------------------------------------------------------------
+
+static void PushCollapse(Simplifier *s, Collapse collapse)
+{
+    if (s->heapCount == s->heapCapacity)
+    {
+        s->heapCapacity = (s->heapCapacity > 0)? s->heapCapacity * 2 : 1024;
+        s->heap = (Collapse *)realloc(s->heap, s->heapCapacity * sizeof(Collapse));
+    }
+
+    int i = s->heapCount++;
+    while (i > 0)
+    {
+        int parent = (i - 1) / 2;
+        if (s->heap[parent].cost <= collapse.cost) break;
+        s->heap[i] = s->heap[parent];
+        i = parent;
+    }
+    s->heap[i] = collapse;
+}
+
+static Collapse PopCollapse(Simplifier *s)
+{
+    Collapse top = s->heap[0];
+    Collapse last = s->heap[--s->heapCount];
+
+    int i = 0;
+    for (;;)
+    {
+        int child = i * 2 + 1;
+        if (child >= s->heapCount) break;
+        if ((child + 1 < s->heapCount) && (s->heap[child + 1].cost < s->heap[child].cost)) child++;
+        if (s->heap[child].cost >= last.cost) break;
+        s->heap[i] = s->heap[child];
+        i = child;
+    }
+    if (s->heapCount > 0) s->heap[i] = last;
+
+    return top;
+}
+
+// Queue the cheaper direction of collapsing edge a-b. Both keep an existing vertex, so the
+// simplified model only ever uses the OBJ's own positions.
+static void PushEdge(Simplifier *s, int a, int b)
+{
+    const double *pa = &s->positions[a * 3], *pb = &s->positions[b * 3];
+    double toB = GetQuadricError(&s->quadrics[a], &s->quadrics[b], pb);
+    double toA = GetQuadricError(&s->quadrics[a], &s->quadrics[b], pa);
+
+    if (toB <= toA) PushCollapse(s, (Collapse){ toB, a, b, s->stamps[a], s->stamps[b] });
+    else PushCollapse(s, (Collapse){ toA, b, a, s->stamps[b], s->stamps[a] });
+}
+
+//----------------------------------------------------------------------------------
+// Setup
+//----------------------------------------------------------------------------------
+
+static int CompareFaceEdges(const void *a, const void *b)
+{
+    const FaceEdge *ea = (const FaceEdge *)a, *eb = (const FaceEdge *)b;
+    if (ea->lo != eb->lo) return (ea->lo < eb->lo)? -1 : 1;
+    if (ea->hi != eb->hi) return (ea->hi < eb->hi)? -1 : 1;
+    return (ea->face < eb->face)? -1 : (ea->face > eb->face);
+}
+
+// OBJ corner of 'face' sitting on welded vertex 'v'
+static ObjCorner GetFaceCorner(const SimplifyFace *face, int v)
+{
+    for (int k = 0; k < 3; k++)
+    {
+        if (face->v[k] == v) return face->corners[k];
+    }
+    return face->corners[0];
+}
+
+// Edges shared by faces that disagree on material or texcoords, and edges with one face, are
+// held in place by a plane through the edge, square to its face
+static bool IsSeam(const SimplifyFace *a, const SimplifyFace *b, int lo, int hi)
+{
+    if (a->material != b->material) return true;
+    return (GetFaceCorner(a, lo).texcoord != GetFaceCorner(b, lo).texcoord) || (GetFaceCorner(a, hi).texcoord != GetFaceCorner(b, hi).texcoord);
+}
+
+static void AddSeamQuadric(Simplifier *s, const FaceEdge *edge)
+{
+    const SimplifyFace *face = &s->faces[edge->face];
+    const double *a = &s->positions[face->v[edge->side] * 3];
+    const double *b = &s->positions[face->v[(edge->side + 1) % 3] * 3];
+    const double *c = &s->positions[face->v[(edge->side + 2) % 3] * 3];
+
+    double normal[3], along[3], n[3];
+    TriangleNormal(a, b, c, normal);
+    Subtract(b, a, along);
+    Cross(along, normal, n);
+
+    double length = sqrt(Dot(n, n));
+    if (length == 0.0) return;
+    for (int k = 0; k < 3; k++) n[k] /= length;
+
+    double weight = SIMPLIFY_SEAM_WEIGHT * Dot(along, along);
+    AddPlaneQuadric(&s->quadrics[edge->lo], n, -Dot(n, a), weight);
+    AddPlaneQuadric(&s->quadrics[edge->hi], n, -Dot(n, a), weight);
+}
+
+// Weld the OBJ's positions by value, keep the non-degenerate faces and give every vertex the
+// area-weighted planes of its faces
+static void InitSimplifier(Simplifier *s, const ObjData *obj)
+{
+    memset(s, 0, sizeof(*s));
+
+    int *weld = (int *)malloc(obj->positionCount * sizeof(int));
+    s->positions = (double *)malloc(obj->positionCount * 3 * sizeof(double));
+    s->source = (int *)malloc(obj->positionCount * sizeof(int));
+
+    // Sort-free welding: a hash of the exact bits, -0 folded into +0
+    int tableSize = 1;
+    while (tableSize < obj->positionCount * 2) tableSize <<= 1;
+    int *table = (int *)malloc(tableSize * sizeof(int));
+    for (int i = 0; i < tableSize; i++) table[i] = -1;
+
+    for (int i = 0; i < obj->positionCount; i++)
+    {
+        float key[3] = { obj->positions[i * 3] + 0.0f, obj->positions[i * 3 + 1] + 0.0f, obj->positions[i * 3 + 2] + 0.0f };
+        uint32_t bits[3];
+        memcpy(bits, key, sizeof(bits));
+        unsigned int slot = ((bits[0] * 73856093u) ^ (bits[1] * 19349663u) ^ (bits[2] * 83492791u)) & (tableSize - 1);
+
+        while (table[slot] >= 0)
+        {
+            const double *p = &s->positions[table[slot] * 3];
+            if ((p[0] == key[0]) && (p[1] == key[1]) && (p[2] == key[2])) break;
+            slot = (slot + 1) & (tableSize - 1);
+        }
+
+        if (table[slot] < 0)
+        {
+            table[slot] = s->vertexCount;
+            for (int k = 0; k < 3; k++) s->positions[s->vertexCount * 3 + k] = key[k];
+            s->source[s->vertexCount++] = i;
+        }
+        weld[i] = table[slot];
+    }
+    free(table);
+
+    s->quadrics = (Quadric *)calloc(s->vertexCount, sizeof(Quadric));
+    s->stamps = (unsigned int *)calloc(s->vertexCount, sizeof(unsigned int));
+    s->removed = (bool *)calloc(s->vertexCount, sizeof(bool));
+    s->vertexFaces = (VertexFaces *)calloc(s->vertexCount, sizeof(VertexFaces));
+    s->marks = (int *)calloc(s->vertexCount, sizeof(int));
+    s->faces = (SimplifyFace *)malloc(obj->triangleCount * sizeof(SimplifyFace));
+
+    for (int i = 0; i < obj->triangleCount; i++)
+    {
+        const ObjTriangle *tri = &obj->triangles[i];
+        SimplifyFace face = { { weld[tri->corners[0].position], weld[tri->corners[1].position], weld[tri->corners[2].position] },
+                              { tri->corners[0], tri->corners[1], tri->corners[2] }, tri->material, false };
+        if ((face.v[0] == face.v[1]) || (face.v[1] == face.v[2]) || (face.v[2] == face.v[0])) continue;
+
+        double n[3];
+        TriangleNormal(&s->positions[face.v[0] * 3], &s->positions[face.v[1] * 3], &s->positions[face.v[2] * 3], n);
+        double length = sqrt(Dot(n, n));
+        if (length == 0.0) continue;
+
+        double area = length * 0.5;
+        for (int k = 0; k < 3; k++) n[k] /= length;
+        double d = -Dot(n, &s->positions[face.v[0] * 3]);
+
+        int f = s->faceCount++;
+        s->faces[f] = face;
+        for (int k = 0; k < 3; k++)
+        {
+            AddPlaneQuadric(&s->quadrics[face.v[k]], n, d, area);
+            AddVertexFace(&s->vertexFaces[face.v[k]], f);
+        }
+    }
+    s->liveFaces = s->faceCount;
+    free(weld);
+
+    // Group the half-edges by edge to find boundaries and seams
+    FaceEdge *edges = (FaceEdge *)malloc(s->faceCount * 3 * sizeof(FaceEdge));
+    for (int f = 0; f < s->faceCount; f++)
+    {
+        for (int k = 0; k < 3; k++)
+        {
+            int a = s->faces[f].v[k], b = s->faces[f].v[(k + 1) % 3];
+            edges[f * 3 + k] = (FaceEdge){ (a < b)? a : b, (a < b)? b : a, f, k };
+        }
+    }
+    qsort(edges, s->faceCount * 3, sizeof(FaceEdge), CompareFaceEdges);
+
+    for (int i = 0; i < s->faceCount * 3; )
+    {
+        int end = i + 1;
+        while ((end < s->faceCount * 3) && (edges[end].lo == edges[i].lo) && (edges[end].hi == edges[i].hi)) end++;
+
+        bool seam = (end - i != 2) || IsSeam(&s->faces[edges[i].face], &s->faces[edges[i + 1].face], edges[i].lo, edges[i].hi);
+        if (seam)
+        {
+            for (int e = i; e < end; e++) AddSeamQuadric(s, &edges[e]);
+        }
+        i = end;
+    }
+
+    for (int i = 0; i < s->faceCount * 3; i++)
+    {
+        if ((i == 0) || (edges[i].lo != edges[i - 1].lo) || (edges[i].hi != edges[i - 1].hi)) PushEdge(s, edges[i].lo, edges[i].hi);
+    }
+    free(edges);
+}
+
+static void UnloadSimplifier(Simplifier *s)
+{
+    for (int i = 0; i < s->vertexCount; i++) free(s->vertexFaces[i].faces);
+    free(s->vertexFaces);
+    free(s->positions);
+    free(s->source);
+    free(s->quadrics);
+    free(s->stamps);
+    free(s->removed);
+    free(s->marks);
+    free(s->faces);
+    free(s->heap);
+}
+
+//----------------------------------------------------------------------------------
+// Collapses
+//----------------------------------------------------------------------------------
+
+static bool FaceHas(const SimplifyFace *face, int v)
+{
+    return (face->v[0] == v) || (face->v[1] == v) || (face->v[2] == v);
+}
+
+// Moving 'from' onto 'to' must keep the surface a manifold (the two share no neighbours but the
+// far corners of their shared faces) and not fold any face that survives it
+static bool CanCollapse(Simplifier *s, int from, int to)
+{
+    int round = ++s->markRound;
+    int shared = 0, common = 0;
+
+    const VertexFaces *toFaces = &s->vertexFaces[to];
+    for (int i = 0; i < toFaces->count; i++)
+    {
+        const SimplifyFace *face = &s->faces[toFaces->faces[i]];
+        if (face->dead) continue;
+        for (int k = 0; k < 3; k++) s->marks[face->v[k]] = round;
+    }
+
+    const VertexFaces *fromFaces = &s->vertexFaces[from];
+    for (int i = 0; i < fromFaces->count; i++)
+    {
+        const SimplifyFace *face = &s->faces[fromFaces->faces[i]];
+        if (face->dead) continue;
+        if (FaceHas(face, to))
+        {
+            shared++;
+            continue;
+        }
+
+        double before[3], after[3];
+        double p[3][3];
+        for (int k = 0; k < 3; k++)
+        {
+            int v = face->v[k];
+            if ((v != from) && (s->marks[v] == round))
+            {
+                s->marks[v] = round - 1; // Count each common neighbour once, unmarked as 'to''s
+                common++;
+            }
+            memcpy(p[k], &s->positions[v * 3], sizeof(p[k]));
+        }
+
+        TriangleNormal(p[0], p[1], p[2], before);
+        for (int k = 0; k < 3; k++)
+        {
+            if (face->v[k] == from) memcpy(p[k], &s->positions[to * 3], sizeof(p[k]));
+        }
+        TriangleNormal(p[0], p[1], p[2], after);
+
+        double lengths = sqrt(Dot(before, before) * Dot(after, after));
+        if ((lengths == 0.0) || (Dot(before, after) < SIMPLIFY_MIN_NORMAL_DOT * lengths)) return false;
+    }
+
+    // Each shared face's far corner is a common neighbour the collapse is allowed to keep
+    return (shared > 0) && (common <= shared);
+}
+
+static void ApplyCollapse(Simplifier *s, int from, int to)
+{
+    VertexFaces *fromFaces = &s->vertexFaces[from];
+    for (int i = 0; i < fromFaces->count; i++)
+    {
+        int f = fromFaces->faces[i];
+        SimplifyFace *face = &s->faces[f];
+        if (face->dead) continue;
+
+        if (FaceHas(face, to))
+        {
+            face->dead = true;
+            s->liveFaces--;
+            continue;
+        }
+
+        for (int k = 0; k < 3; k++)
+        {
+            if (face->v[k] == from) face->v[k] = to;
+        }
+        AddVertexFace(&s->vertexFaces[to], f);
+    }
+
+    AddQuadric(&s->quadrics[to], &s->quadrics[from]);
+    s->removed[from] = true;
+    s->stamps[to]++;
+
+    // Every edge around 'to' has a new cost
+    int round = ++s->markRound;
+    s->marks[to] = round;
+    const VertexFaces *toFaces = &s->vertexFaces[to];
+    for (int i = 0; i < toFaces->count; i++)
+    {
+        const SimplifyFace *face = &s->faces[toFaces->faces[i]];
+        if (face->dead) continue;
+        for (int k = 0; k < 3; k++)
+        {
+            int v = face->v[k];
+            if (s->marks[v] == round) continue;
+            s->marks[v] = round;
+            PushEdge(s, to, v);
+        }
+    }
+}
+
+// The model with edges collapsed, cheapest first by quadric error, until it is down to
+// 'targetTriangles' or no collapse is left that keeps it a manifold without folds. Boundaries,
+// texture seams and material edges are held in place. Faces keep their OBJ texcoords and
+// normals; positions are the OBJ's own, so 'out' shares its vertex arrays' layout.
+bool SimplifyObj(const ObjData *obj, int targetTriangles, ObjData *out)
+{
+    memset(out, 0, sizeof(*out));
+
+    Simplifier s;
+    InitSimplifier(&s, obj);
+
+    while ((s.liveFaces > targetTriangles) && (s.heapCount > 0))
+    {
+        Collapse collapse = PopCollapse(&s);
+        if (s.removed[collapse.from] || s.removed[collapse.to] || (s.stamps[collapse.from] != collapse.fromStamp) ||
+            (s.stamps[collapse.to] != collapse.toStamp)) continue;
+
+        if (CanCollapse(&s, collapse.from, collapse.to)) ApplyCollapse(&s, collapse.from, collapse.to);
+    }
+
+    out->positionCount = obj->positionCount;
+    out->texcoordCount = obj->texcoordCount;
+    out->normalCount = obj->normalCount;
+    out->materialCount = obj->materialCount;
+    out->positions = (float *)malloc((obj->positionCount > 0? obj->positionCount : 1) * 3 * sizeof(float));
+    out->texcoords = (float *)malloc((obj->texcoordCount > 0? obj->texcoordCount : 1) * 2 * sizeof(float));
+    out->normals = (float *)malloc((obj->normalCount > 0? obj->normalCount : 1) * 3 * sizeof(float));
+    out->materials = (ObjMaterial *)malloc((obj->materialCount > 0? obj->materialCount : 1) * sizeof(ObjMaterial));
+    memcpy(out->positions, obj->positions, obj->positionCount * 3 * sizeof(float));
+    memcpy(out->texcoords, obj->texcoords, obj->texcoordCount * 2 * sizeof(float));
+    memcpy(out->normals, obj->normals, obj->normalCount * 3 * sizeof(float));
+    memcpy(out->materials, obj->materials, obj->materialCount * sizeof(ObjMaterial));
+
+    out->triangles = (ObjTriangle *)malloc((s.liveFaces > 0? s.liveFaces : 1) * sizeof(ObjTriangle));
+    for (int f = 0; f < s.faceCount; f++)
+    {
+        const SimplifyFace *face = &s.faces[f];
+        if (face->dead) continue;
+
+        ObjTriangle *tri = &out->triangles[out->triangleCount++];
+        tri->material = face->material;
+        for (int k = 0; k < 3; k++)
+        {
+            tri->corners[k] = face->corners[k];
+            tri->corners[k].position = s.source[face->v[k]];
+        }
+    }
+
+    bool reached = (s.liveFaces <= targetTriangles);
+    UnloadSimplifier(&s);
+    return reached;
+}
+
+//----------------------------------------------------------------------------------
+// Error measurement
+//----------------------------------------------------------------------------------
+
+// Squared distance from p to triangle a, b, c (closest point by Voronoi region)
+static double PointTriangleDistanceSqr(const double *p, const double *a, const double *b, const double *c)
+{
+    double ab[3], ac[3], ap[3], closest[3];
+    Subtract(b, a, ab);
+    Subtract(c, a, ac);
+    Subtract(p, a, ap);
+
+    double d1 = Dot(ab, ap), d2 = Dot(ac, ap);
+    if ((d1 <= 0.0) && (d2 <= 0.0)) memcpy(closest, a, sizeof(closest));
+    else
+    {
+        double bp[3], cp[3];
+        Subtract(p, b, bp);
+        Subtract(p, c, cp);
+        double d3 = Dot(ab, bp), d4 = Dot(ac, bp), d5 = Dot(ab, cp), d6 = Dot(ac, cp);
+        double vc = d1 * d4 - d3 * d2, vb = d5 * d2 - d1 * d6, va = d3 * d6 - d5 * d4;
+
+        if ((d3 >= 0.0) && (d4 <= d3)) memcpy(closest, b, sizeof(closest));
+        else if ((d6 >= 0.0) && (d5 <= d6)) memcpy(closest, c, sizeof(closest));
+        else if ((vc <= 0.0) && (d1 >= 0.0) && (d3 <= 0.0))
+        {
+            double t = d1 / (d1 - d3);
+            for (int k = 0; k < 3; k++) closest[k] = a[k] + t * ab[k];
+        }
+        else if ((vb <= 0.0) && (d2 >= 0.0) && (d6 <= 0.0))
+        {
+            double t = d2 / (d2 - d6);
+            for (int k = 0; k < 3; k++) closest[k] = a[k] + t * ac[k];
+        }
+        else if ((va <= 0.0) && ((d4 - d3) >= 0.0) && ((d5 - d6) >= 0.0))
+        {
+            double t = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+            for (int k = 0; k < 3; k++) closest[k] = b[k] + t * (c[k] - b[k]);
+        }
+        else
+        {
+            double denominator = 1.0 / (va + vb + vc);
+            double v = vb * denominator, w = vc * denominator;
+            for (int k = 0; k < 3; k++) closest[k] = a[k] + ab[k] * v + ac[k] * w;
+        }
+    }
+
+    double d[3];
+    Subtract(p, closest, d);
+    return Dot(d, d);
+}
+
+static void GetObjPosition(const ObjData *obj, int index, double *out)
+{
+    for (int k = 0; k < 3; k++) out[k] = obj->positions[index * 3 + k];
+}
+
+// How far the full model strays from the simplified one: the largest distance from any of its
+// vertices or face centres to the nearest simplified face, in model units
+float GetSimplifyError(const ObjData *full, const ObjData *simplified)
+{
+    double worst = 0.0;
+
+    for (int i = 0; i < full->triangleCount; i++)
+    {
+        double corners[3][3], samples[4][3];
+        for (int k = 0; k < 3; k++) GetObjPosition(full, full->triangles[i].corners[k].position, corners[k]);
+        for (int k = 0; k < 3; k++)
+        {
+            memcpy(samples[k], corners[k], sizeof(samples[k]));
+            samples[3][k] = (corners[0][k] + corners[1][k] + corners[2][k]) / 3.0;
+        }
+
+        for (int j = 0; j < 4; j++)
+        {
+            double nearest = INFINITY;
+            for (int t = 0; (t < simplified->triangleCount) && (nearest > worst); t++)
+            {
+                double a[3], b[3], c[3];
+                GetObjPosition(simplified, simplified->triangles[t].corners[0].position, a);
+                GetObjPosition(simplified, simplified->triangles[t].corners[1].position, b);
+                GetObjPosition(simplified, simplified->triangles[t].corners[2].position, c);
+                double distance = PointTriangleDistanceSqr(samples[j], a, b, c);
+                if (distance < nearest) nearest = distance;
+            }
+            if (nearest > worst) worst = nearest;
+        }
+    }
+
+    return (float)sqrt(worst);
+}
@@ -0,0 +1,14 @@
+#ifndef SIMPLIFY_H
+#define SIMPLIFY_H
+
+// Offline level-of-detail generation shared by tools/meshconv and the benchmarks: quadric error
+// edge collapses over the OBJ's welded positions
+
+#include <stdbool.h>
+#include "objconv.h"
+
+// Function declarations
+bool SimplifyObj(const ObjData *obj, int targetTriangles, ObjData *out);
+float GetSimplifyError(const ObjData *full, const ObjData *simplified);
+
+#endif // SIMPLIFY_H
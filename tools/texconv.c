@@ -0,0 +1,192 @@
+// Converts an image into the binary .hst format loaded by LoadTextureBinary(): a 16-bit
+// PVR-native pixel format with the full mip chain generated offline.
+//
+// Usage: texconv [-f 565|1555|4444] input.png output.hst
+//
+// Without -f the format follows the alpha channel: opaque images get R5G6B5, images with
+// only fully clear/opaque pixels R5G5B5A1, anything else R4G4B4A4.
+
+#include <raylib.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../src/texture/texbin_format.h"
+
+static const char *FormatName(int format)
+{
+    switch (format)
+    {
+        case PIXELFORMAT_UNCOMPRESSED_GRAYSCALE: return "GRAY8";
+        case PIXELFORMAT_UNCOMPRESSED_GRAY_ALPHA: return "GRAY8A8";
+        case PIXELFORMAT_UNCOMPRESSED_R5G6B5: return "R5G6B5";
+        case PIXELFORMAT_UNCOMPRESSED_R8G8B8: return "R8G8B8";
+        case PIXELFORMAT_UNCOMPRESSED_R5G5B5A1: return "R5G5B5A1";
+        case PIXELFORMAT_UNCOMPRESSED_R4G4B4A4: return "R4G4B4A4";
+        case PIXELFORMAT_UNCOMPRESSED_R8G8B8A8: return "R8G8B8A8";
+        default: return "other";
+    }
+}
+
+static bool IsPowerOfTwo(int value)
+{
+    return (value > 0) && ((value & (value - 1)) == 0);
+}
+
+static int ChooseFormat(const unsigned char *rgba, int pixels)
+{
+    bool translucent = false, cutout = false;
+    for (int i = 0; i < pixels; i++)
+    {
+        unsigned char a = rgba[i * 4 + 3];
+        if (a == 0) cutout = true;
+        else if (a != 255) translucent = true;
+    }
+
+    if (translucent) return PIXELFORMAT_UNCOMPRESSED_R4G4B4A4;
+    if (cutout) return PIXELFORMAT_UNCOMPRESSED_R5G5B5A1;
+    return PIXELFORMAT_UNCOMPRESSED_R5G6B5;
+}
+
+// Same bit layouts raylib's ImageFormat() produces, which GLdc uploads as-is
+static unsigned short PackPixel(const unsigned char *p, int format)
+{
+    switch (format)
+    {
+        case PIXELFORMAT_UNCOMPRESSED_R5G6B5:
+            return ((p[0] >> 3) << 11) | ((p[1] >> 2) << 5) | (p[2] >> 3);
+        case PIXELFORMAT_UNCOMPRESSED_R5G5B5A1:
+            return ((p[0] >> 3) << 11) | ((p[1] >> 3) << 6) | ((p[2] >> 3) << 1) | (p[3] >= 128);
+        default:
+            return ((p[0] >> 4) << 12) | ((p[1] >> 4) << 8) | ((p[2] >> 4) << 4) | (p[3] >> 4);
+    }
+}
+
+// Next mip level by 2x2 box filter at 8 bits per channel, so every level is filtered from
+// full precision and only quantized once
+static void Downsample(const unsigned char *src, int width, int height, unsigned char *dst)
+{
+    int w = (width > 1)? width / 2 : 1;
+    int h = (height > 1)? height / 2 : 1;
+    int dx = (width > 1)? 1 : 0;
+    int dy = (height > 1)? 1 : 0;
+
+    for (int y = 0; y < h; y++)
+    {
+        for (int x = 0; x < w; x++)
+        {
+            const unsigned char *p00 = &src[((y * 2) * width + x * 2) * 4];
+            const unsigned char *p01 = &src[((y * 2) * width + x * 2 + dx) * 4];
+            const unsigned char *p10 = &src[((y * 2 + dy) * width + x * 2) * 4];
+            const unsigned char *p11 = &src[((y * 2 + dy) * width + x * 2 + dx) * 4];
+
+            for (int c = 0; c < 4; c++) dst[(y * w + x) * 4 + c] = (p00[c] + p01[c] + p10[c] + p11[c] + 2) / 4;
+        }
+    }
+}
+
+static int GetMipChainSize(int width, int height, int format, int *mipmaps)
+{
+    int bytes = 0, levels = 0;
+    for (;;)
+    {
+        bytes += GetPixelDataSize(width, height, format);
+        levels++;
+        if ((width == 1) && (height == 1)) break;
+        width = (width > 1)? width / 2 : 1;
+        height = (height > 1)? height / 2 : 1;
+    }
+    if (mipmaps != NULL) *mipmaps = levels;
+    return bytes;
+}
+
+int main(int argc, char **argv)
+{
+    int format = 0;
+    int arg = 1;
+
+    if ((argc == 5) && (strcmp(argv[1], "-f") == 0))
+    {
+        if (strcmp(argv[2], "565") == 0) format = PIXELFORMAT_UNCOMPRESSED_R5G6B5;
+        else if (strcmp(argv[2], "1555") == 0) format = PIXELFORMAT_UNCOMPRESSED_R5G5B5A1;
+        else if (strcmp(argv[2], "4444") == 0) format = PIXELFORMAT_UNCOMPRESSED_R4G4B4A4;
+        arg = 3;
+    }
+
+    if ((argc - arg != 2) || ((arg == 3) && (format == 0)))
+    {
+        fprintf(stderr, "usage: %s [-f 565|1555|4444] input.png output.hst\n", argv[0]);
+        return 1;
+    }
+
+    const char *input = argv[arg];
+    const char *output = argv[arg + 1];
+
+    Image image = LoadImage(input);
+    if (image.data == NULL)
+    {
+        fprintf(stderr, "texconv: can't load %s\n", input);
+        return 1;
+    }
+
+    if (!IsPowerOfTwo(image.width) || !IsPowerOfTwo(image.height) || (image.width > 1024) || (image.height > 1024))
+    {
+        fprintf(stderr, "texconv: %s is %dx%d, textures must be powers of two up to 1024\n", input, image.width, image.height);
+        UnloadImage(image);
+        return 1;
+    }
+
+    // What loading the source file at runtime costs: as decoded, and with a runtime mip chain
+    int sourceFormat = image.format;
+    int sourceBytes = GetPixelDataSize(image.width, image.height, sourceFormat);
+    int sourceMipBytes = GetMipChainSize(image.width, image.height, sourceFormat, NULL);
+
+    ImageFormat(&image, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+    if (format == 0) format = ChooseFormat((const unsigned char *)image.data, image.width * image.height);
+
+    TexBinHeader header = { 0 };
+    header.magic = TEXBIN_MAGIC;
+    header.version = TEXBIN_VERSION;
+    header.width = image.width;
+    header.height = image.height;
+    header.format = format;
+
+    int mipmaps = 0;
+    header.dataSize = GetMipChainSize(image.width, image.height, format, &mipmaps);
+    header.mipmaps = mipmaps;
+
+    unsigned short *pixels = (unsigned short *)malloc(header.dataSize);
+    unsigned char *level = (unsigned char *)malloc(image.width * image.height * 4);
+    unsigned char *next = (unsigned char *)malloc(image.width * image.height * 4);
+    memcpy(level, image.data, image.width * image.height * 4);
+
+    unsigned short *out = pixels;
+    for (int i = 0, w = image.width, h = image.height; i < mipmaps; i++)
+    {
+        for (int p = 0; p < w * h; p++) *out++ = PackPixel(&level[p * 4], format);
+
+        Downsample(level, w, h, next);
+        unsigned char *swap = level; level = next; next = swap;
+        w = (w > 1)? w / 2 : 1;
+        h = (h > 1)? h / 2 : 1;
+    }
+
+    bool ok = true;
+    FILE *file = fopen(output, "wb");
+    if ((file == NULL) || (fwrite(&header, sizeof(header), 1, file) != 1) || (fwrite(pixels, 1, header.dataSize, file) != header.dataSize))
+    {
+        fprintf(stderr, "texconv: can't write %s\n", output);
+        ok = false;
+    }
+    if (file != NULL) fclose(file);
+
+    printf("texconv: %s -> %s: %dx%d %s %d bytes (%d with runtime mipmaps) -> %s, %d mipmaps, %u bytes\n",
+           input, output, image.width, image.height, FormatName(sourceFormat), sourceBytes, sourceMipBytes,
+           FormatName(format), mipmaps, header.dataSize);
+
+    free(next);
+    free(level);
+    free(pixels);
+    UnloadImage(image);
+
+    return ok? 0 : 1;
+}
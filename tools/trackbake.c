@@ -0,0 +1,71 @@
+// Bakes a track into the binary .hsk format loaded by LoadTrackBinary(): generates it as the
+// game would, builds it with BuildTrack() and writes the result, so the console only reads it.
+// 'stadium' is the spline circuit the game races on, 'oval' the procedural test oval with
+// 'segments' rows (128 by default).
+//
+// Usage: trackbake stadium|oval output.hsk [segments]
+
+#include <raylib.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "trackconv.h"
+#include "../src/track/track.h"
+#include "../src/track/circuit.h"
+
+#define OVAL_SEGMENTS 128
+
+int main(int argc, char **argv)
+{
+    if ((argc < 3) || (argc > 4))
+    {
+        fprintf(stderr, "usage: %s stadium|oval output.hsk [segments]\n", argv[0]);
+        return 1;
+    }
+    SetTraceLogLevel(LOG_WARNING);
+
+    Track track;
+    bool built = false;
+    if (strcmp(argv[1], "stadium") == 0) built = GenSplineTrack(&track, stadiumCircuit, STADIUM_CIRCUIT_POINTS, stadiumTessellation);
+    else if (strcmp(argv[1], "oval") == 0)
+    {
+        int segments = (argc > 3)? atoi(argv[3]) : OVAL_SEGMENTS;
+        if (segments < 3)
+        {
+            fprintf(stderr, "trackbake: %s is too few segments\n", argv[3]);
+            return 1;
+        }
+
+        // The oval the track benchmarks generate
+        track = (Track){ 0 };
+        TrackRibbon ribbon = GenTrackRibbon(500.0f, 200.0f, segments, 50.0f, 10.0f);
+        built = BuildTrack(&track, &ribbon, TRACK_DEFAULT_PRIMITIVE);
+        UnloadTrackRibbon(&ribbon);
+    }
+    else
+    {
+        fprintf(stderr, "trackbake: unknown track %s\n", argv[1]);
+        return 1;
+    }
+
+    unsigned char *data = NULL;
+    int size = 0;
+    bool ok = built && BuildTrackBin(&track, &data, &size);
+    if (!ok) fprintf(stderr, "trackbake: can't build %s\n", argv[1]);
+
+    FILE *file = ok? fopen(argv[2], "wb") : NULL;
+    if (ok && ((file == NULL) || (fwrite(data, 1, size, file) != (size_t)size)))
+    {
+        fprintf(stderr, "trackbake: can't write %s\n", argv[2]);
+        ok = false;
+    }
+    if (file != NULL) fclose(file);
+
+    if (ok) printf("trackbake: %s -> %s: %d segments, %d chunks, %d vertices, %d bytes\n", argv[1], argv[2], track.waypointCount, track.chunkCount,
+                   track.vertexCount, size);
+
+    free(data);
+    if (built) UnloadArena(&track.arena);
+
+    return ok? 0 : 1;
+}
@@ -0,0 +1,73 @@
+#include "trackconv.h"
+#include <stdlib.h>
+#include <string.h>
+#include "../src/track/trackbin_format.h"
+
+// Where 'array' sits in the arena image; false if it isn't in it
+static bool GetArenaArray(const Track *track, const void *array, uint32_t count, size_t size, TrackBinArray *out)
+{
+    const unsigned char *base = track->arena.base;
+    const unsigned char *at = (const unsigned char *)array;
+    if ((at < base) || ((size_t)(at - base) + count * size > track->arena.used)) return false;
+
+    out->offset = (uint32_t)(at - base);
+    out->count = count;
+    return true;
+}
+
+// Serialize a track built by BuildTrack() as .hsk: the header, then its arena image as is.
+// Returns a malloc'd buffer the caller frees.
+bool BuildTrackBin(const Track *track, unsigned char **outData, int *outSize)
+{
+    const TrackSurface *surface = &track->surface;
+    if ((track->arena.base == NULL) || (surface->cellStart == NULL)) return false;
+
+    TrackBinHeader header = { 0 };
+    header.magic = TRACKBIN_MAGIC;
+    header.version = TRACKBIN_VERSION;
+    header.dataSize = (uint32_t)track->arena.used;
+    header.primitive = (uint32_t)track->primitive;
+
+    int cellCount = surface->gridWidth * surface->gridHeight;
+    bool ok = GetArenaArray(track, track->chunks, track->chunkCount, sizeof(TrackChunk), &header.chunks) &&
+              GetArenaArray(track, track->visibleChunks, track->chunkCount, sizeof(int), &header.visibleChunks) &&
+              GetArenaArray(track, track->vertices, track->vertexCount, sizeof(TrackVertex), &header.vertices) &&
+              GetArenaArray(track, track->indices, track->indexCount, sizeof(unsigned short), &header.indices) &&
+              GetArenaArray(track, track->waypoints, track->waypointCount, sizeof(Vector3), &header.waypoints) &&
+              GetArenaArray(track, track->frames, track->waypointCount, sizeof(TrackFrame), &header.frames) &&
+              GetArenaArray(track, surface->segments, surface->segmentCount, sizeof(TrackSurfaceSegment), &header.segments) &&
+              GetArenaArray(track, surface->cellStart, cellCount + 1, sizeof(int), &header.cellStart) &&
+              GetArenaArray(track, surface->cellSegments, surface->cellStart[cellCount], sizeof(int), &header.cellSegments);
+    if (!ok) return false;
+
+    header.gridOrigin[0] = surface->gridOrigin.x;
+    header.gridOrigin[1] = surface->gridOrigin.y;
+    header.cellSize = surface->cellSize;
+    header.gridWidth = (uint32_t)surface->gridWidth;
+    header.gridHeight = (uint32_t)surface->gridHeight;
+
+    // Only the arrays are copied, so the arena's padding is written as zeros and a bake is
+    // reproducible. The visible list and view distances are per-frame scratch, left cleared.
+    int size = TRACKBIN_HEADER_SIZE + (int)header.dataSize;
+    unsigned char *data = (unsigned char *)calloc(size, 1);
+    if (data == NULL) return false;
+
+    memcpy(data, &header, sizeof(header));
+    unsigned char *image = data + TRACKBIN_HEADER_SIZE;
+    const unsigned char *base = track->arena.base;
+    const TrackBinArray *arrays[] = { &header.chunks, &header.vertices, &header.indices, &header.waypoints, &header.frames,
+                                      &header.segments, &header.cellStart, &header.cellSegments };
+    const size_t sizes[] = { sizeof(TrackChunk), sizeof(TrackVertex), sizeof(unsigned short), sizeof(Vector3), sizeof(TrackFrame),
+                             sizeof(TrackSurfaceSegment), sizeof(int), sizeof(int) };
+    for (int i = 0; i < (int)(sizeof(sizes) / sizeof(sizes[0])); i++)
+    {
+        memcpy(image + arrays[i]->offset, base + arrays[i]->offset, arrays[i]->count * sizes[i]);
+    }
+
+    TrackChunk *chunks = (TrackChunk *)(image + header.chunks.offset);
+    for (uint32_t c = 0; c < header.chunks.count; c++) chunks[c].viewDistance = 0.0f;
+
+    *outData = data;
+    *outSize = size;
+    return true;
+}
@@ -0,0 +1,12 @@
+#ifndef TRACKCONV_H
+#define TRACKCONV_H
+
+// Host-side .hsk writer shared by tools/trackbake and the benchmarks
+
+#include <stdbool.h>
+#include "../src/track/track.h"
+
+// Function declarations
+bool BuildTrackBin(const Track *track, unsigned char **outData, int *outSize);
+
+#endif // TRACKCONV_H